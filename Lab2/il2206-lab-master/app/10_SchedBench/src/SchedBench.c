@@ -0,0 +1,167 @@
+// File: SchedBench.c
+//
+// Measures the cost of resolving the highest ready priority. Every
+// OSSchedUnlock() that drops the lock count to zero runs OS_SchedNew(),
+// so timing OSSchedLock()/OSSchedUnlock() pairs gives the scheduler cost
+// for the current ready set. Build once with OS_SCHED_FFS_EN set to 1 and
+// once with it set to 0 (os_cfg.h) to compare count trailing zeros with
+// the OSUnMapTbl lookup.
+
+#include <stdio.h>
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+#include "sys/alt_irq.h"
+#include "system.h"
+
+#define BENCH_ITERATIONS   1000   // Lock/unlock pairs per measurement
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+#define   FILLER_STACKSIZE      256
+#define   MAX_FILLER_TASKS       64
+OS_STK    bench_stk[TASK_STACKSIZE];
+OS_STK    filler_stk[MAX_FILLER_TASKS][FILLER_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define BENCH_PRIORITY        1   // highest priority, changed during the run
+#define FILLER_PRIORITY_MAX 250   // fillers are spread between the bench task and this
+
+// Position of the highest ready task, which selects the group/row word
+// the lookup ends up in, and number of other ready tasks below it.
+static const INT8U bench_prios[]  = { 4, 64, 128 };
+static const int   ready_counts[] = { 0, 8, 32, 64 };
+
+/* Never runs while the benchmark is active, only populates the ready list */
+void fillerTask(void* pdata)
+{
+  while (1)
+    {
+      OSTimeDly(OS_TICKS_PER_SEC);
+    }
+}
+
+/* Makes 'count' filler tasks ready below priority 'prio'. If a task cannot
+   be created, deletes the ones already created and returns the error. */
+INT8U createFillers(INT8U prio, int count)
+{
+  INT8U err;
+  int step;
+  int i;
+
+  if (count == 0)
+    return OS_NO_ERR;
+  step = (FILLER_PRIORITY_MAX - prio - 1) / count;
+  for (i = 0; i < count; i++)
+    {
+      err = OSTaskCreateExt
+        ( fillerTask,                         // Pointer to task code
+          NULL,                               // Pointer to argument passed to task
+          &filler_stk[i][FILLER_STACKSIZE-1], // Pointer to top of task stack
+          prio + 1 + i * step,                // Desired Task priority
+          prio + 1 + i * step,                // Task ID
+          &filler_stk[i][0],                  // Pointer to bottom of task stack
+          FILLER_STACKSIZE,                   // Stacksize
+          NULL,                               // Pointer to user supplied memory (not needed)
+          OS_TASK_OPT_STK_CHK |               // Stack Checking enabled
+          OS_TASK_OPT_STK_CLR                 // Stack Cleared
+          );
+      if (err != OS_NO_ERR)
+        {
+          printf("Cannot create filler task %d at priority %d (error %d)\n",
+                 i, prio + 1 + i * step, err);
+          while (i-- > 0)
+            OSTaskDel(prio + 1 + i * step);
+          return err;
+        }
+    }
+  return OS_NO_ERR;
+}
+
+void deleteFillers(INT8U prio, int count)
+{
+  int step;
+  int i;
+
+  if (count == 0)
+    return;
+  step = (FILLER_PRIORITY_MAX - prio - 1) / count;
+  for (i = 0; i < count; i++)
+    {
+      OSTaskDel(prio + 1 + i * step);
+    }
+}
+
+/* Times BENCH_ITERATIONS scheduler lock/unlock pairs with interrupts disabled */
+alt_u64 measureSched(void)
+{
+  alt_irq_context context;
+  int i;
+
+  context = alt_irq_disable_all();
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+      OSSchedLock();
+      OSSchedUnlock();
+    }
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  alt_irq_enable_all(context);
+
+  return perf_get_total_time((void *)PERFORMANCE_COUNTER_BASE);
+}
+
+void benchTask(void* pdata)
+{
+  alt_u64 cycles;
+  INT8U err;
+  int p;
+  int n;
+
+  printf("SchedBench: OS_SCHED_FFS_EN=%d, OS_LOWEST_PRIO=%d, %d pairs per sample\n",
+         OS_SCHED_FFS_EN, OS_LOWEST_PRIO, BENCH_ITERATIONS);
+  printf("highest_ready_prio,other_ready_tasks,cycles_per_sched\n");
+  for (p = 0; p < sizeof(bench_prios) / sizeof(bench_prios[0]); p++)
+    {
+      err = OSTaskChangePrio(OS_PRIO_SELF, bench_prios[p]);
+      if (err != OS_NO_ERR)
+        {
+          printf("Cannot move to priority %d (error %d)\n", bench_prios[p], err);
+          continue;
+        }
+      for (n = 0; n < sizeof(ready_counts) / sizeof(ready_counts[0]); n++)
+        {
+          if (createFillers(bench_prios[p], ready_counts[n]) != OS_NO_ERR)
+            break;                   // Larger counts cannot be created either
+
+          cycles = measureSched() / BENCH_ITERATIONS;
+          printf("%d,%d,%lu\n", bench_prios[p], ready_counts[n],
+                 (unsigned long)cycles);
+
+          deleteFillers(bench_prios[p], ready_counts[n]);
+        }
+    }
+  OSTaskDel(OS_PRIO_SELF);
+}
+
+int main(void)
+{
+  printf("Lab - Scheduler benchmark\n");
+
+  OSTaskCreateExt
+    ( benchTask,                    // Pointer to task code
+      NULL,                         // Pointer to argument passed to task
+      &bench_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      BENCH_PRIORITY,               // Desired Task priority
+      BENCH_PRIORITY,               // Task ID
+      &bench_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,               // Stacksize
+      NULL,                         // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |         // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR           // Stack Cleared
+      );
+
+  OSStart();
+  return 0;
+}
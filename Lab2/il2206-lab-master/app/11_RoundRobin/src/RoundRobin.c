@@ -0,0 +1,124 @@
+// File: RoundRobin.c
+//
+// Shows round-robin time slicing between tasks that share a priority.
+// Several background tasks are created at the same priority and spin,
+// counting loop iterations. A higher priority task samples the counters
+// once per second and prints the share of the CPU each one received.
+// The shares are close to equal: every OS_SCHED_RR_QUANTUM ticks the
+// running task hands over to its peer.
+//
+// Requires OS_SCHED_RR_EN set to 1 (os_cfg.h); run.sh sets it in the BSP
+// of this application.
+
+#include <stdio.h>
+#include "includes.h"
+#include "system.h"
+
+#if OS_SCHED_RR_EN == 0
+#error "Set OS_SCHED_RR_EN to 1 in os_cfg.h"
+#endif
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+#define   WORKER_STACKSIZE      512
+#define   NUM_WORKERS             4
+OS_STK    report_stk[TASK_STACKSIZE];
+OS_STK    worker_stk[NUM_WORKERS][WORKER_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define REPORT_PRIORITY       4   // highest priority
+#define WORKER_PRIORITY      10   // shared by all workers
+
+#define REPORT_PERIOD      1000   // ms between two samples
+
+static volatile INT32U worker_count[NUM_WORKERS];
+
+/* Background work, never blocks */
+void workerTask(void* pdata)
+{
+  int id = (int)pdata;
+
+  while (1)
+    {
+      worker_count[id]++;
+    }
+}
+
+void reportTask(void* pdata)
+{
+  INT32U last[NUM_WORKERS];
+  INT32U delta[NUM_WORKERS];
+  INT32U total;
+  int i;
+
+  printf("RoundRobin: OS_SCHED_RR_EN=%d, OS_SCHED_RR_QUANTUM=%d, %d workers at priority %d\n",
+         OS_SCHED_RR_EN, OS_SCHED_RR_QUANTUM, NUM_WORKERS, WORKER_PRIORITY);
+  for (i = 0; i < NUM_WORKERS; i++)
+    {
+      last[i] = 0;
+    }
+
+  while (1)
+    {
+      OSTimeDly(REPORT_PERIOD * OS_TICKS_PER_SEC / 1000);
+
+      total = 0;
+      for (i = 0; i < NUM_WORKERS; i++)
+        {
+          delta[i] = worker_count[i] - last[i];
+          last[i] += delta[i];
+          total += delta[i];
+        }
+      if (total == 0)
+        continue;
+      for (i = 0; i < NUM_WORKERS; i++)
+        {
+          printf("worker %d: %3lu%%  ", i,
+                 (unsigned long)(delta[i] / (total / 100 + 1)));
+        }
+      printf("\n");
+    }
+}
+
+int main(void)
+{
+  INT8U err;
+  int i;
+
+  printf("Lab - Round-robin scheduling\n");
+
+  OSTaskCreateExt
+    ( reportTask,                    // Pointer to task code
+      NULL,                          // Pointer to argument passed to task
+      &report_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      REPORT_PRIORITY,               // Desired Task priority
+      REPORT_PRIORITY,               // Task ID
+      &report_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,                // Stacksize
+      NULL,                          // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |          // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR            // Stack Cleared
+      );
+
+  for (i = 0; i < NUM_WORKERS; i++)
+    {
+      err = OSTaskCreateExt
+        ( workerTask,                            // Pointer to task code
+          (void *)i,                             // Worker index
+          &worker_stk[i][WORKER_STACKSIZE-1],    // Pointer to top of task stack
+          WORKER_PRIORITY,                       // Same priority for every worker
+          WORKER_PRIORITY + i,                   // Task ID
+          &worker_stk[i][0],                     // Pointer to bottom of task stack
+          WORKER_STACKSIZE,                      // Stacksize
+          NULL,                                  // Pointer to user supplied memory (not needed)
+          OS_TASK_OPT_STK_CHK |                  // Stack Checking enabled
+          OS_TASK_OPT_STK_CLR                    // Stack Cleared
+          );
+      if (err != OS_NO_ERR)
+        printf("Could not create worker %d (err %d)\n", i, err);
+    }
+
+  OSStart();
+  return 0;
+}
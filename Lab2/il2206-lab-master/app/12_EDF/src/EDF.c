@@ -0,0 +1,154 @@
+// File: EDF.c
+//
+// Runs a periodic task set that is schedulable under earliest deadline
+// first but not under fixed priorities. The long-period task is even given
+// the higher priority on purpose: with OS_SCHED_EDF_EN the kernel ignores
+// the priority order between periodic tasks of the EDF band
+// (OS_SCHED_EDF_PRIO_HI..OS_SCHED_EDF_PRIO_LO) and dispatches them by
+// deadline. A monitor task prints the jobs completed and the deadline
+// misses reported by OSTaskQuery() once per second.
+//
+// Requires OS_SCHED_EDF_EN set to 1 and OS_SCHED_RR_EN set to 0 (os_cfg.h).
+
+#include <stdio.h>
+#include "includes.h"
+#include "system.h"
+
+#if OS_SCHED_EDF_EN == 0
+#error "Set OS_SCHED_EDF_EN to 1 and OS_SCHED_RR_EN to 0 in os_cfg.h"
+#endif
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+#define   NUM_PERIODIC            2
+OS_STK    monitor_stk[TASK_STACKSIZE];
+OS_STK    periodic_stk[NUM_PERIODIC][TASK_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define MONITOR_PRIORITY      4   // highest priority, not periodic
+#define PERIODIC_PRIORITY     5   // periodic tasks use 5 .. 5 + NUM_PERIODIC - 1
+
+#if (PERIODIC_PRIORITY < OS_SCHED_EDF_PRIO_HI) || \
+    (PERIODIC_PRIORITY + NUM_PERIODIC - 1 > OS_SCHED_EDF_PRIO_LO)
+#error "The periodic tasks must be in the EDF band (OS_SCHED_EDF_PRIO_HI/LO in os_cfg.h)"
+#endif
+
+#define CALIBRATION_TICKS   100   // ticks used to measure the busy loop speed
+#define CALIBRATION_MS      ((INT32U)(CALIBRATION_TICKS * 1000 / OS_TICKS_PER_SEC))
+
+// Execution time and period in ms. Utilization is 20/50 + 35/70 = 90%;
+// under rate monotonic priorities the 70 ms task would miss its deadline.
+typedef struct {
+  INT16U wcet;
+  INT16U period;
+} task_param;
+
+static const task_param task_set[NUM_PERIODIC] = {
+  { 35, 70 },   // priority 5
+  { 20, 50 },   // priority 6
+};
+
+static INT32U loops_per_ms;
+static volatile INT32U jobs[NUM_PERIODIC];
+
+/* Busy waits for about 'ms' milliseconds of CPU time */
+void busyWork(INT16U ms)
+{
+  volatile INT32U i;
+  INT32U n = loops_per_ms * ms;
+
+  for (i = 0; i < n; i++)
+    ;
+}
+
+void periodicTask(void* pdata)
+{
+  int id = (int)pdata;
+
+  OSTaskPeriodSet(OS_PRIO_SELF,
+                  (INT16U)(task_set[id].period * OS_TICKS_PER_SEC / 1000));
+  while (1)
+    {
+      busyWork(task_set[id].wcet);
+      jobs[id]++;
+      OSTimeDlyPeriod();
+    }
+}
+
+/* Counts busy loop iterations per ms while nothing else runs */
+void calibrate(void)
+{
+  volatile INT32U i;
+  INT64U start;
+  INT32U n = 0;
+
+  OSTimeDly(1);                  // Start on a tick boundary
+  start = OSTimeGet64();
+  while (OSTimeGet64() - start < CALIBRATION_TICKS)
+    {
+      for (i = 0; i < 1000; i++)
+        ;
+      n++;
+    }
+  loops_per_ms = n * 1000 / CALIBRATION_MS;
+}
+
+void monitorTask(void* pdata)
+{
+  OS_TCB data;
+  int i;
+
+  calibrate();
+  printf("EDF: %lu busy loops per ms\n", (unsigned long)loops_per_ms);
+
+  for (i = 0; i < NUM_PERIODIC; i++)
+    {
+      OSTaskCreateExt
+        ( periodicTask,                            // Pointer to task code
+          (void *)i,                               // Index into task_set
+          &periodic_stk[i][TASK_STACKSIZE-1],      // Pointer to top of task stack
+          PERIODIC_PRIORITY + i,                   // Desired Task priority
+          PERIODIC_PRIORITY + i,                   // Task ID
+          &periodic_stk[i][0],                     // Pointer to bottom of task stack
+          TASK_STACKSIZE,                          // Stacksize
+          NULL,                                    // Pointer to user supplied memory (not needed)
+          OS_TASK_OPT_STK_CHK |                    // Stack Checking enabled
+          OS_TASK_OPT_STK_CLR                      // Stack Cleared
+          );
+    }
+
+  while (1)
+    {
+      OSTimeDlyHMSM(0, 0, 1, 0);
+      for (i = 0; i < NUM_PERIODIC; i++)
+        {
+          OSTaskQuery(PERIODIC_PRIORITY + i, &data);
+          printf("task %d (C=%d, T=%d): %lu jobs, %lu misses  ", i,
+                 task_set[i].wcet, task_set[i].period,
+                 (unsigned long)jobs[i], (unsigned long)data.OSTCBDlMiss);
+        }
+      printf("\n");
+    }
+}
+
+int main(void)
+{
+  printf("Lab - Earliest deadline first scheduling\n");
+
+  OSTaskCreateExt
+    ( monitorTask,                    // Pointer to task code
+      NULL,                           // Pointer to argument passed to task
+      &monitor_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      MONITOR_PRIORITY,               // Desired Task priority
+      MONITOR_PRIORITY,               // Task ID
+      &monitor_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,                 // Stacksize
+      NULL,                           // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |           // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR             // Stack Cleared
+      );
+
+  OSStart();
+  return 0;
+}
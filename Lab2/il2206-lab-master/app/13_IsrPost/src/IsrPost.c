@@ -0,0 +1,175 @@
+// File: IsrPost.c
+//
+// Measures how long an ISR spends in OSFlagPost() as a function of the
+// number of tasks waiting on the event flag group. The post is made with
+// interrupts disabled and OSIntNesting raised, as the kernel sees it from
+// a real interrupt handler. Build once with OS_ISR_POST_DEFERRED_EN set to
+// 1 and once with it set to 0 (os_cfg.h). Without deferral the ISR walks
+// the whole wait list; with it the ISR only queues the post and the post
+// task readies the waiters with the scheduler locked.
+//
+// What matters for the interrupt latency is the longest time interrupts
+// stay disabled anywhere, not only in the ISR: the post task could keep
+// them disabled while it walks the wait list instead. On the workstation,
+// build with HOST_CFLAGS=-DALT_HOST_IRQ_OFF_STATS to add this time, over
+// each sample and the posts the post task performs, as a last column:
+//
+//   HOST_CFLAGS=-DALT_HOST_IRQ_OFF_STATS ./run.sh ../app/13_IsrPost path/to/bsp
+
+#include <stdio.h>
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+#include "sys/alt_irq.h"
+#include "system.h"
+
+#define BENCH_ITERATIONS    100   // Posts per measurement, one per tick
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+#define   WAITER_STACKSIZE      256
+#define   MAX_WAITERS            64
+OS_STK    bench_stk[TASK_STACKSIZE];
+OS_STK    waiter_stk[MAX_WAITERS][WAITER_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define BENCH_PRIORITY        4   // highest application priority
+#define WAITER_PRIORITY_BASE  5   // waiters use 5 .. 5 + MAX_WAITERS - 1
+
+static const int waiter_counts[] = { 1, 8, 32, 64 };
+
+static OS_FLAG_GRP *event;
+
+/* Waits for bit 0 of the event flag group, forever */
+void waiterTask(void* pdata)
+{
+  INT8U err;
+
+  while (1)
+    {
+      OSFlagPend(event, 0x01, OS_FLAG_WAIT_SET_ANY + OS_FLAG_CONSUME, 0, &err);
+    }
+}
+
+/* Creates more waiters until there are 'count' of them */
+void createWaiters(int created, int count)
+{
+  int i;
+
+  for (i = created; i < count; i++)
+    {
+      OSTaskCreateExt
+        ( waiterTask,                             // Pointer to task code
+          NULL,                                   // Pointer to argument passed to task
+          &waiter_stk[i][WAITER_STACKSIZE-1],     // Pointer to top of task stack
+          WAITER_PRIORITY_BASE + i,               // Desired Task priority
+          WAITER_PRIORITY_BASE + i,               // Task ID
+          &waiter_stk[i][0],                      // Pointer to bottom of task stack
+          WAITER_STACKSIZE,                       // Stacksize
+          NULL,                                   // Pointer to user supplied memory (not needed)
+          OS_TASK_OPT_STK_CHK |                   // Stack Checking enabled
+          OS_TASK_OPT_STK_CLR                     // Stack Cleared
+          );
+    }
+}
+
+/* Times OSFlagPost() called from (simulated) interrupt context */
+void measurePost(alt_u64 *avg, alt_u64 *max, alt_u64 *off_max)
+{
+  alt_irq_context context;
+  alt_u64 cycles;
+  alt_u64 total = 0;
+  INT8U err;
+  int i;
+
+  *max = 0;
+#ifdef ALT_HOST_IRQ_OFF_STATS
+  alt_host_irq_off_reset();
+#endif
+  for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+      context = alt_irq_disable_all();
+      OSIntNesting++;                // The kernel now treats this as an ISR
+      PERF_RESET(PERFORMANCE_COUNTER_BASE);
+      PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+      PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+      OSFlagPost(event, 0x01, OS_FLAG_SET, &err);
+      PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+      PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+      OSIntNesting--;
+      alt_irq_enable_all(context);
+
+      cycles = perf_get_section_time((void *)PERFORMANCE_COUNTER_BASE, 1);
+      total += cycles;
+      if (cycles > *max)
+        *max = cycles;
+      OSTimeDly(1);                  // Let the waiters run and pend again
+    }
+  *avg = total / BENCH_ITERATIONS;
+#ifdef ALT_HOST_IRQ_OFF_STATS
+  *off_max = alt_host_irq_off_max();
+#else
+  *off_max = 0;
+#endif
+}
+
+void benchTask(void* pdata)
+{
+  alt_u64 avg;
+  alt_u64 max;
+  alt_u64 off_max;
+  INT8U err;
+  int created = 0;
+  int n;
+
+  event = OSFlagCreate(0, &err);
+
+  printf("IsrPost: OS_ISR_POST_DEFERRED_EN=%d, %d posts per sample\n",
+         OS_ISR_POST_DEFERRED_EN, BENCH_ITERATIONS);
+#ifdef ALT_HOST_IRQ_OFF_STATS
+  printf("waiters,avg_isr_cycles,max_isr_cycles,max_isr_us,max_irq_off_cycles\n");
+#else
+  printf("waiters,avg_isr_cycles,max_isr_cycles,max_isr_us\n");
+#endif
+  for (n = 0; n < sizeof(waiter_counts) / sizeof(waiter_counts[0]); n++)
+    {
+      createWaiters(created, waiter_counts[n]);
+      created = waiter_counts[n];
+      OSTimeDly(2);                  // Let all waiters run and pend
+
+      measurePost(&avg, &max, &off_max);
+      printf("%d,%lu,%lu,%lu", created, (unsigned long)avg,
+             (unsigned long)max,
+             (unsigned long)(max / (ALT_CPU_FREQ / 1000000)));
+#ifdef ALT_HOST_IRQ_OFF_STATS
+      printf(",%lu", (unsigned long)off_max);
+#endif
+      printf("\n");
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0
+  printf("post queue: %d entries used at most, %lu posts lost\n",
+         OSIntQEntriesMax, (unsigned long)OSIntQOvfCtr);
+#endif
+  OSTaskDel(OS_PRIO_SELF);
+}
+
+int main(void)
+{
+  printf("Lab - ISR post benchmark\n");
+
+  OSTaskCreateExt
+    ( benchTask,                    // Pointer to task code
+      NULL,                         // Pointer to argument passed to task
+      &bench_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      BENCH_PRIORITY,               // Desired Task priority
+      BENCH_PRIORITY,               // Task ID
+      &bench_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,               // Stacksize
+      NULL,                         // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |         // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR           // Stack Cleared
+      );
+
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,365 @@
+// File: IpcBench.c
+//
+// Measures the latency from signalling a kernel object to the first
+// instruction of the task that was waiting for it, for every kind of
+// kernel object, over BENCH_SAMPLES iterations each:
+//
+//   sem      OSSemPost()    -> OSSemPend()
+//   mbox     OSMboxPost()   -> OSMboxPend()
+//   queue    OSQPost()      -> OSQPend()
+//   flag     OSFlagPost()   -> OSFlagPend()
+//   mutex    OSMutexPost()  -> OSMutexPend(), including priority inheritance
+//   resume   OSTaskResume() -> OSTaskSuspend()
+//   ring     OSRingPut()    -> OSRingPend(), one entry into an empty ring
+//   queue4   4 x OSQPost()  -> 4 x OSQPend(), the batch of qmulti, one at a time
+//   qmulti   OSQPostMulti() -> OSQPendMulti(), a batch of 4 messages
+//   multi    OSSemPost()    -> OSEventPendMulti() on MULTI_EVENTS semaphores
+//   poll     OSSemPost()    -> OSPollPend() on a poll set of the same semaphores
+//   isr      system clock interrupt -> OSSemPend(), posted by an alarm
+//
+// A low priority sender starts the performance counter and posts, the high
+// priority receiver stops it as soon as it runs, so every sample includes
+// the post, the scheduler and the context switch. The isr samples are read
+// from the snapshot of the system clock timer and also include the interrupt
+// entry and everything the tick interrupt does (alarms, OSTimeTick()).
+// The null row is the cost of starting and stopping the counter, which is
+// included in all other rows except isr.
+//
+// All values are in CPU cycles. Output is one CSV row per test:
+//
+//   test,n,min,median,p99,max,mean
+//
+// followed by one histogram row per test, with HIST_BUCKETS buckets of
+// 'width' cycles starting at 'base':
+//
+//   hist,test,base,width,count0,count1,...
+//
+// Requires OS_POLL_EN set to 1 (os_cfg.h); run.sh sets it in the BSP
+// of this application.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+#include "altera_avalon_timer_regs.h"
+#include "sys/alt_alarm.h"
+#include "system.h"
+
+#if OS_POLL_EN == 0
+#error "Set OS_POLL_EN to 1 in os_cfg.h"
+#endif
+
+#define BENCH_SAMPLES      2000   // Samples per test
+#define HIST_BUCKETS         16   // Buckets per histogram
+#define MULTI_EVENTS          8   // Semaphores waited on by the multi and poll tests
+
+#define SYSCLK_BASE  TIMER_0_BASE // hal.sys_clk_timer (run.sh)
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+OS_STK    sender_stk[TASK_STACKSIZE];
+OS_STK    receiver_stk[TASK_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define MUTEX_PIP            5   // priority inheritance priority of the mutex
+#define RECEIVER_PRIORITY    6
+#define SENDER_PRIORITY      7
+
+static OS_EVENT    *start_sem;   // Starts a test in the receiver
+static OS_EVENT    *done_sem;    // Receiver has taken all samples
+static OS_EVENT    *go_sem;      // Lets the receiver block on the mutex
+static OS_EVENT    *sem;
+static OS_EVENT    *mbox;
+static OS_EVENT    *queue;
+static OS_EVENT    *mutex;
+static OS_FLAG_GRP *flags;
+static void        *queue_storage[4];
+static OS_RING      ring;
+static OS_EVENT    *ring_sem;
+static INT32U       ring_storage[4];
+static OS_EVENT    *multi_sems[MULTI_EVENTS + 1]; // NULL terminated for OSEventPendMulti()
+static OS_EVENT    *poll;
+static alt_alarm    isr_alarm;
+
+static alt_u32 samples[BENCH_SAMPLES];
+
+typedef struct {
+  const char *name;
+  void      (*setup)(void);     // Sender, before each sample, not timed
+  void      (*post)(void);      // Sender, timed; NULL: posted by the isr alarm
+  void      (*pend)(void);      // Receiver, returns when woken up
+  alt_u32   (*stamp)(void);     // Receiver, returns the sample
+  void      (*release)(void);   // Receiver, after the sample, not timed
+} ipc_test;
+
+/* Stops the performance counter started by the sender */
+alt_u32 perfStamp(void)
+{
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  return (alt_u32)perf_get_total_time((void *)PERFORMANCE_COUNTER_BASE);
+}
+
+/* Cycles since the last system clock interrupt was raised */
+alt_u32 sysclkStamp(void)
+{
+  alt_u32 period;
+  alt_u32 snap;
+
+  IOWR_ALTERA_AVALON_TIMER_SNAPL(SYSCLK_BASE, 0);
+  snap   = IORD_ALTERA_AVALON_TIMER_SNAPL(SYSCLK_BASE) |
+           (IORD_ALTERA_AVALON_TIMER_SNAPH(SYSCLK_BASE) << 16);
+  period = IORD_ALTERA_AVALON_TIMER_PERIODL(SYSCLK_BASE) |
+           (IORD_ALTERA_AVALON_TIMER_PERIODH(SYSCLK_BASE) << 16);
+  return period - snap;
+}
+
+void semPost(void)    { OSSemPost(sem); }
+void mboxPost(void)   { OSMboxPost(mbox, (void *)1); }
+void queuePost(void)  { OSQPost(queue, (void *)1); }
+void flagPost(void)   { INT8U err; OSFlagPost(flags, 0x01, OS_FLAG_SET, &err); }
+void mutexPost(void)  { OSMutexPost(mutex); }
+void resumePost(void) { OSTaskResume(RECEIVER_PRIORITY); }
+void ringPost(void)   { INT32U v = 1; OSRingPut(&ring, &v, 1); }
+void queue4Post(void) { queuePost(); queuePost(); queuePost(); queuePost(); }
+void qmultiPost(void) { INT8U err; void *m[4] = { 0, 0, 0, 0 }; OSQPostMulti(queue, m, 4, &err); }
+void multiPost(void)  { OSSemPost(multi_sems[MULTI_EVENTS - 1]); }
+
+void semPend(void)    { INT8U err; OSSemPend(sem, 0, &err); }
+void mboxPend(void)   { INT8U err; OSMboxPend(mbox, 0, &err); }
+void queuePend(void)  { INT8U err; OSQPend(queue, 0, &err); }
+void flagPend(void)   { INT8U err; OSFlagPend(flags, 0x01, OS_FLAG_WAIT_SET_ANY + OS_FLAG_CONSUME, 0, &err); }
+void resumePend(void) { OSTaskSuspend(OS_PRIO_SELF); }
+void ringPend(void)   { INT8U err; INT32U v; OSRingPend(&ring, &v, 1, 0, &err); }
+void queue4Pend(void) { queuePend(); queuePend(); queuePend(); queuePend(); }
+void qmultiPend(void) { INT8U err; void *m[4]; OSQPendMulti(queue, m, 4, 0, &err); }
+
+void multiPend(void)
+{
+  INT8U err;
+  OS_EVENT *rdy[MULTI_EVENTS + 1];
+  void *msgs[MULTI_EVENTS];
+
+  OSEventPendMulti(multi_sems, rdy, msgs, 0, &err);
+}
+
+void pollPend(void)
+{
+  INT8U err;
+  OS_EVENT *rdy;
+
+  if (OSPollPend(poll, &rdy, 1, 0, &err) > 0)
+    OSSemAccept(rdy);
+}
+
+/* The sender takes the mutex, then lets the receiver block on it */
+void mutexSetup(void)
+{
+  INT8U err;
+
+  OSMutexPend(mutex, 0, &err);
+  OSSemPost(go_sem);
+}
+
+void mutexPend(void)
+{
+  INT8U err;
+
+  OSSemPend(go_sem, 0, &err);
+  OSMutexPend(mutex, 0, &err);
+}
+
+void mutexRelease(void) { OSMutexPost(mutex); }
+
+/* Alarm callback, runs in the system clock interrupt every tick */
+alt_u32 isrAlarm(void* context)
+{
+  OSSemPost(sem);
+  return 1;
+}
+
+static const ipc_test tests[] = {
+  { "sem",    NULL,       semPost,    semPend,    perfStamp,   NULL         },
+  { "mbox",   NULL,       mboxPost,   mboxPend,   perfStamp,   NULL         },
+  { "queue",  NULL,       queuePost,  queuePend,  perfStamp,   NULL         },
+  { "flag",   NULL,       flagPost,   flagPend,   perfStamp,   NULL         },
+  { "mutex",  mutexSetup, mutexPost,  mutexPend,  perfStamp,   mutexRelease },
+  { "resume", NULL,       resumePost, resumePend, perfStamp,   NULL         },
+  { "ring",   NULL,       ringPost,   ringPend,   perfStamp,   NULL         },
+  { "queue4", NULL,       queue4Post, queue4Pend, perfStamp,   NULL         },
+  { "qmulti", NULL,       qmultiPost, qmultiPend, perfStamp,   NULL         },
+  { "multi",  NULL,       multiPost,  multiPend,  perfStamp,   NULL         },
+  { "poll",   NULL,       multiPost,  pollPend,   perfStamp,   NULL         },
+  { "isr",    NULL,       NULL,       semPend,    sysclkStamp, NULL         },
+};
+
+static const ipc_test *current;
+
+/* Waits for the objects of the current test and records the samples */
+void receiverTask(void* pdata)
+{
+  INT8U err;
+  int i;
+
+  while (1)
+    {
+      OSSemPend(start_sem, 0, &err);
+      for (i = 0; i < BENCH_SAMPLES; i++)
+        {
+          current->pend();
+          samples[i] = current->stamp();
+          if (current->release)
+            current->release();
+        }
+      OSSemPost(done_sem);
+    }
+}
+
+int compareSamples(const void *a, const void *b)
+{
+  alt_u32 x = *(const alt_u32 *)a;
+  alt_u32 y = *(const alt_u32 *)b;
+
+  return (x > y) - (x < y);
+}
+
+/* Prints the statistics row and the histogram row of the samples */
+void report(const char *name)
+{
+  alt_u32 count[HIST_BUCKETS] = { 0 };
+  alt_u64 sum = 0;
+  alt_u32 min, max, width;
+  int i;
+
+  qsort(samples, BENCH_SAMPLES, sizeof(samples[0]), compareSamples);
+  min = samples[0];
+  max = samples[BENCH_SAMPLES - 1];
+  width = (max - min) / HIST_BUCKETS + 1;
+  for (i = 0; i < BENCH_SAMPLES; i++)
+    {
+      sum += samples[i];
+      count[(samples[i] - min) / width]++;
+    }
+
+  printf("%s,%d,%lu,%lu,%lu,%lu,%lu\n", name, BENCH_SAMPLES,
+         (unsigned long)min,
+         (unsigned long)samples[BENCH_SAMPLES / 2],
+         (unsigned long)samples[(BENCH_SAMPLES * 99 + 99) / 100 - 1],
+         (unsigned long)max,
+         (unsigned long)(sum / BENCH_SAMPLES));
+  printf("hist,%s,%lu,%lu", name, (unsigned long)min, (unsigned long)width);
+  for (i = 0; i < HIST_BUCKETS; i++)
+    printf(",%lu", (unsigned long)count[i]);
+  printf("\n");
+}
+
+/* Cost of starting and stopping the performance counter */
+void measureNull(void)
+{
+  int i;
+
+  for (i = 0; i < BENCH_SAMPLES; i++)
+    {
+      PERF_RESET(PERFORMANCE_COUNTER_BASE);
+      PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+      samples[i] = perfStamp();
+    }
+  report("null");
+}
+
+void runTest(const ipc_test *test)
+{
+  INT8U err;
+  int i;
+
+  current = test;
+  OSSemPost(start_sem);              // The receiver now waits in test->pend()
+  if (test->post)
+    {
+      for (i = 0; i < BENCH_SAMPLES; i++)
+        {
+          if (test->setup)
+            test->setup();
+          PERF_RESET(PERFORMANCE_COUNTER_BASE);
+          PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+          test->post();
+        }
+      OSSemPend(done_sem, 0, &err);
+    }
+  else
+    {
+      alt_alarm_start(&isr_alarm, 1, isrAlarm, NULL);
+      OSSemPend(done_sem, 0, &err);
+      alt_alarm_stop(&isr_alarm);
+    }
+  report(test->name);
+}
+
+void senderTask(void* pdata)
+{
+  INT8U err;
+  int n;
+
+  start_sem = OSSemCreate(0);
+  done_sem  = OSSemCreate(0);
+  go_sem    = OSSemCreate(0);
+  sem       = OSSemCreate(0);
+  mbox      = OSMboxCreate(NULL);
+  queue     = OSQCreate(queue_storage, sizeof(queue_storage) / sizeof(queue_storage[0]));
+  mutex     = OSMutexCreate(MUTEX_PIP, &err);
+  flags     = OSFlagCreate(0, &err);
+  ring_sem  = OSSemCreate(0);
+  OSRingCreate(&ring, ring_storage, sizeof(ring_storage) / sizeof(ring_storage[0]),
+               sizeof(ring_storage[0]), ring_sem);
+  poll      = OSPollCreate();
+  for (n = 0; n < MULTI_EVENTS; n++)
+    {
+      multi_sems[n] = OSSemCreate(0);
+      OSPollAdd(poll, multi_sems[n]);
+    }
+
+  OSTaskCreateExt
+    ( receiverTask,                    // Pointer to task code
+      NULL,                            // Pointer to argument passed to task
+      &receiver_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      RECEIVER_PRIORITY,               // Desired Task priority
+      RECEIVER_PRIORITY,               // Task ID
+      &receiver_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,                  // Stacksize
+      NULL,                            // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |            // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR              // Stack Cleared
+      );
+
+  printf("IpcBench: cpu_hz=%d samples=%d OS_ISR_POST_DEFERRED_EN=%d\n",
+         ALT_CPU_FREQ, BENCH_SAMPLES, OS_ISR_POST_DEFERRED_EN);
+  printf("test,n,min,median,p99,max,mean\n");
+  measureNull();
+  for (n = 0; n < sizeof(tests) / sizeof(tests[0]); n++)
+    {
+      runTest(&tests[n]);
+    }
+  printf("end\n");
+  OSTaskDel(OS_PRIO_SELF);
+}
+
+int main(void)
+{
+  printf("Lab - IPC latency benchmark\n");
+
+  OSTaskCreateExt
+    ( senderTask,                    // Pointer to task code
+      NULL,                          // Pointer to argument passed to task
+      &sender_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      SENDER_PRIORITY,               // Desired Task priority
+      SENDER_PRIORITY,               // Task ID
+      &sender_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,                // Stacksize
+      NULL,                          // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |          // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR            // Stack Cleared
+      );
+
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,204 @@
+// File: TmrBench.c
+//
+// Measures the cost of one timer tick of OSTmr_Task() as a function of the
+// number of running OS_TMR timers. Build once with OS_TMR_HWHEEL_EN set to
+// 1 and once with it set to 0 (os_cfg.h) to compare the hierarchical timer
+// wheel with the flat OS_TMR_CFG_WHEEL_SIZE wheel.
+//
+// Three out of four timers are periodic, with periods from 2 to 301 timer
+// ticks. The others are one-shot timeouts of several thousand timer ticks
+// which the bench task stops and starts again before every sample, the way
+// a timeout is restarted each time the awaited event arrives, so they never
+// expire.
+//
+// The timer time follows the kernel tick count, so the bench stops the
+// system clock and advances the kernel itself: it calls OSTimeTick() for one
+// timer tick with the scheduler locked, and a sample runs from
+// OSSchedUnlock() until the timer task, which has a higher priority, has
+// processed the tick and waits again. All values are in CPU cycles. The
+// samples with zero timers are the cost of OSSchedUnlock() and the two
+// context switches.
+// 'restart' is the mean cost of one OSTmrStop() and OSTmrStart() pair.
+// Every callback checks that it runs on the timer tick it is due; 'late'
+// counts the callbacks that did not.
+//
+//   timers,ticks,min,mean,max,restart,expired,late
+
+#include <stdio.h>
+#include <stdint.h>
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+#include "sys/alt_irq.h"
+#include "system.h"
+
+#define BENCH_TICKS         500   // Timer ticks per measurement
+#define MAX_TIMERS          500   // Needs OS_TMR_CFG_MAX >= MAX_TIMERS (run.sh)
+#define TIMEOUT_DLY        5000   // Delay of the one-shot timers, never expires
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+OS_STK    bench_stk[TASK_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define BENCH_PRIORITY       4   // below the timer task (OS_TASK_TMR_PRIO)
+
+static const int timer_counts[] = { 0, 16, 64, 256, MAX_TIMERS };
+
+static OS_TMR  *timers[MAX_TIMERS];
+static INT32U   due[MAX_TIMERS];     // Timer tick of the next expiry
+static INT32U   period[MAX_TIMERS];
+static INT32U   expired;
+static INT32U   late;
+
+/* Runs in the timer task when a periodic timer expires */
+void tmrCallback(void *ptmr, void *callback_arg)
+{
+  int i = (int)(uintptr_t)callback_arg;
+
+  if (OSTmrTime != due[i])
+    late++;
+  due[i] = OSTmrTime + period[i];
+  expired++;
+}
+
+/* Starts a timer and records when it is due, before the timer task can run */
+void startTimer(int i)
+{
+  INT8U err;
+
+  OSSchedLock();
+  OSTmrStart(timers[i], &err);
+  due[i] = OSTmrTime + period[i];
+  OSSchedUnlock();
+}
+
+/* Creates and starts more timers until there are 'count' of them */
+void createTimers(int created, int count)
+{
+  INT8U err;
+  int i;
+
+  for (i = created; i < count; i++)
+    {
+      if (i % 4 == 3)
+        {
+          period[i] = TIMEOUT_DLY + i;
+          timers[i] = OSTmrCreate(period[i], 0, OS_TMR_OPT_ONE_SHOT,
+                                  tmrCallback, (void *)(uintptr_t)i,
+                                  (INT8U *)"Timeout", &err);
+        }
+      else
+        {
+          period[i] = 2 + (i * 37) % 300;
+          timers[i] = OSTmrCreate(0, period[i], OS_TMR_OPT_PERIODIC,
+                                  tmrCallback, (void *)(uintptr_t)i,
+                                  (INT8U *)"Periodic", &err);
+        }
+      if (err != OS_ERR_NONE)
+        {
+          printf("OSTmrCreate() failed (%d), raise OS_TMR_CFG_MAX\n", err);
+          OSTaskDel(OS_PRIO_SELF);
+        }
+      startTimer(i);
+    }
+}
+
+/* Stops and starts all one-shot timers, returns the cycles spent */
+alt_u64 restartTimeouts(int count)
+{
+  INT8U err;
+  int i;
+
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  for (i = 3; i < count; i += 4)
+    {
+      OSTmrStop(timers[i], OS_TMR_OPT_NONE, NULL, &err);
+      OSTmrStart(timers[i], &err);
+    }
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+
+  return perf_get_total_time((void *)PERFORMANCE_COUNTER_BASE);
+}
+
+/* Lets the timer task process one tick, returns the cycles spent */
+alt_u64 measureTick(void)
+{
+  int i;
+
+  OSSchedLock();
+  for (i = 0; i < OS_TMR_TICK_DIV; i++)
+    OSTimeTick();                    // The last one signals the timer task
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  OSSchedUnlock();                   // The timer task runs before this returns
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+
+  return perf_get_total_time((void *)PERFORMANCE_COUNTER_BASE);
+}
+
+void benchTask(void* pdata)
+{
+  alt_u64 cycles, min, max, sum, restart;
+  INT32U expired_start, late_start;
+  int created = 0;
+  int n, i;
+
+  printf("TmrBench: OS_TMR_HWHEEL_EN=%d OS_TMR_CFG_WHEEL_SIZE=%d, %d ticks per sample\n",
+         OS_TMR_HWHEEL_EN, OS_TMR_CFG_WHEEL_SIZE, BENCH_TICKS);
+  alt_ic_irq_disable(TIMER_0_IRQ_INTERRUPT_CONTROLLER_ID, TIMER_0_IRQ);  // Stop the system clock
+  printf("timers,ticks,min,mean,max,restart,expired,late\n");
+  for (n = 0; n < sizeof(timer_counts) / sizeof(timer_counts[0]); n++)
+    {
+      createTimers(created, timer_counts[n]);
+      created = timer_counts[n];
+
+      expired_start = expired;
+      late_start    = late;
+      min = ~(alt_u64)0;
+      max = 0;
+      sum = 0;
+      restart = 0;
+      for (i = 0; i < BENCH_TICKS; i++)
+        {
+          restart += restartTimeouts(created);
+          cycles = measureTick();
+          sum += cycles;
+          if (cycles < min)
+            min = cycles;
+          if (cycles > max)
+            max = cycles;
+        }
+      restart = (created >= 4) ? restart / ((alt_u64)BENCH_TICKS * (created / 4)) : 0;
+
+      printf("%d,%d,%lu,%lu,%lu,%lu,%lu,%lu\n", created, BENCH_TICKS,
+             (unsigned long)min, (unsigned long)(sum / BENCH_TICKS),
+             (unsigned long)max, (unsigned long)restart,
+             (unsigned long)(expired - expired_start),
+             (unsigned long)(late - late_start));
+    }
+  printf("end\n");
+  OSTaskDel(OS_PRIO_SELF);
+}
+
+int main(void)
+{
+  printf("Lab - Timer benchmark\n");
+
+  OSTaskCreateExt
+    ( benchTask,                    // Pointer to task code
+      NULL,                         // Pointer to argument passed to task
+      &bench_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      BENCH_PRIORITY,               // Desired Task priority
+      BENCH_PRIORITY,               // Task ID
+      &bench_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,               // Stacksize
+      NULL,                         // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |         // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR           // Stack Cleared
+      );
+
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,187 @@
+// File: HrTimer.c
+//
+// Releases a control task every CONTROL_PERIOD_US microseconds from a high
+// resolution timer (sys/alt_hrtimer.h) instead of the OS_TMR timers, whose
+// resolution is the 100 ms HW_TIMER_PERIOD of the other applications, and
+// without raising the system clock rate. A second task re-arms a one-shot
+// timer of ONESHOT_US microseconds every time it expires.
+//
+// Every second the report task prints, per task, the number of releases and
+// the release latency: the time from the expiry of the timer to the first
+// instruction of the released task, in microseconds.
+//
+//   task,releases,min_us,mean_us,max_us
+//
+// The timer is selected with -DALT_HRTIMER_CLK=TIMER_1 (run.sh).
+
+#include <stdio.h>
+#include "includes.h"
+#include "sys/alt_hrtimer.h"
+#include "sys/alt_irq.h"
+#include "system.h"
+
+#define CONTROL_PERIOD_US    5000   // 5 ms control loop
+#define ONESHOT_US            250   // Delay of the one-shot timer
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+OS_STK    control_stk[TASK_STACKSIZE];
+OS_STK    oneshot_stk[TASK_STACKSIZE];
+OS_STK    report_stk[TASK_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define CONTROL_PRIORITY     5
+#define ONESHOT_PRIORITY     6
+#define REPORT_PRIORITY     10
+
+typedef struct {
+  alt_hrtimer timer;
+  OS_EVENT   *sem;
+  alt_u64     released;   // Expiry of the timer that released the task
+  alt_u32     count;
+  alt_u64     sum;        // Latencies, in timer clock cycles
+  alt_u64     min;
+  alt_u64     max;
+} release_stats;
+
+static release_stats control;
+static release_stats oneshot;
+
+/* Timer callbacks, run in the timer interrupt */
+alt_u32 controlRelease(void* context)
+{
+  control.released = control.timer.time;
+  OSSemPost(control.sem);
+  return CONTROL_PERIOD_US;
+}
+
+alt_u32 oneshotRelease(void* context)
+{
+  oneshot.released = oneshot.timer.time;
+  OSSemPost(oneshot.sem);
+  return 0;
+}
+
+/* Records the latency of the release that woke up the task */
+void recordRelease(release_stats *stats)
+{
+  alt_irq_context context;
+  alt_u64 latency;
+
+  context = alt_irq_disable_all();
+  latency = alt_hrtimer_clock() - stats->released;
+  stats->count++;
+  stats->sum += latency;
+  if (latency < stats->min)
+    stats->min = latency;
+  if (latency > stats->max)
+    stats->max = latency;
+  alt_irq_enable_all(context);
+}
+
+void controlTask(void* pdata)
+{
+  INT8U err;
+
+  while (1)
+    {
+      OSSemPend(control.sem, 0, &err);
+      recordRelease(&control);
+      /* The control law would run here */
+    }
+}
+
+void oneshotTask(void* pdata)
+{
+  INT8U err;
+
+  while (1)
+    {
+      alt_hrtimer_start(&oneshot.timer, ONESHOT_US, oneshotRelease, NULL);
+      OSSemPend(oneshot.sem, 0, &err);
+      recordRelease(&oneshot);
+    }
+}
+
+alt_u32 toMicroseconds(alt_u64 cycles)
+{
+  return (alt_u32)(cycles * 1000000 / alt_hrtimer_freq());
+}
+
+/* Prints and clears the statistics of one task */
+void report(const char *name, release_stats *stats)
+{
+  alt_irq_context context;
+  release_stats copy;
+
+  context = alt_irq_disable_all();
+  copy = *stats;
+  stats->count = 0;
+  stats->sum   = 0;
+  stats->min   = ~(alt_u64)0;
+  stats->max   = 0;
+  alt_irq_enable_all(context);
+
+  if (copy.count == 0)
+    {
+      printf("%s,0,,,\n", name);
+      return;
+    }
+  printf("%s,%lu,%lu,%lu,%lu\n", name, (unsigned long)copy.count,
+         (unsigned long)toMicroseconds(copy.min),
+         (unsigned long)toMicroseconds(copy.sum / copy.count),
+         (unsigned long)toMicroseconds(copy.max));
+}
+
+void createTask(void (*task)(void *), OS_STK *stk, INT8U prio)
+{
+  OSTaskCreateExt
+    ( task,                        // Pointer to task code
+      NULL,                        // Pointer to argument passed to task
+      &stk[TASK_STACKSIZE-1],      // Pointer to top of task stack
+      prio,                        // Desired Task priority
+      prio,                        // Task ID
+      &stk[0],                     // Pointer to bottom of task stack
+      TASK_STACKSIZE,              // Stacksize
+      NULL,                        // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |        // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR          // Stack Cleared
+      );
+}
+
+void reportTask(void* pdata)
+{
+  control.sem = OSSemCreate(0);
+  oneshot.sem = OSSemCreate(0);
+  control.min = oneshot.min = ~(alt_u64)0;
+
+  if (alt_hrtimer_start(&control.timer, CONTROL_PERIOD_US, controlRelease, NULL) < 0)
+    {
+      printf("No high resolution timer, define ALT_HRTIMER_CLK (run.sh)\n");
+      OSTaskDel(OS_PRIO_SELF);
+    }
+  printf("HrTimer: clock=%lu Hz, control period %d us, one-shot %d us\n",
+         (unsigned long)alt_hrtimer_freq(), CONTROL_PERIOD_US, ONESHOT_US);
+
+  createTask(controlTask, control_stk, CONTROL_PRIORITY);
+  createTask(oneshotTask, oneshot_stk, ONESHOT_PRIORITY);
+
+  printf("task,releases,min_us,mean_us,max_us\n");
+  while (1)
+    {
+      OSTimeDlyHMSM(0, 0, 1, 0);
+      report("control", &control);
+      report("oneshot", &oneshot);
+    }
+}
+
+int main(void)
+{
+  printf("Lab - High resolution timers\n");
+
+  createTask(reportTask, report_stk, REPORT_PRIORITY);
+
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,206 @@
+// File: Tickless.c
+//
+// Checks the tickless idle mode (OS_TICKLESS_EN). While all tasks wait,
+// the system clock is suspended until the first task delay, pend timeout,
+// OS_TMR timer or HAL alarm expires, and the ticks skipped are replayed in
+// one step when it wakes up.
+//
+// The test task delays, then pends with a timeout, for periods from one
+// tick up to longer than a suspension of the system clock can last, and
+// checks that OSTimeGet64() advanced by exactly the requested number of
+// ticks. Meanwhile a second task delays by STEADY_TICKS ticks in a loop and
+// checks every wake up, a periodic OS_TMR timer and a HAL alarm count their
+// callbacks. One line is printed per check:
+//
+//   check,ticks,elapsed,result
+//
+// The counts of the second task, the timer and the alarm are checked
+// against the elapsed time at the end. When the HAL keeps IRQ statistics
+// the number of system clock interrupts is printed too; it is far lower
+// than the number of ticks when ticks are skipped. The program exits with
+// status 0 if all checks pass.
+//
+// Requires OS_TICKLESS_EN set to 1 (os_cfg.h). On the workstation, run it
+// in virtual time. The long delays then cost no real time, and ticks do not
+// arrive in bursts when the workstation is busy, which the exact checks
+// would count as late wake ups:
+//
+//   cd ../../host; HOST_TIME=virtual ./run.sh ../app/17_Tickless path/to/bsp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "includes.h"
+#include "sys/alt_alarm.h"
+#include "sys/alt_irq_stats.h"
+#include "system.h"
+
+#if OS_TICKLESS_EN == 0
+#error "Set OS_TICKLESS_EN to 1 in os_cfg.h"
+#endif
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+OS_STK    test_stk[TASK_STACKSIZE];
+OS_STK    steady_stk[TASK_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define STEADY_PRIORITY       5
+#define TEST_PRIORITY         6
+
+#define STEADY_TICKS         37   // Delay of the second task, a prime
+#define ALARM_TICKS         250   // Period of the HAL alarm
+#define TMR_PERIOD            7   // Period of the OS_TMR timer, in timer ticks
+#define TMR_TICKS           (TMR_PERIOD * (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC))
+
+// Ticks to delay and pend for; the last one is longer than the 32 bit
+// timer of the board can be suspended for (2^32 cycles at 50 MHz)
+static const INT32U test_ticks[] = { 1, 2, 3, 10, 99, 1000, 12345, 100000 };
+
+static OS_EVENT *test_sem;
+static alt_alarm alarm;
+static int       errors;
+
+static volatile INT32U steady_wakeups;
+static volatile INT32U steady_late;
+static volatile INT32U alarm_calls;
+static volatile INT32U tmr_calls;
+
+alt_u32 alarmCallback(void* context)
+{
+  alarm_calls++;
+  return ALARM_TICKS;
+}
+
+void tmrCallback(void *ptmr, void *callback_arg)
+{
+  tmr_calls++;
+}
+
+/* Prints one check and counts it if it failed */
+void check(const char *name, INT32U ticks, INT32U elapsed, INT32U expected)
+{
+  int ok = (elapsed == expected);
+
+  printf("%s,%lu,%lu,%s\n", name, (unsigned long)ticks,
+         (unsigned long)elapsed, ok ? "ok" : "FAIL");
+  if (!ok)
+    errors++;
+}
+
+/* Checks a count against the one expected from the elapsed time, +-1 */
+void checkCount(const char *name, INT32U count, INT32U expected)
+{
+  int ok = (count + 1 >= expected) && (count <= expected + 1);
+
+  printf("%s,%lu,%lu,%s\n", name, (unsigned long)expected,
+         (unsigned long)count, ok ? "ok" : "FAIL");
+  if (!ok)
+    errors++;
+}
+
+/* Delays by STEADY_TICKS and checks that every wake up is on time */
+void steadyTask(void* pdata)
+{
+  INT64U next = OSTimeGet64() + STEADY_TICKS;
+
+  while (1)
+    {
+      OSTimeDly(STEADY_TICKS);
+      if (OSTimeGet64() != next)
+        steady_late++;
+      next = OSTimeGet64() + STEADY_TICKS;
+      steady_wakeups++;
+    }
+}
+
+void createTask(void (*task)(void *), OS_STK *stk, INT8U prio)
+{
+  OSTaskCreateExt
+    ( task,                        // Pointer to task code
+      NULL,                        // Pointer to argument passed to task
+      &stk[TASK_STACKSIZE-1],      // Pointer to top of task stack
+      prio,                        // Desired Task priority
+      prio,                        // Task ID
+      &stk[0],                     // Pointer to bottom of task stack
+      TASK_STACKSIZE,              // Stacksize
+      NULL,                        // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |        // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR          // Stack Cleared
+      );
+}
+
+void testTask(void* pdata)
+{
+  INT8U   err;
+  INT64U  start;
+  INT64U  t0;
+  INT32U  elapsed;
+  OS_TMR *tmr;
+  int     i;
+#if ALT_IRQ_STATS_EN > 0
+  alt_irq_stats stats;
+  alt_u32 irqs = 0;
+
+  if (alt_irq_stats_get(TIMER_0_IRQ, &stats) == 0)
+    irqs = stats.count;
+#endif
+
+  test_sem = OSSemCreate(0);
+  tmr = OSTmrCreate(TMR_PERIOD, TMR_PERIOD, OS_TMR_OPT_PERIODIC,
+                    tmrCallback, NULL, (INT8U *)"Tickless", &err);
+  if (err == OS_ERR_NONE)
+    OSTmrStart(tmr, &err);
+  if (err != OS_ERR_NONE)
+    {
+      printf("Cannot start the OS_TMR timer (error %d)\n", err);
+      exit(1);
+    }
+  alt_alarm_start(&alarm, ALARM_TICKS, alarmCallback, NULL);
+  createTask(steadyTask, steady_stk, STEADY_PRIORITY);
+
+  printf("check,ticks,elapsed,result\n");
+  start = OSTimeGet64();
+  for (i = 0; i < sizeof(test_ticks) / sizeof(test_ticks[0]); i++)
+    {
+      OSTimeDly(1);                // Start on a tick, after the printf()
+      t0 = OSTimeGet64();
+      OSTimeDly(test_ticks[i]);
+      elapsed = (INT32U)(OSTimeGet64() - t0);
+      check("delay", test_ticks[i], elapsed, test_ticks[i]);
+
+      OSTimeDly(1);
+      t0 = OSTimeGet64();
+      OSSemPend(test_sem, test_ticks[i], &err);
+      elapsed = (INT32U)(OSTimeGet64() - t0);
+      check(err == OS_ERR_TIMEOUT ? "pend" : "pend(no timeout)",
+            test_ticks[i], elapsed, err == OS_ERR_TIMEOUT ? test_ticks[i] : ~0UL);
+    }
+#if OS_TIME_GET_SET_EN > 0
+  check("OSTimeGet", 0, OSTimeGet(), (INT32U)OSTimeGet64());
+#endif
+
+  elapsed = (INT32U)(OSTimeGet64() - start);
+  checkCount("steady", steady_wakeups, elapsed / STEADY_TICKS);
+  checkCount("steady late", steady_late, 0);
+  checkCount("alarm", alarm_calls, elapsed / ALARM_TICKS);
+  checkCount("timer", tmr_calls, elapsed / TMR_TICKS);
+#if ALT_IRQ_STATS_EN > 0
+  if (alt_irq_stats_get(TIMER_0_IRQ, &stats) == 0)
+    printf("%lu ticks, %lu system clock interrupts\n",
+           (unsigned long)elapsed, (unsigned long)(stats.count - irqs));
+#endif
+
+  printf("Tickless: %s (%d failed)\n", errors ? "FAIL" : "PASS", errors);
+  exit(errors ? 1 : 0);
+}
+
+int main(void)
+{
+  printf("Lab - Tickless idle\n");
+
+  createTask(testTask, test_stk, TEST_PRIORITY);
+
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,161 @@
+// File: RingStress.c
+//
+// Stress test of the ring buffers (OSRingPut()/OSRingPend()). A high
+// resolution timer interrupt is the producer: every PUT_PERIOD_US
+// microseconds it puts a batch of 1 to PUT_BATCH consecutive numbers into
+// a ring of RING_SIZE entries. The consumer task takes up to GET_BATCH
+// entries at a time and checks that it receives every number put, in
+// order. Every CONSUMER_PAUSE takes it sleeps for a tick, so that the ring
+// fills up and the producer has batches that only fit in part.
+//
+// After TEST_TICKS ticks the timer is stopped, the consumer takes the
+// entries left in the ring and prints:
+//
+//   isrs,put,got,dropped,pends,result
+//
+// The program exits with status 0 if all numbers put were received in
+// order, and the ring was full at least once.
+//
+// The timer is selected with -DALT_HRTIMER_CLK=TIMER_1 (run.sh). On the
+// workstation:
+//
+//   cd ../../host; HOST_CFLAGS=-DALT_HRTIMER_CLK=TIMER_1 HOST_TIME=virtual ./run.sh ../app/18_RingStress
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "includes.h"
+#include "sys/alt_hrtimer.h"
+#include "system.h"
+
+#if OS_RING_EN == 0
+#error "Set OS_RING_EN to 1 in os_cfg.h"
+#endif
+
+#define PUT_PERIOD_US        20   // Period of the producer interrupt
+#define PUT_BATCH             5   // Largest batch put by the producer
+#define GET_BATCH             7   // Largest batch taken by the consumer
+#define RING_SIZE            16   // Entries of the ring, a power of 2
+#define CONSUMER_PAUSE       64   // Takes between two pauses of the consumer
+#define TEST_TICKS          300
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+OS_STK    consumer_stk[TASK_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define CONSUMER_PRIORITY     6
+
+static OS_RING     ring;
+static INT32U      ring_storage[RING_SIZE];
+static alt_hrtimer producer;
+
+static volatile INT32U isrs;
+static volatile INT32U next_put;    // Next number to put
+static volatile INT32U dropped;     // Numbers that did not fit
+
+/* Timer callback, runs in the timer interrupt */
+alt_u32 producerPut(void* context)
+{
+  INT32U batch[PUT_BATCH];
+  INT16U n = 1 + isrs++ % PUT_BATCH;
+  INT16U put;
+  INT16U i;
+
+  for (i = 0; i < n; i++)
+    batch[i] = next_put + i;
+  put = OSRingPut(&ring, batch, n);
+  next_put += put;
+  dropped  += n - put;
+  return PUT_PERIOD_US;
+}
+
+void consumerTask(void* pdata)
+{
+  INT8U  err;
+  INT32U batch[GET_BATCH];
+  INT32U expected = 0;
+  INT32U pends = 0;
+  INT32U start;
+  INT16U n;
+  INT16U i;
+  int    errors = 0;
+
+  start = OSTimeGet();
+  alt_hrtimer_start(&producer, PUT_PERIOD_US, producerPut, NULL);
+  while (OSTimeGet() - start < TEST_TICKS)
+    {
+      n = OSRingPend(&ring, batch, GET_BATCH, 10, &err);
+      pends++;
+      if (err != OS_ERR_NONE)
+        {
+          printf("OSRingPend() error %d\n", err);
+          errors++;
+        }
+      for (i = 0; i < n; i++, expected++)
+        {
+          if (batch[i] != expected)
+            {
+              printf("Got %lu instead of %lu\n",
+                     (unsigned long)batch[i], (unsigned long)expected);
+              errors++;
+              expected = batch[i];
+            }
+        }
+      if (pends % CONSUMER_PAUSE == 0)
+        OSTimeDly(1);              // Let the ring fill up
+    }
+  alt_hrtimer_stop(&producer);
+
+  while ((n = OSRingGet(&ring, batch, GET_BATCH)) > 0)
+    {
+      for (i = 0; i < n; i++, expected++)
+        {
+          if (batch[i] != expected)
+            {
+              errors++;
+              expected = batch[i];
+            }
+        }
+    }
+  if (expected != next_put || dropped == 0)
+    errors++;
+
+  printf("isrs,put,got,dropped,pends,result\n");
+  printf("%lu,%lu,%lu,%lu,%lu,%s\n", (unsigned long)isrs,
+         (unsigned long)next_put, (unsigned long)expected,
+         (unsigned long)dropped, (unsigned long)pends, errors ? "FAIL" : "ok");
+  printf("RingStress: %s\n", errors ? "FAIL" : "PASS");
+  exit(errors ? 1 : 0);
+}
+
+int main(void)
+{
+  INT8U err;
+
+  printf("Lab - Ring buffer stress test\n");
+
+  err = OSRingCreate(&ring, ring_storage, RING_SIZE, sizeof(ring_storage[0]),
+                     OSSemCreate(0));
+  if (err != OS_ERR_NONE)
+    {
+      printf("Cannot create the ring (error %d)\n", err);
+      exit(1);
+    }
+
+  OSTaskCreateExt
+    ( consumerTask,                    // Pointer to task code
+      NULL,                            // Pointer to argument passed to task
+      &consumer_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      CONSUMER_PRIORITY,               // Desired Task priority
+      CONSUMER_PRIORITY,               // Task ID
+      &consumer_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,                  // Stacksize
+      NULL,                            // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |            // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR              // Stack Cleared
+      );
+
+  OSStart();
+  return 0;
+}
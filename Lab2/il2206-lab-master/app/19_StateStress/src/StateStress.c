@@ -0,0 +1,219 @@
+// File: StateStress.c
+//
+// Stress test of the state channels (OSStateWrite()/OSStatePend()/
+// OSStateRead()). A high resolution timer interrupt is the writer: every
+// WRITE_PERIOD_US microseconds it writes a value of VALUE_WORDS words, all
+// derived from the number of the write. Two tasks wait for every new value
+// with OSStatePend() and a low priority task reads the channel in a loop
+// with OSStateRead(). Each reader checks that no value it gets is torn
+// (mixes two writes) and that its version matches the write, and the
+// waiting tasks check that the version always increases.
+//
+// After TEST_TICKS ticks the timer is stopped, a pend on the unchanged
+// channel must time out, and the program prints:
+//
+//   writes,wakes0,wakes1,skipped0,skipped1,reads,result
+//
+// where 'skipped' counts the writes a waiting task did not see because a
+// newer value had replaced them. The program exits with status 0 if all
+// checks pass.
+//
+// The timer is selected with -DALT_HRTIMER_CLK=TIMER_1 (run.sh). On the
+// workstation, run it in real time. The polling task never lets the idle
+// task run, and in virtual time the writes then come in bursts, one per
+// tick of the CPU time clock of the workstation:
+//
+//   cd ../../host; HOST_CFLAGS=-DALT_HRTIMER_CLK=TIMER_1 ./run.sh ../app/19_StateStress
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "includes.h"
+#include "sys/alt_hrtimer.h"
+#include "system.h"
+
+#if OS_STATE_EN == 0
+#error "Set OS_STATE_EN to 1 in os_cfg.h"
+#endif
+
+#define WRITE_PERIOD_US      37   // Period of the writer interrupt
+#define VALUE_WORDS          32   // Size of a value, so that copies take a while
+#define TEST_TICKS           20
+#define PEND_TIMEOUT          5
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+OS_STK    monitor_stk[TASK_STACKSIZE];
+OS_STK    pend0_stk[TASK_STACKSIZE];
+OS_STK    pend1_stk[TASK_STACKSIZE];
+OS_STK    poll_stk[TASK_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define MONITOR_PRIORITY      3
+#define PEND0_PRIORITY        5
+#define PEND1_PRIORITY        7
+#define POLL_PRIORITY        12
+
+typedef struct {
+  INT32U words[VALUE_WORDS];  // Even words hold the number of the write,
+} state_value;                // odd words its complement
+
+static OS_STATE    state;
+static OS_EVENT   *channel;
+static state_value state_storage[2];
+static alt_hrtimer writer;
+
+static volatile INT32U writes;
+static volatile INT32U wakes[2];
+static volatile INT32U skipped[2];
+static volatile INT32U reads;
+static volatile int    errors;
+
+/* Fills a value for write number 'n' */
+void fillValue(state_value *v, INT32U n)
+{
+  int i;
+
+  for (i = 0; i < VALUE_WORDS; i++)
+    v->words[i] = (i & 1) ? ~n : n;
+}
+
+/* Timer callback, runs in the timer interrupt */
+alt_u32 writerWrite(void* context)
+{
+  state_value v;
+
+  writes++;
+  fillValue(&v, writes);
+  OSStateWrite(channel, &v);
+  return WRITE_PERIOD_US;
+}
+
+/* Checks a value read with its version, and counts it if it is wrong */
+void checkValue(const char *reader, state_value *v, INT32U version)
+{
+  state_value expected;
+  int i;
+
+  fillValue(&expected, version);
+  for (i = 0; i < VALUE_WORDS; i++)
+    {
+      if (v->words[i] != expected.words[i])
+        {
+          printf("%s: word %d of version %lu is %08lx\n", reader, i,
+                 (unsigned long)version, (unsigned long)v->words[i]);
+          errors++;
+          return;
+        }
+    }
+}
+
+/* Waits for every new value of the channel */
+void pendTask(void* pdata)
+{
+  int         id = (int)(long)pdata;
+  INT8U       err;
+  INT32U      version = 0;
+  INT32U      next;
+  state_value v;
+
+  while (1)
+    {
+      next = OSStatePend(channel, &v, version, 0, &err);
+      if (err != OS_ERR_NONE || next <= version)
+        {
+          printf("pend%d: error %d, version %lu after %lu\n", id, err,
+                 (unsigned long)next, (unsigned long)version);
+          errors++;
+        }
+      checkValue(id ? "pend1" : "pend0", &v, next);
+      skipped[id] += next - version - 1;
+      version = next;
+      wakes[id]++;
+    }
+}
+
+/* Reads the channel whenever no other task runs */
+void pollTask(void* pdata)
+{
+  INT8U       err;
+  INT32U      version;
+  state_value v;
+
+  while (1)
+    {
+      version = OSStateRead(channel, &v, &err);
+      checkValue("poll", &v, version);
+      reads++;
+    }
+}
+
+void monitorTask(void* pdata)
+{
+  INT8U       err;
+  INT32U      version;
+  INT32U      start;
+  state_value v;
+
+  OSTimeDly(TEST_TICKS);
+  alt_hrtimer_stop(&writer);
+  OSTimeDly(2);                    // Let the waiting tasks see the last value
+
+  version = OSStateRead(channel, &v, &err);
+  start   = OSTimeGet();
+  OSStatePend(channel, &v, version, PEND_TIMEOUT, &err);
+  if (err != OS_ERR_TIMEOUT || OSTimeGet() - start < PEND_TIMEOUT)
+    {
+      printf("Pend on the unchanged channel: error %d after %lu ticks\n",
+             err, (unsigned long)(OSTimeGet() - start));
+      errors++;
+    }
+  if (wakes[0] == 0 || wakes[1] == 0 || reads == 0)
+    errors++;
+
+  printf("writes,wakes0,wakes1,skipped0,skipped1,reads,result\n");
+  printf("%lu,%lu,%lu,%lu,%lu,%lu,%s\n", (unsigned long)writes,
+         (unsigned long)wakes[0], (unsigned long)wakes[1],
+         (unsigned long)skipped[0], (unsigned long)skipped[1],
+         (unsigned long)reads, errors ? "FAIL" : "ok");
+  printf("StateStress: %s\n", errors ? "FAIL" : "PASS");
+  exit(errors ? 1 : 0);
+}
+
+void createTask(void (*task)(void *), void *arg, OS_STK *stk, INT8U prio)
+{
+  OSTaskCreateExt
+    ( task,                        // Pointer to task code
+      arg,                         // Pointer to argument passed to task
+      &stk[TASK_STACKSIZE-1],      // Pointer to top of task stack
+      prio,                        // Desired Task priority
+      prio,                        // Task ID
+      &stk[0],                     // Pointer to bottom of task stack
+      TASK_STACKSIZE,              // Stacksize
+      NULL,                        // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |        // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR          // Stack Cleared
+      );
+}
+
+int main(void)
+{
+  printf("Lab - State channel stress test\n");
+
+  fillValue(&state_storage[0], 0);  // The initial value has version 0
+  channel = OSStateCreate(&state, state_storage, sizeof(state_value));
+  if (channel == NULL)
+    {
+      printf("Cannot create the state channel\n");
+      exit(1);
+    }
+
+  createTask(monitorTask, NULL, monitor_stk, MONITOR_PRIORITY);
+  createTask(pendTask, (void *)0, pend0_stk, PEND0_PRIORITY);
+  createTask(pendTask, (void *)1, pend1_stk, PEND1_PRIORITY);
+  createTask(pollTask, NULL, poll_stk, POLL_PRIORITY);
+  alt_hrtimer_start(&writer, WRITE_PERIOD_US, writerWrite, NULL);
+
+  OSStart();
+  return 0;
+}
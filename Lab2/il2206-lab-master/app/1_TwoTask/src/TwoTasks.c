@@ -27,6 +27,17 @@ OS_EVENT  *DispSem;
 #define TASK2_PRIORITY      7
 #define TASK_STAT_PRIORITY 12  // lowest priority 
 
+/* Definition of Task Periods, in clock ticks. OS_TICKS_PER_SEC is a
+ * double, so the rate of the system clock timer (TIMER_0) is taken from
+ * its integer frequency and load value */
+#define TICKS_PER_SEC (TIMER_0_FREQ / (TIMER_0_LOAD_VALUE + 1))
+#define TASK1_PERIOD  (1 * TICKS_PER_SEC / 1000)  // 1ms
+#define TASK2_PERIOD  (1 * TICKS_PER_SEC / 1000)  // 1ms
+
+#if TASK1_PERIOD == 0 || TASK2_PERIOD == 0
+#error "A task period is shorter than a clock tick"
+#endif
+
 void printStackSize(char* name, int prio) 
 {
   INT8U err; // INT8U
@@ -52,6 +63,8 @@ void printStackSize(char* name, int prio)
 void task1(void* pdata)
 {
   INT8U err;
+  INT64U next = OSTimeGet64();  // Absolute time of the next release
+  INT32U overruns = 0;
 
   while (1)
     { 
@@ -66,12 +79,18 @@ void task1(void* pdata)
 
       OSSemPost(DispSem); // Semaphore is signaled
 
-      OSTimeDlyHMSM(0, 0, 0, 1); // 11ms delay
-      
       /* Context Switch to next task
 			 * Task will go to the ready state
-			 * after the specified delay
+			 * at its next release, one period after the last one,
+			 * however long the printing took
 			 */
+      next += TASK1_PERIOD;
+      if (OSTimeDlyUntil(next) == OS_ERR_TIME_OVERRUN)
+        {
+          overruns++;
+          if (DEBUG == 1)
+            printf("Task1 overrun (%" PRIu32 ")\n", overruns);
+        }
     }
 }
 
@@ -79,6 +98,8 @@ void task1(void* pdata)
 void task2(void* pdata)
 {
   INT8U err;
+  INT64U next = OSTimeGet64();  // Absolute time of the next release
+  INT32U overruns = 0;
 
   while (1)
     { 
@@ -91,7 +112,13 @@ void task2(void* pdata)
 	      putchar(text2[i]);
 
       OSSemPost(DispSem);  // Semaphore is signaled
-      OSTimeDlyHMSM(0, 0, 0, 1);  // 4ms delay
+      next += TASK2_PERIOD;
+      if (OSTimeDlyUntil(next) == OS_ERR_TIME_OVERRUN)
+        {
+          overruns++;
+          if (DEBUG == 1)
+            printf("Task2 overrun (%" PRIu32 ")\n", overruns);
+        }
 
     }
 }
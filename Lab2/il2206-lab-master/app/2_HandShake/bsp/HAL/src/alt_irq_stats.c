@@ -0,0 +1,67 @@
+/******************************************************************************
+*                                                                             *
+* alt_irq_stats.c - per interrupt service statistics.                         *
+*                                                                             *
+* The statistics are recorded by alt_irq_handler(); this file holds the       *
+* tables and the functions used by tasks to read and clear them. See          *
+* sys/alt_irq_stats.h.                                                        *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+
+#include "sys/alt_irq.h"
+#include "sys/alt_irq_stats.h"
+
+#if ALT_IRQ_STATS_EN > 0
+
+alt_irq_stats alt_irq_stats_tbl[ALT_NIRQ];
+alt_u32       alt_irq_stats_depth;
+
+/*
+ * alt_irq_stats_get() copies the statistics of one IRQ number with
+ * interrupts disabled, so that they all belong to the same point in time.
+ */
+
+int alt_irq_stats_get (alt_u32 irq, alt_irq_stats* stats)
+{
+  alt_irq_context context;
+
+  if (irq >= ALT_NIRQ)
+  {
+    return -EINVAL;
+  }
+
+  context = alt_irq_disable_all ();
+  *stats  = alt_irq_stats_tbl[irq];
+  alt_irq_enable_all (context);
+
+  return 0;
+}
+
+/*
+ * alt_irq_stats_reset() clears the statistics of all IRQ numbers.
+ */
+
+void alt_irq_stats_reset (void)
+{
+  alt_irq_context context;
+
+  context = alt_irq_disable_all ();
+  memset (alt_irq_stats_tbl, 0, sizeof (alt_irq_stats_tbl));
+  alt_irq_enable_all (context);
+}
+
+#else /* ALT_IRQ_STATS_EN */
+
+int alt_irq_stats_get (alt_u32 irq, alt_irq_stats* stats)
+{
+  return -EINVAL;
+}
+
+void alt_irq_stats_reset (void)
+{
+}
+
+#endif /* ALT_IRQ_STATS_EN */
@@ -72,16 +72,16 @@ extern struct timeval  alt_resettime;
 int ALT_SETTIMEOFDAY (const struct timeval  *t,
                       const struct timezone *tz)
 {
-  alt_u32 nticks    = alt_nticks ();
+  alt_u64 nticks    = alt_nticks64 ();
   alt_u32 tick_rate = alt_ticks_per_second ();
 
   /* If there is a system clock available, update the current time */
 
   if (tick_rate)
   {
-    alt_resettime.tv_sec  = t->tv_sec - nticks/tick_rate;
+    alt_resettime.tv_sec  = t->tv_sec - (time_t)(nticks/tick_rate);
     alt_resettime.tv_usec = t->tv_usec - 
-      ((nticks*(ALT_US/tick_rate))%ALT_US);
+      (alt_u32)((nticks%tick_rate)*(ALT_US/tick_rate));
 
     alt_timezone.tz_minuteswest = tz->tz_minuteswest;
     alt_timezone.tz_dsttime     = tz->tz_dsttime;
@@ -32,7 +32,7 @@
 *********************************************************************************************************
 */
 
-static  void     OS_FlagBlock(OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT16U timeout);
+static  void     OS_FlagBlock(OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT32U timeout);
 static  BOOLEAN  OS_FlagTaskRdy(OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy);
 
 /*$PAGE*/
@@ -557,7 +557,7 @@ void  OSFlagNameSet (OS_FLAG_GRP *pgrp, INT8U *pname, INT8U *perr)
 *********************************************************************************************************
 */
 
-OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U timeout, INT8U *perr)
+OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT32U timeout, INT8U *perr)
 {
     OS_FLAG_NODE  node;
     OS_FLAGS      flags_rdy;
@@ -781,15 +781,19 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (void)
 *                            OS_ERR_FLAG_INVALID_PGRP   You passed a NULL pointer
 *                            OS_ERR_EVENT_TYPE          You are not pointing to an event flag group
 *                            OS_ERR_FLAG_INVALID_OPT    You specified an invalid option
+*                            OS_ERR_INT_Q_FULL          Called from an ISR while OS_INT_Q_SIZE posts are
+*                                                       already pending (OS_ISR_POST_DEFERRED_EN)
 *
-* Returns    : the new value of the event flags bits that are still set.
+* Returns    : the new value of the event flags bits that are still set.  When the post is queued by an
+*              ISR (OS_ISR_POST_DEFERRED_EN), the value of the flags before the post.
 *
 * Called From: Task or ISR
 *
 * WARNING(s) : 1) The execution time of this function depends on the number of tasks waiting on the event
 *                 flag group.
 *              2) The amount of time interrupts are DISABLED depends on the number of tasks waiting on
-*                 the event flag group.
+*                 the event flag group.  With OS_ISR_POST_DEFERRED_EN set to 1 the scheduler is locked
+*                 while the wait list is scanned and interrupts are only disabled for one node at a time.
 *********************************************************************************************************
 */
 OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
@@ -818,6 +822,16 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
         *perr = OS_ERR_EVENT_TYPE;
         return ((OS_FLAGS)0);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                          /* Called from an ISR, let the post task do it    */
+        if ((opt != OS_FLAG_CLR) && (opt != OS_FLAG_SET)) {
+            *perr = OS_ERR_FLAG_INVALID_OPT;
+            return ((OS_FLAGS)0);
+        }
+        *perr = OS_IntQPost(OS_EVENT_TYPE_FLAG, (void *)pgrp, (void *)0, (INT32U)flags, opt);
+        return (pgrp->OSFlagFlags);
+    }
+#endif
 /*$PAGE*/
     OS_ENTER_CRITICAL();
     switch (opt) {
@@ -836,6 +850,9 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
     }
     sched = OS_FALSE;                                /* Indicate that we don't need rescheduling       */
     pnode = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OSLockNesting++;                                 /* ISRs don't change the wait list, lock tasks    */
+#endif
     while (pnode != (OS_FLAG_NODE *)0) {             /* Go through all tasks waiting on event flag(s)  */
         switch (pnode->OSFlagNodeWaitType) {
             case OS_FLAG_WAIT_SET_ALL:               /* See if all req. flags are set for current node */
@@ -880,12 +897,23 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
                  break;
 #endif
             default:
+#if OS_ISR_POST_DEFERRED_EN > 0
+                 OSLockNesting--;
+#endif
                  OS_EXIT_CRITICAL();
                  *perr = OS_ERR_FLAG_WAIT_TYPE;
                  return ((OS_FLAGS)0);
         }
         pnode = (OS_FLAG_NODE *)pnode->OSFlagNodeNext; /* Point to next task waiting for event flag(s) */
+#if OS_ISR_POST_DEFERRED_EN > 0
+        OS_EXIT_CRITICAL();                          /* Service interrupts between two nodes           */
+        OS_ENTER_CRITICAL();
+#endif
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OSLockNesting--;
+    sched = OS_TRUE;                                 /* An ISR may have readied a task during the scan */
+#endif
     OS_EXIT_CRITICAL();
     if (sched == OS_TRUE) {
         OS_Sched();
@@ -985,15 +1013,21 @@ OS_FLAGS  OSFlagQuery (OS_FLAG_GRP *pgrp, INT8U *perr)
 *********************************************************************************************************
 */
 
-static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT16U timeout)
+static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT32U timeout)
 {
     OS_FLAG_NODE  *pnode_next;
+#if (OS_SCHED_RR_EN == 0) && (OS_SCHED_EDF_EN == 0)
     INT8U          y;
+#endif
 
 
     OSTCBCur->OSTCBStat      |= OS_STAT_FLAG;
     OSTCBCur->OSTCBStatPend   = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store timeout in task's TCB                   */
+#else
     OSTCBCur->OSTCBDly        = timeout;              /* Store timeout in task's TCB                   */
+#endif
 #if OS_TASK_DEL_EN > 0
     OSTCBCur->OSTCBFlagNode   = pnode;                /* TCB to link to node                           */
 #endif
@@ -1009,11 +1043,17 @@ static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS fla
     }
     pgrp->OSFlagWaitList = (void *)pnode;
 
+#if OS_SCHED_RR_EN > 0
+    OS_RRTaskUnRdy(OSTCBCur);                         /* Suspend current task until flag(s) received   */
+#elif OS_SCHED_EDF_EN > 0
+    OS_EDFTaskUnRdy(OSTCBCur);                        /* Suspend current task until flag(s) received   */
+#else
     y            =  OSTCBCur->OSTCBY;                 /* Suspend current task until flag(s) received   */
     OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0x00) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
     }
+#endif
 }
 
 /*$PAGE*/
@@ -1105,13 +1145,23 @@ static  BOOLEAN  OS_FlagTaskRdy (OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy)
 
 
     ptcb                 = (OS_TCB *)pnode->OSFlagNodeTCB; /* Point to TCB of waiting task             */
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);
+#else
     ptcb->OSTCBDly       = 0;
+#endif
     ptcb->OSTCBFlagsRdy  = flags_rdy;
-    ptcb->OSTCBStat     &= ~(INT8U)OS_STAT_FLAG;
+    ptcb->OSTCBStat     &= ~(INT16U)OS_STAT_FLAG;
     ptcb->OSTCBStatPend  = OS_STAT_PEND_OK;
     if (ptcb->OSTCBStat == OS_STAT_RDY) {                  /* Task now ready?                          */
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskRdy(ptcb);                                /* Put task into ready list                 */
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskRdy(ptcb);                               /* Put task into ready list                 */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Put task into ready list                 */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         sched                   = OS_TRUE;
     } else {
         sched                   = OS_FALSE;
@@ -100,11 +100,11 @@ OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
         return ((OS_MEM *)0);
     }
     plink = (void **)addr;                            /* Create linked list of free memory blocks      */
-    pblk  = (INT8U *)((INT32U)addr + blksize);
+    pblk  = (INT8U *)addr + blksize;
     for (i = 0; i < (nblks - 1); i++) {
        *plink = (void *)pblk;                         /* Save pointer to NEXT block in CURRENT block   */
         plink = (void **)pblk;                        /* Position to  NEXT      block                  */
-        pblk  = (INT8U *)((INT32U)pblk + blksize);    /* Point to the FOLLOWING block                  */
+        pblk  = pblk + blksize;                       /* Point to the FOLLOWING block                  */
     }
     *plink              = (void *)0;                  /* Last memory block points to NULL              */
     pmem->OSMemAddr     = addr;                       /* Store start address of memory partition       */
@@ -383,6 +383,156 @@ INT8U  OSMemQuery (OS_MEM *pmem, OS_MEM_DATA *p_mem_data)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                     CREATE A POOL OF MESSAGE BLOCKS
+*
+* Description : Create a memory partition of blocks that each hold a message of 'size' bytes and the
+*               OS_MSG_HDR through which OSMsgPut() finds the partition again.  The storage should be
+*               declared as an array of OS_MSG_POOL_SIZE(nmsgs, size) pointers, e.g.
+*
+*                   void    *VelocityStorage[OS_MSG_POOL_SIZE(8, sizeof(INT16S))];
+*                   OS_MEM  *VelocityPool;
+*
+*                   VelocityPool = OSMsgPoolCreate(VelocityStorage, 8, sizeof(INT16S), &err);
+*
+* Arguments   : addr     is the starting address of the storage of the pool
+*
+*               nmsgs    is the number of message blocks to create
+*
+*               size     is the size (in bytes) of the largest message the blocks must hold
+*
+*               perr     is a pointer to a variable that will receive one of the error codes of
+*                        OSMemCreate()
+*
+* Returns    : != (OS_MEM *)0  if the pool was created
+*              == (OS_MEM *)0  if the pool was not created
+*********************************************************************************************************
+*/
+
+#if OS_MEM_MSG_EN > 0
+OS_MEM  *OSMsgPoolCreate (void *addr, INT32U nmsgs, INT32U size, INT8U *perr)
+{
+    OS_MEM      *pmem;
+    OS_MSG_HDR  *phdr;
+    INT32U       blksize;
+    INT32U       i;
+
+
+    blksize = OS_MSG_BLK_SIZE(size);
+    pmem    = OSMemCreate(addr, nmsgs, blksize, perr);
+    if (pmem != (OS_MEM *)0) {
+        phdr = (OS_MSG_HDR *)addr;
+        for (i = 0; i < nmsgs; i++) {                 /* No block is owned yet                         */
+            phdr->OSMsgMem = (OS_MEM *)0;
+            phdr           = (OS_MSG_HDR *)((INT8U *)phdr + blksize);
+        }
+    }
+    return (pmem);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           GET A MESSAGE BLOCK
+*
+* Description : Get a block from a pool created by OSMsgPoolCreate() to send a message without copying it.
+*               The caller owns the block and fills it in, then passes the pointer to another task with
+*               OSMboxPost(), OSQPost(), ...  Ownership goes with the pointer: the task that receives the
+*               message reads it and releases it with OSMsgPut().  If the post fails the block still
+*               belongs to the sender, which must release it.
+*
+*               The call never blocks, so a producer is never held up by its consumers; it fails with
+*               OS_ERR_MEM_NO_FREE_BLKS if they still hold every block of the pool.  OS_MSG_NEW() gets a
+*               block for a message of a given type.
+*
+* Arguments   : pmem    is a pointer to the pool
+*
+*               size    is the size (in bytes) of the message, checked against the size of the blocks
+*
+*               perr    is a pointer to a variable that will receive one of the following error codes:
+*
+*                       OS_ERR_NONE             if a block was allocated
+*                       OS_ERR_MEM_NO_FREE_BLKS if there are no free blocks in the pool
+*                       OS_ERR_MEM_INVALID_PMEM if you passed a NULL pointer for 'pmem'
+*                       OS_ERR_MEM_INVALID_SIZE if the message does not fit in a block of the pool
+*
+* Returns     : A pointer to the message area of the block if no error is detected
+*               A pointer to NULL if an error is detected
+*********************************************************************************************************
+*/
+
+#if OS_MEM_MSG_EN > 0
+void  *OSMsgGet (OS_MEM *pmem, INT32U size, INT8U *perr)
+{
+    OS_MSG_HDR  *phdr;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pmem == (OS_MEM *)0) {                        /* Must point to a valid memory partition        */
+        *perr = OS_ERR_MEM_INVALID_PMEM;
+        return ((void *)0);
+    }
+#endif
+    if (OS_MSG_BLK_SIZE(size) > pmem->OSMemBlkSize) { /* Message must fit in a block of the pool       */
+        *perr = OS_ERR_MEM_INVALID_SIZE;
+        return ((void *)0);
+    }
+    phdr = (OS_MSG_HDR *)OSMemGet(pmem, perr);
+    if (phdr == (OS_MSG_HDR *)0) {
+        return ((void *)0);
+    }
+    phdr->OSMsgMem = pmem;                            /* The caller owns the block                     */
+    return ((void *)(phdr + 1));
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         RELEASE A MESSAGE BLOCK
+*
+* Description : Returns a block obtained from OSMsgGet() to its pool.  This is called by the owner of the
+*               message, normally the task that received it.
+*
+* Arguments   : pmsg    is a pointer to the message, as returned by OSMsgGet()
+*
+* Returns     : OS_ERR_NONE              if the block was returned to its pool
+*               OS_ERR_MEM_INVALID_PBLK  if 'pmsg' is a NULL pointer or, the block was already released
+*               OS_ERR_MEM_FULL          if the pool is already full
+*********************************************************************************************************
+*/
+
+#if OS_MEM_MSG_EN > 0
+INT8U  OSMsgPut (void *pmsg)
+{
+    OS_MSG_HDR  *phdr;
+    OS_MEM      *pmem;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pmsg == (void *)0) {                     /* Must release a valid message                       */
+        return (OS_ERR_MEM_INVALID_PBLK);
+    }
+#endif
+    phdr = (OS_MSG_HDR *)pmsg - 1;
+    OS_ENTER_CRITICAL();
+    pmem           = phdr->OSMsgMem;             /* Take the block from its owner                      */
+    phdr->OSMsgMem = (OS_MEM *)0;
+    OS_EXIT_CRITICAL();
+    if (pmem == (OS_MEM *)0) {                   /* Block was released already                         */
+        return (OS_ERR_MEM_INVALID_PBLK);
+    }
+    return (OSMemPut(pmem, (void *)phdr));
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                    INITIALIZE MEMORY PARTITION MANAGER
 *
 * Description : This function is called by uC/OS-II to initialize the memory partition manager.  Your
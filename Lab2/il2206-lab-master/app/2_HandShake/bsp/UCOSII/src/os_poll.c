@@ -0,0 +1,696 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                               POLL SETS
+*
+* File    : OS_POLL.C
+* Version : V2.86
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_POLL_EN > 0
+/*
+*********************************************************************************************************
+*                                                 NOTES
+*
+* 1) A poll set lets a task wait for any of many semaphores, mailboxes and queues.  Unlike
+*    OSEventPendMulti(), which links the task into the wait list of every event on every call and scans
+*    all of them again when it wakes up, the events are registered with OSPollAdd() once.  A post that
+*    leaves a count or a message in a registered event appends the event to the ready ring of its poll
+*    set and readies the highest priority task waiting on the set, so the cost of a post or a wait does
+*    not depend on the number of events in the set.
+*
+* 2) The ready ring is a circular list through OSEventPollNext, OSEventPtr of the poll set points to its
+*    last entry and OSEventCnt holds the number of entries.  An event stays in the ring as long as it has
+*    a count or a message: OSPollPend() reports it again until the task has taken everything with
+*    OSSemAccept(), OSMboxAccept() or OSQAccept().  Events found empty are unlinked as the ring is walked,
+*    and the ring is rotated past the events reported so that a busy event cannot hide the others.
+*
+* 3) An event is in at most one poll set.  Tasks may still pend on the event itself; a post they receive
+*    directly never makes the event ready in its poll set.
+*
+* 4) Each post readies at most one task waiting on the poll set.  A poll set is meant to be waited on by
+*    a single task.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_PollEventRdy (OS_EVENT *pevent);
+static  INT16U   OS_PollGet      (OS_EVENT *ppoll, OS_EVENT **pevents_rdy, INT16U n);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      CHECK A POLL SET WITHOUT WAITING
+*
+* Description: This function returns the events of a poll set that have a count or a message, without
+*              waiting.  Unlike OSPollPend(), it may be called from an ISR.
+*
+* Arguments  : ppoll         is a pointer to the poll set.
+*
+*              pevents_rdy   is a pointer to an array of at least 'n' entries, where the events that are
+*                            ready are stored.
+*
+*              n             is the maximum number of events to return.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful, even if no event was ready
+*                            OS_ERR_EVENT_TYPE   'ppoll' is not pointing to a poll set
+*                            OS_ERR_PEVENT_NULL  'ppoll' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   'pevents_rdy' is a NULL pointer
+*
+* Returns    : The number of events stored in 'pevents_rdy[]', 0 if no event is ready.
+*********************************************************************************************************
+*/
+
+INT16U  OSPollAccept (OS_EVENT *ppoll, OS_EVENT **pevents_rdy, INT16U n, INT8U *perr)
+{
+    INT16U     nrdy;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (0);
+    }
+    if (ppoll == (OS_EVENT *)0) {                          /* Validate 'ppoll'                         */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pevents_rdy == (OS_EVENT **)0) {                   /* Validate 'pevents_rdy'                   */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (ppoll->OSEventType != OS_EVENT_TYPE_POLL) {        /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    nrdy  = OS_PollGet(ppoll, pevents_rdy, n);
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (nrdy);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       ADD AN EVENT TO A POLL SET
+*
+* Description: This function registers a semaphore, a mailbox or a queue with a poll set.  If the event
+*              already has a count or a message, it is ready in the poll set immediately.
+*
+* Arguments  : ppoll         is a pointer to the poll set.
+*
+*              pevent        is a pointer to the semaphore, mailbox or queue to add.
+*
+* Returns    : OS_ERR_NONE             The call was successful
+*              OS_ERR_PEVENT_NULL      'ppoll' or 'pevent' is a NULL pointer
+*              OS_ERR_EVENT_TYPE       'ppoll' is not pointing to a poll set, or 'pevent' is not pointing
+*                                      to a semaphore, a mailbox or a queue
+*              OS_ERR_POLL_IN_SET      'pevent' is already in a poll set
+*********************************************************************************************************
+*/
+
+INT8U  OSPollAdd (OS_EVENT *ppoll, OS_EVENT *pevent)
+{
+    BOOLEAN    sched;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (ppoll == (OS_EVENT *)0) {                          /* Validate 'ppoll'                         */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (ppoll->OSEventType != OS_EVENT_TYPE_POLL) {        /* Validate event block types               */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    switch (pevent->OSEventType) {
+#if OS_SEM_EN > 0
+        case OS_EVENT_TYPE_SEM:
+#endif
+#if OS_MBOX_EN > 0
+        case OS_EVENT_TYPE_MBOX:
+#endif
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+        case OS_EVENT_TYPE_Q:
+#endif
+             break;
+
+        default:
+             return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventPoll != (OS_EVENT *)0) {            /* An event can only be in one poll set     */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_POLL_IN_SET);
+    }
+    pevent->OSEventPoll     = ppoll;
+    pevent->OSEventPollNext = (OS_EVENT *)0;
+    sched                   = OS_FALSE;
+    if (OS_PollEventRdy(pevent) == OS_TRUE) {              /* Already posted to, make it ready         */
+        sched = OS_PollSignal(pevent);
+    }
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                        /* Find highest priority task ready to run  */
+    }
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           CREATE A POLL SET
+*
+* Description: This function creates an empty poll set.
+*
+* Arguments  : none
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block (OS_EVENT) of the poll set.
+*              == (OS_EVENT *)0  if no event control blocks were available or if called from an ISR.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSPollCreate (void)
+{
+    OS_EVENT  *ppoll;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        return ((OS_EVENT *)0);                            /* ... can't CREATE from an ISR             */
+    }
+    OS_ENTER_CRITICAL();
+    ppoll = OSEventFreeList;                               /* Get next free event control block        */
+    if (OSEventFreeList != (OS_EVENT *)0) {                /* See if pool of free ECB pool was empty   */
+        OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (ppoll != (OS_EVENT *)0) {                          /* Get an event control block               */
+        ppoll->OSEventType     = OS_EVENT_TYPE_POLL;
+        ppoll->OSEventCnt      = 0;                        /* Ready ring is empty                      */
+        ppoll->OSEventPtr      = (void *)0;
+        ppoll->OSEventPoll     = (OS_EVENT *)0;            /* A poll set is not in a poll set itself   */
+        ppoll->OSEventPollNext = (OS_EVENT *)0;
+#if OS_EVENT_NAME_SIZE > 1
+        ppoll->OSEventName[0]  = '?';                      /* Unknown name                             */
+        ppoll->OSEventName[1]  = OS_ASCII_NUL;
+#endif
+        OS_EventWaitListInit(ppoll);                       /* Initialize to 'nobody waiting'           */
+    }
+    return (ppoll);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           DELETE A POLL SET
+*
+* Description: This function removes all events from a poll set and deletes it.
+*
+* Arguments  : ppoll         is a pointer to the poll set.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the poll set ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the poll set even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied
+*                                                    and OSPollPend() returns OS_ERR_PEND_ABORT.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the poll set was deleted
+*                            OS_ERR_DEL_ISR          If you attempted to delete the poll set from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the poll set
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a poll set
+*                            OS_ERR_PEVENT_NULL      If 'ppoll' is a NULL pointer.
+*
+* Returns    : ppoll         upon error
+*              (OS_EVENT *)0 if the poll set was successfully deleted.
+*
+* Note(s)    : 1) The events that were in the poll set are not deleted, they can be added to another one.
+*              2) This call disables interrupts for a time proportional to OS_MAX_EVENTS, because the
+*                 poll set does not keep a list of its events.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSPollDel (OS_EVENT *ppoll, INT8U opt, INT8U *perr)
+{
+    BOOLEAN    tasks_waiting;
+    OS_EVENT  *pevent;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (ppoll);
+    }
+    if (ppoll == (OS_EVENT *)0) {                          /* Validate 'ppoll'                         */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (ppoll);
+    }
+#endif
+    if (ppoll->OSEventType != OS_EVENT_TYPE_POLL) {        /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (ppoll);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (ppoll);
+    }
+    OS_ENTER_CRITICAL();
+    if (ppoll->OSEventGrp != 0) {                          /* See if any tasks waiting on poll set     */
+        tasks_waiting = OS_TRUE;                           /* Yes                                      */
+    } else {
+        tasks_waiting = OS_FALSE;                          /* No                                       */
+    }
+    switch (opt) {
+        case OS_DEL_NO_PEND:                               /* Delete poll set only if no task waiting  */
+             if (tasks_waiting == OS_TRUE) {
+                 OS_EXIT_CRITICAL();
+                 *perr = OS_ERR_TASK_WAITING;
+                 return (ppoll);
+             }
+             break;
+
+        case OS_DEL_ALWAYS:                                /* Always delete the poll set               */
+             while (ppoll->OSEventGrp != 0) {              /* Ready ALL tasks waiting for poll set     */
+                 (void)OS_EventTaskRdy(ppoll, (void *)0, OS_STAT_POLL, OS_STAT_PEND_ABORT);
+             }
+             break;
+
+        default:
+             OS_EXIT_CRITICAL();
+             *perr = OS_ERR_INVALID_OPT;
+             return (ppoll);
+    }
+    pevent = &OSEventTbl[0];
+    for (i = 0; i < OS_MAX_EVENTS; i++) {                  /* Take all events out of the poll set      */
+        if (pevent->OSEventPoll == ppoll) {
+            pevent->OSEventPoll     = (OS_EVENT *)0;
+            pevent->OSEventPollNext = (OS_EVENT *)0;
+        }
+        pevent++;
+    }
+#if OS_EVENT_NAME_SIZE > 1
+    ppoll->OSEventName[0] = '?';                           /* Unknown name                             */
+    ppoll->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    ppoll->OSEventType    = OS_EVENT_TYPE_UNUSED;
+    ppoll->OSEventPtr     = OSEventFreeList;               /* Return Event Control Block to free list  */
+    ppoll->OSEventCnt     = 0;
+    OSEventFreeList       = ppoll;                         /* Get next free event control block        */
+    OS_EXIT_CRITICAL();
+    if (tasks_waiting == OS_TRUE) {                        /* Reschedule only if task(s) were waiting  */
+        OS_Sched();                                        /* Find highest priority task ready to run  */
+    }
+    *perr = OS_ERR_NONE;
+    return ((OS_EVENT *)0);                                /* Poll set has been deleted                */
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           PEND ON A POLL SET
+*
+* Description: This function waits until at least one event of a poll set has a count or a message, and
+*              returns the events that do.  The task then takes the counts or messages with
+*              OSSemAccept(), OSMboxAccept() or OSQAccept().
+*
+* Arguments  : ppoll         is a pointer to the poll set.
+*
+*              pevents_rdy   is a pointer to an array of at least 'n' entries, where the events that are
+*                            ready are stored.
+*
+*              n             is the maximum number of events to return, at least 1.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for an event up to the amount of time specified by this argument.  If
+*                            you specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         At least one event is ready
+*                            OS_ERR_TIMEOUT      No event was ready within the specified 'timeout'
+*                            OS_ERR_PEND_ABORT   The poll set was deleted while the task was waiting
+*                            OS_ERR_EVENT_TYPE   'ppoll' is not pointing to a poll set
+*                            OS_ERR_PEVENT_NULL  'ppoll' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   'pevents_rdy' is a NULL pointer or 'n' is 0
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler locked
+*
+* Returns    : The number of events stored in 'pevents_rdy[]', 0 on an error.
+*
+* Note(s)    : 1) A higher priority task may take the count or message that woke up the task before it
+*                 runs.  The task then finds no event ready and waits again, for what is left of
+*                 'timeout'.
+*********************************************************************************************************
+*/
+
+INT16U  OSPollPend (OS_EVENT *ppoll, OS_EVENT **pevents_rdy, INT16U n, INT32U timeout, INT8U *perr)
+{
+    INT16U     nrdy;
+    INT8U      pend_stat;
+    INT64U     expiry;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (0);
+    }
+    if (ppoll == (OS_EVENT *)0) {                          /* Validate 'ppoll'                         */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if ((pevents_rdy == (OS_EVENT **)0) || (n == 0)) {     /* Validate 'pevents_rdy' and 'n'           */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (ppoll->OSEventType != OS_EVENT_TYPE_POLL) {        /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                               /* See if called with scheduler locked ...  */
+        *perr = OS_ERR_PEND_LOCKED;                        /* ... can't PEND when locked               */
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    expiry = OSTickCtr + timeout;                          /* Tick at which the wait times out         */
+    nrdy   = OS_PollGet(ppoll, pevents_rdy, n);
+    while (nrdy == 0) {                                    /* Wait until an event is ready             */
+        if (timeout > 0) {                                 /* Wait for what is left of the timeout     */
+            if (expiry <= OSTickCtr) {
+                OS_EXIT_CRITICAL();
+                *perr = OS_ERR_TIMEOUT;
+                return (0);
+            }
+            timeout = (INT32U)(expiry - OSTickCtr);
+        }
+        OSTCBCur->OSTCBStat     |= OS_STAT_POLL;
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur, timeout);              /* Load timeout into TCB                    */
+#else
+        OSTCBCur->OSTCBDly       = timeout;                /* Load timeout into TCB                    */
+#endif
+        OS_EventTaskWait(ppoll);                           /* Suspend task until event or timeout      */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* Find next highest priority task ready    */
+        OS_ENTER_CRITICAL();
+        pend_stat = OSTCBCur->OSTCBStatPend;
+        if (pend_stat == OS_STAT_PEND_TO) {
+            OS_EventTaskRemove(OSTCBCur, ppoll);
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;       /* Set   task  status to ready              */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;   /* Clear pend  status                       */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;     /* Clear event pointers                     */
+#if (OS_EVENT_MULTI_EN > 0)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+        OSTCBCur->OSTCBMsg           = (void      *)0;
+        if (pend_stat == OS_STAT_PEND_ABORT) {             /* Poll set was deleted                     */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_PEND_ABORT;
+            return (0);
+        }
+        if (pend_stat == OS_STAT_PEND_TO) {                /* No event was ready within the timeout    */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_TIMEOUT;
+            return (0);
+        }
+        nrdy = OS_PollGet(ppoll, pevents_rdy, n);
+    }
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (nrdy);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     REMOVE AN EVENT FROM A POLL SET
+*
+* Description: This function takes a semaphore, a mailbox or a queue out of its poll set.
+*
+* Arguments  : ppoll         is a pointer to the poll set.
+*
+*              pevent        is a pointer to the event to remove.
+*
+* Returns    : OS_ERR_NONE             The call was successful
+*              OS_ERR_PEVENT_NULL      'ppoll' or 'pevent' is a NULL pointer
+*              OS_ERR_EVENT_TYPE       'ppoll' is not pointing to a poll set
+*              OS_ERR_POLL_NOT_IN_SET  'pevent' is not in the poll set
+*
+* Note(s)    : Deleting a semaphore, a mailbox or a queue removes it from its poll set.
+*********************************************************************************************************
+*/
+
+INT8U  OSPollRemove (OS_EVENT *ppoll, OS_EVENT *pevent)
+{
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (ppoll == (OS_EVENT *)0) {                          /* Validate 'ppoll'                         */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (ppoll->OSEventType != OS_EVENT_TYPE_POLL) {        /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventPoll != ppoll) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_POLL_NOT_IN_SET);
+    }
+    OS_PollRemove(pevent);
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CHECK WHETHER AN EVENT IS READY
+*
+* Description: This function determines whether a semaphore has a count, a mailbox a message or a queue
+*              at least one message.
+*
+* Arguments  : pevent        is a pointer to the event.
+*
+* Returns    : OS_TRUE       if the event has a count or a message
+*              OS_FALSE      otherwise
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_PollEventRdy (OS_EVENT *pevent)
+{
+    switch (pevent->OSEventType) {
+#if OS_SEM_EN > 0
+        case OS_EVENT_TYPE_SEM:
+             return ((BOOLEAN)(pevent->OSEventCnt > 0));
+#endif
+
+#if OS_MBOX_EN > 0
+        case OS_EVENT_TYPE_MBOX:
+             return ((BOOLEAN)(pevent->OSEventPtr != (void *)0));
+#endif
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+        case OS_EVENT_TYPE_Q:
+             return ((BOOLEAN)(((OS_Q *)pevent->OSEventPtr)->OSQEntries > 0));
+#endif
+
+        default:
+             return (OS_FALSE);
+    }
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     GET THE READY EVENTS OF A POLL SET
+*
+* Description: This function walks the ready ring of a poll set from its first entry.  Events that still
+*              have a count or a message are stored in 'pevents_rdy[]', the others are unlinked.  The ring
+*              is then rotated so that the first event not visited becomes its first entry.
+*
+* Arguments  : ppoll         is a pointer to the poll set.
+*
+*              pevents_rdy   is a pointer to where the ready events are stored.
+*
+*              n             is the maximum number of events to store.
+*
+* Returns    : The number of events stored in 'pevents_rdy[]'.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_PollGet (OS_EVENT *ppoll, OS_EVENT **pevents_rdy, INT16U n)
+{
+    OS_EVENT  *pprev;
+    OS_EVENT  *pevent;
+    INT16U     nvisit;
+    INT16U     nrdy;
+
+
+    nrdy   = 0;
+    nvisit = ppoll->OSEventCnt;                            /* Visit every entry at most once           */
+    pprev  = (OS_EVENT *)ppoll->OSEventPtr;                /* Last entry, the one before the first     */
+    while ((nvisit > 0) && (nrdy < n)) {
+        pevent = pprev->OSEventPollNext;
+        if (OS_PollEventRdy(pevent) == OS_TRUE) {          /* Still ready, report it and keep it       */
+            pevents_rdy[nrdy++] = pevent;
+            pprev               = pevent;
+        } else {                                           /* Taken since it was posted, unlink it     */
+            pprev->OSEventPollNext  = pevent->OSEventPollNext;
+            pevent->OSEventPollNext = (OS_EVENT *)0;
+            ppoll->OSEventCnt--;
+        }
+        nvisit--;
+    }
+    if (ppoll->OSEventCnt == 0) {
+        ppoll->OSEventPtr = (void *)0;                     /* Ready ring is empty                      */
+    } else {
+        ppoll->OSEventPtr = (void *)pprev;                 /* Events reported go to the end            */
+    }
+    return (nrdy);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     TAKE AN EVENT OUT OF ITS POLL SET
+*
+* Description: This function is called by OSPollRemove() and by the functions that delete a semaphore,
+*              a mailbox or a queue, to take the event out of its poll set.
+*
+* Arguments  : pevent        is a pointer to the event, which may not be in a poll set.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The ready ring is walked to find the entry before the event.
+*********************************************************************************************************
+*/
+
+void  OS_PollRemove (OS_EVENT *pevent)
+{
+    OS_EVENT  *ppoll;
+    OS_EVENT  *pprev;
+
+
+    ppoll = pevent->OSEventPoll;
+    if (ppoll == (OS_EVENT *)0) {                          /* Event is not in a poll set               */
+        return;
+    }
+    if (pevent->OSEventPollNext != (OS_EVENT *)0) {        /* Unlink the event from the ready ring     */
+        pprev = pevent;
+        while (pprev->OSEventPollNext != pevent) {
+            pprev = pprev->OSEventPollNext;
+        }
+        if (pprev == pevent) {                             /* It was the only entry                    */
+            ppoll->OSEventPtr      = (void *)0;
+        } else {
+            pprev->OSEventPollNext = pevent->OSEventPollNext;
+            if (ppoll->OSEventPtr == (void *)pevent) {     /* It was the last entry                    */
+                ppoll->OSEventPtr  = (void *)pprev;
+            }
+        }
+        ppoll->OSEventCnt--;
+    }
+    pevent->OSEventPoll     = (OS_EVENT *)0;
+    pevent->OSEventPollNext = (OS_EVENT *)0;
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   MAKE AN EVENT READY IN ITS POLL SET
+*
+* Description: This function is called by the functions that post to a semaphore, a mailbox or a queue
+*              when the count or the message stays in the event.  The event is appended to the ready
+*              ring of its poll set, unless it is already in it, and the highest priority task waiting
+*              on the poll set is readied.
+*
+* Arguments  : pevent        is a pointer to the event, which may not be in a poll set.
+*
+* Returns    : OS_TRUE       if a task was readied, the caller must then call OS_Sched()
+*              OS_FALSE      otherwise
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OS_PollSignal (OS_EVENT *pevent)
+{
+    OS_EVENT  *ppoll;
+    OS_EVENT  *plast;
+
+
+    ppoll = pevent->OSEventPoll;
+    if (ppoll == (OS_EVENT *)0) {                          /* Event is not in a poll set               */
+        return (OS_FALSE);
+    }
+    if (pevent->OSEventPollNext == (OS_EVENT *)0) {        /* Append the event to the ready ring       */
+        plast = (OS_EVENT *)ppoll->OSEventPtr;
+        if (plast == (OS_EVENT *)0) {
+            pevent->OSEventPollNext = pevent;
+        } else {
+            pevent->OSEventPollNext = plast->OSEventPollNext;
+            plast->OSEventPollNext  = pevent;
+        }
+        ppoll->OSEventPtr = (void *)pevent;
+        ppoll->OSEventCnt++;
+    }
+    if (ppoll->OSEventGrp != 0) {                          /* Ready HPT waiting on the poll set        */
+        (void)OS_EventTaskRdy(ppoll, (void *)pevent, OS_STAT_POLL, OS_STAT_PEND_OK);
+        return (OS_TRUE);
+    }
+    return (OS_FALSE);
+}
+#endif
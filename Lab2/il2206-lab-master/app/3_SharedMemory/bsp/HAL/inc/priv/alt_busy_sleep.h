@@ -24,12 +24,37 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "alt_types.h"
+
 /*
  * The function alt_busy_sleep provides a busy loop implementation of usleep.
  * This is used to provide usleep for the standalone HAL, or when the timer is
- * unavailable in uC/OS-II.
+ * unavailable in uC/OS-II. It spins on the timestamp timer once that has
+ * been calibrated, and on a busy loop otherwise.
  */ 
 
 extern unsigned int alt_busy_sleep (unsigned int us);
 
+/*
+ * alt_busy_sleep_calibrate() is called by the timestamp driver once the
+ * timestamp timer is running free. It measures the busy loop and the cost of
+ * reading the timer, with interrupts disabled, and switches alt_busy_sleep()
+ * over to the timer. Without a timestamp timer it does nothing, and the
+ * speed of the busy loop is estimated from the CPU frequency.
+ */
+
+extern void alt_busy_sleep_calibrate (void);
+
+/*
+ * alt_busy_sleep_timed() returns non zero if alt_busy_sleep() counts on the
+ * timestamp timer. alt_busy_sleep_stamp() then returns the timer, and
+ * alt_busy_sleep_elapsed() the number of microseconds since "stamp" was
+ * taken; both return zero otherwise. An interval must be shorter than one
+ * period of the 32 bit counter, about 85 seconds at 50 MHz.
+ */
+
+extern int     alt_busy_sleep_timed (void);
+extern alt_u32 alt_busy_sleep_stamp (void);
+extern alt_u32 alt_busy_sleep_elapsed (alt_u32 stamp);
+
 #endif /* __ALT_BUSY_SLEEP_H */
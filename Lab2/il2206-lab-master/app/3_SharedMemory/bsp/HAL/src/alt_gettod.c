@@ -76,7 +76,7 @@ int ALT_GETTIMEOFDAY (struct timeval  *ptimeval, struct timezone *ptimezone)
 {
 #endif
   
-  alt_u32 nticks = alt_nticks (); 
+  alt_u64 nticks = alt_nticks64 (); 
   alt_u32 tick_rate = alt_ticks_per_second ();
 
   /* 
@@ -88,9 +88,9 @@ int ALT_GETTIMEOFDAY (struct timeval  *ptimeval, struct timezone *ptimezone)
 
   if (tick_rate)
   {
-    ptimeval->tv_sec  = alt_resettime.tv_sec  + nticks/tick_rate;
+    ptimeval->tv_sec  = alt_resettime.tv_sec  + (time_t)(nticks/tick_rate);
     ptimeval->tv_usec = alt_resettime.tv_usec +
-     (alt_u32)(((alt_u64)nticks*(ALT_US/tick_rate))%ALT_US);
+     (alt_u32)((nticks%tick_rate)*(ALT_US/tick_rate));
       
     while(ptimeval->tv_usec < 0) {
       if (ptimeval->tv_sec <= 0)
@@ -60,6 +60,8 @@ unsigned int ALT_USLEEP (unsigned int us)
 {
   alt_u32 ticks;
   alt_u32 tick_rate;
+  alt_u32 stamp;
+  alt_u32 elapsed;
 
   /* 
    * If the O/S hasn't started yet, then we delay using a busy loop, rather than
@@ -72,26 +74,52 @@ unsigned int ALT_USLEEP (unsigned int us)
     return alt_busy_sleep (us);
   }
 
+  tick_rate = alt_ticks_per_second ();
+
+  /*
+   * With a calibrated timestamp timer, the whole ticks are spent in
+   * OSTimeDly() and only the remainder in the busy loop, which then ends on
+   * time. The first tick of a delay may come anywhere within one tick
+   * period, so each delay is measured and the task delays again for the
+   * whole ticks that are left; after waking on a tick that second delay is
+   * exact. A delay is at most one second, so that it can be measured on the
+   * 32 bit timer.
+   */
+
+  if (alt_busy_sleep_timed ())
+  {
+    while (us >= ALT_US / tick_rate)
+    {
+      ticks = us / (ALT_US / tick_rate);
+      if (ticks > tick_rate)
+      {
+        ticks = tick_rate;
+      }
+      stamp = alt_busy_sleep_stamp ();
+      OSTimeDly (ticks);
+      elapsed = alt_busy_sleep_elapsed (stamp);
+      if (!elapsed)
+      {
+        /* The timer has been stopped, count the ticks instead */
+        elapsed = ticks * (ALT_US / tick_rate);
+      }
+      us      = (elapsed < us) ? us - elapsed : 0;
+    }
+    return alt_busy_sleep (us);
+  }
+
   /* 
    * Calculate the number of whole system clock ticks to delay.
    */
 
-  tick_rate = alt_ticks_per_second ();
   ticks     = (us/ALT_US)* tick_rate + ((us%ALT_US)*tick_rate)/ALT_US;
 
   /*
-   * OSTimeDly can only delay for a maximum of 0xffff ticks, so if the requested
-   * delay is greater than that, we need to break it down into a number of
-   * seperate delays.
+   * OSTimeDly takes a 32 bit number of ticks, which holds the longest delay
+   * that fits in "us", so a single call is enough.
    */
 
-  while (ticks > 0xffff)
-  {
-    OSTimeDly(0xffff);
-    ticks -= 0xffff;
-  }
-
-  OSTimeDly ((INT16U) (ticks));
+  OSTimeDly (ticks);
 
   /*
    * Now delay by the remainder using a busy loop. This is here in order to
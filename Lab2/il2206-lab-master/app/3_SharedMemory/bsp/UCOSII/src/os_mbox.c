@@ -189,6 +189,9 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
     switch (opt) {
         case OS_DEL_NO_PEND:                               /* Delete mailbox only if no task waiting   */
              if (tasks_waiting == OS_FALSE) {
+#if OS_POLL_EN > 0
+                 OS_PollRemove(pevent);                    /* Take mailbox out of its poll set         */
+#endif
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
@@ -211,6 +214,9 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for mailbox      */
                  (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MBOX, OS_STAT_PEND_OK);
              }
+#if OS_POLL_EN > 0
+             OS_PollRemove(pevent);                        /* Take mailbox out of its poll set         */
+#endif
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
@@ -271,7 +277,7 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *********************************************************************************************************
 */
 /*$PAGE*/
-void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+void  *OSMboxPend (OS_EVENT *pevent, INT32U timeout, INT8U *perr)
 {
     void      *pmsg;
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
@@ -311,7 +317,11 @@ void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_MBOX;          /* Message not available, task will pend         */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur, timeout);             /* Load timeout in TCB                           */
+#else
     OSTCBCur->OSTCBDly       = timeout;               /* Load timeout in TCB                           */
+#endif
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready to run  */
@@ -446,6 +456,8 @@ INT8U  OSMboxPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *              OS_ERR_EVENT_TYPE    If you are attempting to post to a non mailbox.
 *              OS_ERR_PEVENT_NULL   If 'pevent' is a NULL pointer
 *              OS_ERR_POST_NULL_PTR If you are attempting to post a NULL pointer
+*              OS_ERR_INT_Q_FULL    If called from an ISR while OS_INT_Q_SIZE posts are already pending
+*                                   (OS_ISR_POST_DEFERRED_EN).  The message is not sent.
 *
 * Note(s)    : 1) HPT means Highest Priority Task
 *********************************************************************************************************
@@ -471,6 +483,11 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
     if (pevent->OSEventType != OS_EVENT_TYPE_MBOX) {  /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Called from an ISR, let the post task do it   */
+        return (OS_IntQPost(OS_EVENT_TYPE_MBOX, (void *)pevent, pmsg, 0, OS_POST_OPT_NONE));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
                                                       /* Ready HPT waiting on event                    */
@@ -484,6 +501,13 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if OS_POLL_EN > 0
+    if (OS_PollSignal(pevent) == OS_TRUE) {           /* Ready the task waiting on the poll set        */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -514,11 +538,15 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
 *              OS_ERR_EVENT_TYPE    If you are attempting to post to a non mailbox.
 *              OS_ERR_PEVENT_NULL   If 'pevent' is a NULL pointer
 *              OS_ERR_POST_NULL_PTR If you are attempting to post a NULL pointer
+*              OS_ERR_INT_Q_FULL    If called from an ISR while OS_INT_Q_SIZE posts are already pending
+*                                   (OS_ISR_POST_DEFERRED_EN).  The message is not sent.
 *
 * Note(s)    : 1) HPT means Highest Priority Task
 *
 * Warning    : Interrupts can be disabled for a long time if you do a 'broadcast'.  In fact, the
 *              interrupt disable time is proportional to the number of tasks waiting on the mailbox.
+*              With OS_ISR_POST_DEFERRED_EN set to 1 the scheduler is locked instead and interrupts are
+*              only disabled while one task is made ready.
 *********************************************************************************************************
 */
 
@@ -542,12 +570,27 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
     if (pevent->OSEventType != OS_EVENT_TYPE_MBOX) {  /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Called from an ISR, let the post task do it   */
+        return (OS_IntQPost(OS_EVENT_TYPE_MBOX, (void *)pevent, pmsg, 0, opt));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00) {  /* Do we need to post msg to ALL waiting tasks ? */
+#if OS_ISR_POST_DEFERRED_EN > 0
+            OSLockNesting++;                          /* ISRs don't change the wait list, lock tasks   */
+#endif
             while (pevent->OSEventGrp != 0) {         /* Yes, Post to ALL tasks waiting on mailbox     */
                 (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_MBOX, OS_STAT_PEND_OK);
+#if OS_ISR_POST_DEFERRED_EN > 0
+                OS_EXIT_CRITICAL();                   /* Service interrupts between two tasks          */
+                OS_ENTER_CRITICAL();
+#endif
             }
+#if OS_ISR_POST_DEFERRED_EN > 0
+            OSLockNesting--;
+#endif
         } else {                                      /* No,  Post to HPT waiting on mbox              */
             (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_MBOX, OS_STAT_PEND_OK);
         }
@@ -562,6 +605,13 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if OS_POLL_EN > 0
+    if (OS_PollSignal(pevent) == OS_TRUE) {           /* Ready the task waiting on the poll set        */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -590,7 +640,10 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
 INT8U  OSMboxQuery (OS_EVENT *pevent, OS_MBOX_DATA *p_mbox_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U    *psrc;
+    INT32U    *pdest;
+#elif OS_LOWEST_PRIO <= 63
     INT8U     *psrc;
     INT8U     *pdest;
 #else
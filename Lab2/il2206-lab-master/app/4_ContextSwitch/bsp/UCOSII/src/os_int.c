@@ -0,0 +1,325 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                          DEFERRED ISR POSTS
+*
+* File    : OS_INT.C
+* Version : V2.86
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+/*
+*********************************************************************************************************
+*                                                 NOTES
+*
+* 1) When OS_ISR_POST_DEFERRED_EN is set to 1, OSSemPost(), OSMboxPost(), OSMboxPostOpt(), OSQPost(),
+*    OSQPostFront(), OSQPostOpt() and OSFlagPost() do not touch the object when they are called from an
+*    ISR.  The post is copied into OSIntQTbl[] and the post task performs it once the ISR returns, with
+*    the scheduler locked instead of interrupts disabled.
+*
+* 2) Interrupts are only disabled while a post is added to or removed from OSIntQTbl[].  Because no ISR
+*    changes event wait lists or flag groups any more, OSFlagPost() and the broadcast option of
+*    OSMboxPostOpt() and OSQPostOpt() also re-enable interrupts between two waiting tasks.  The time
+*    interrupts are disabled therefore no longer depends on the number of tasks waiting on an object.
+*
+* 3) OS_TASK_INT_Q_PRIO is reserved for the post task.  It should be higher than the priority of any task
+*    pending on an object that ISRs post to, or the post is delayed until that task blocks.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_IntQRePost (OS_INT_Q *ppost);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    INITIALIZE THE DEFERRED POST QUEUE
+*
+* Description: This function is called by OSInit() to empty the queue of ISR posts and create the task
+*              that performs them.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_IntQInit (void)
+{
+#if OS_TASK_NAME_SIZE > 7
+    INT8U  err;
+#endif
+
+
+    OSIntQIn         = &OSIntQTbl[0];
+    OSIntQOut        = &OSIntQTbl[0];
+    OSIntQEntries    = 0;
+    OSIntQEntriesMax = 0;
+    OSIntQOvfCtr     = 0;
+    OSIntQTaskRdy    = OS_TRUE;                                    /* Post task is ready when created     */
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreateExt(OS_IntQTask,
+                          (void *)0,                                       /* No arguments passed to OS_IntQTask()   */
+                          &OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE - 1],      /* Set Top-Of-Stack                       */
+                          OS_TASK_INT_Q_PRIO,
+                          OS_TASK_INT_Q_ID,
+                          &OSIntQTaskStk[0],                               /* Set Bottom-Of-Stack                    */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                       /* No TCB extension                       */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack    */
+    #else
+    (void)OSTaskCreateExt(OS_IntQTask,
+                          (void *)0,                                       /* No arguments passed to OS_IntQTask()   */
+                          &OSIntQTaskStk[0],                               /* Set Top-Of-Stack                       */
+                          OS_TASK_INT_Q_PRIO,
+                          OS_TASK_INT_Q_ID,
+                          &OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE - 1],      /* Set Bottom-Of-Stack                    */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                       /* No TCB extension                       */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack    */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreate(OS_IntQTask,
+                       (void *)0,
+                       &OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE - 1],
+                       OS_TASK_INT_Q_PRIO);
+    #else
+    (void)OSTaskCreate(OS_IntQTask,
+                       (void *)0,
+                       &OSIntQTaskStk[0],
+                       OS_TASK_INT_Q_PRIO);
+    #endif
+#endif
+
+#if OS_TASK_NAME_SIZE > 13
+    OSTaskNameSet(OS_TASK_INT_Q_PRIO, (INT8U *)"uC/OS-II IntQ", &err);
+#else
+#if OS_TASK_NAME_SIZE > 7
+    OSTaskNameSet(OS_TASK_INT_Q_PRIO, (INT8U *)"OS-IntQ", &err);
+#endif
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          QUEUE A POST FROM AN ISR
+*
+* Description: This function is called by the post services when they are invoked from an ISR.  The post
+*              is copied into the queue and the post task is made ready to run; OSIntExit() switches to
+*              it once the last nested ISR completes.
+*
+* Arguments  : type          is the type of object posted to (OS_EVENT_TYPE_SEM, OS_EVENT_TYPE_MBOX,
+*                            OS_EVENT_TYPE_Q, OS_EVENT_TYPE_FLAG or OS_EVENT_TYPE_STATE).
+*
+*              pobj          is a pointer to the event control block or to the event flag group.
+*
+*              pmsg          is the message posted to a mailbox or queue.
+*
+*              flags         are the flags posted to an event flag group.
+*
+*              opt           is the post option (OS_POST_OPT_xxx, or OS_FLAG_SET/OS_FLAG_CLR).
+*
+* Returns    : OS_ERR_NONE          The post was queued.
+*              OS_ERR_INT_Q_FULL    OS_INT_Q_SIZE posts are already pending, the post is lost.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Errors the post itself returns when it is performed (e.g. OS_ERR_Q_FULL) are not
+*                 reported to the ISR.
+*********************************************************************************************************
+*/
+
+INT8U  OS_IntQPost (INT8U type, void *pobj, void *pmsg, INT32U flags, INT8U opt)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                        /* Allocate storage for CPU status reg.*/
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (OSIntQEntries >= OS_INT_Q_SIZE) {                          /* Make sure the queue is not full     */
+        OSIntQOvfCtr++;
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_INT_Q_FULL);
+    }
+    OSIntQIn->OSIntQObj   = pobj;                                  /* Insert the post                     */
+    OSIntQIn->OSIntQMsg   = pmsg;
+    OSIntQIn->OSIntQFlags = flags;
+    OSIntQIn->OSIntQType  = type;
+    OSIntQIn->OSIntQOpt   = opt;
+    OSIntQIn++;
+    if (OSIntQIn == &OSIntQTbl[OS_INT_Q_SIZE]) {                   /* Wrap IN pointer if at end of queue  */
+        OSIntQIn = &OSIntQTbl[0];
+    }
+    OSIntQEntries++;
+    if (OSIntQEntriesMax < OSIntQEntries) {
+        OSIntQEntriesMax = OSIntQEntries;
+    }
+    if (OSIntQTaskRdy == OS_FALSE) {                               /* Wake up the post task               */
+        OSIntQTaskRdy = OS_TRUE;
+        ptcb          = OSTCBPrioTbl[OS_TASK_INT_Q_PRIO];
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskRdy(ptcb);
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskRdy(ptcb);
+#else
+        OSRdyGrp               |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                               POST TASK
+*
+* Description: This task performs the posts queued by ISRs, oldest first.  The scheduler stays locked
+*              until the queue is empty so the tasks readied by the posts run afterwards, in priority
+*              order.  Interrupts are only disabled to remove one post from the queue at a time.  When
+*              the queue is empty the task makes itself not ready; OS_IntQPost() readies it again.
+*
+* Arguments  : p_arg     is not used.
+*
+* Returns    : none
+*
+* Note(s)    : This task is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_IntQTask (void *p_arg)
+{
+    OS_INT_Q   post;
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                        /* Allocate storage for CPU status reg.*/
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    (void)p_arg;                                                   /* Prevent compiler warning            */
+    for (;;) {
+        OSSchedLock();
+        OS_ENTER_CRITICAL();
+        while (OSIntQEntries > 0) {
+            post = *OSIntQOut;                                     /* Remove the oldest post              */
+            OSIntQOut++;
+            if (OSIntQOut == &OSIntQTbl[OS_INT_Q_SIZE]) {          /* Wrap OUT pointer if at end of queue */
+                OSIntQOut = &OSIntQTbl[0];
+            }
+            OSIntQEntries--;
+            OS_EXIT_CRITICAL();
+            OS_IntQRePost(&post);                                  /* Perform it with interrupts enabled  */
+            OS_ENTER_CRITICAL();
+        }
+        OSIntQTaskRdy = OS_FALSE;                                  /* Queue is empty, make task not ready */
+        ptcb          = OSTCBCur;
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskUnRdy(ptcb);
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskUnRdy(ptcb);
+#else
+        OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[ptcb->OSTCBY] == 0) {
+            OSRdyGrp           &= ~ptcb->OSTCBBitY;
+        }
+#endif
+        OS_EXIT_CRITICAL();
+        OSSchedUnlock();                                           /* Run the tasks readied by the posts  */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          PERFORM A QUEUED POST
+*
+* Description: This function calls the post service an ISR invoked.  OSIntNesting is 0 in the post task
+*              so the service performs the post instead of queuing it again.
+*
+* Arguments  : ppost         is a pointer to a copy of the queued post.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_IntQRePost (OS_INT_Q *ppost)
+{
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    INT8U  err;
+#endif
+
+
+    switch (ppost->OSIntQType) {
+#if OS_SEM_EN > 0
+        case OS_EVENT_TYPE_SEM:
+             (void)OSSemPost((OS_EVENT *)ppost->OSIntQObj);
+             break;
+#endif
+
+#if OS_MBOX_EN > 0
+        case OS_EVENT_TYPE_MBOX:
+#if OS_MBOX_POST_OPT_EN > 0
+             (void)OSMboxPostOpt((OS_EVENT *)ppost->OSIntQObj, ppost->OSIntQMsg, ppost->OSIntQOpt);
+#elif OS_MBOX_POST_EN > 0
+             (void)OSMboxPost((OS_EVENT *)ppost->OSIntQObj, ppost->OSIntQMsg);
+#endif
+             break;
+#endif
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+        case OS_EVENT_TYPE_Q:
+#if OS_Q_POST_OPT_EN > 0
+             (void)OSQPostOpt((OS_EVENT *)ppost->OSIntQObj, ppost->OSIntQMsg, ppost->OSIntQOpt);
+#else
+#if OS_Q_POST_FRONT_EN > 0
+             if (ppost->OSIntQOpt == OS_POST_OPT_FRONT) {
+                 (void)OSQPostFront((OS_EVENT *)ppost->OSIntQObj, ppost->OSIntQMsg);
+                 break;
+             }
+#endif
+#if OS_Q_POST_EN > 0
+             (void)OSQPost((OS_EVENT *)ppost->OSIntQObj, ppost->OSIntQMsg);
+#endif
+#endif
+             break;
+#endif
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+        case OS_EVENT_TYPE_FLAG:
+             (void)OSFlagPost((OS_FLAG_GRP *)ppost->OSIntQObj, (OS_FLAGS)ppost->OSIntQFlags,
+                              ppost->OSIntQOpt, &err);
+             break;
+#endif
+
+#if OS_STATE_EN > 0
+        case OS_EVENT_TYPE_STATE:                                  /* The ISR already wrote the value     */
+             OS_StateRdyAll((OS_EVENT *)ppost->OSIntQObj);
+             break;
+#endif
+
+        default:
+             break;
+    }
+}
+#endif
@@ -28,6 +28,17 @@
 #if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
 /*
 *********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if OS_Q_MULTI_EN > 0
+static  INT16U  OS_QGetMulti (OS_Q *pq, void **pmsgs, INT16U n);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                      ACCEPT MESSAGE FROM QUEUE
 *
 * Description: This function checks the queue to see if a message is available.  Unlike OSQPend(),
@@ -101,6 +112,72 @@ void  *OSQAccept (OS_EVENT *pevent, INT8U *perr)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                  ACCEPT SEVERAL MESSAGES FROM A QUEUE
+*
+* Description: This function removes up to 'n' messages from a queue in a single critical section.  Like
+*              OSQAccept(), it does not suspend the calling task if the queue is empty.
+*
+* Arguments  : pevent        is a pointer to the event control block
+*
+*              pmsgs         is a pointer to an array of at least 'n' entries, where the messages are
+*                            stored, oldest first.
+*
+*              n             is the maximum number of messages to remove.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         At least one message was removed from the queue
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer
+*                            OS_ERR_Q_EMPTY      The queue did not contain any messages
+*
+* Returns    : The number of messages stored in 'pmsgs[]'.
+*********************************************************************************************************
+*/
+
+#if OS_Q_MULTI_EN > 0
+INT16U  OSQAcceptMulti (OS_EVENT *pevent, void **pmsgs, INT16U n, INT8U *perr)
+{
+    INT16U     nmsgs;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                    /* Validate 'perr'                                    */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                   /* Validate 'pmsgs'                                   */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {/* Validate event block type                          */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    nmsgs = OS_QGetMulti((OS_Q *)pevent->OSEventPtr, pmsgs, n);
+    OS_EXIT_CRITICAL();
+    if (nmsgs > 0) {
+        *perr = OS_ERR_NONE;
+    } else {
+        *perr = OS_ERR_Q_EMPTY;
+    }
+    return (nmsgs);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                        CREATE A MESSAGE QUEUE
 *
 * Description: This function creates a message queue if free event control blocks are available.
@@ -246,6 +323,9 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
     switch (opt) {
         case OS_DEL_NO_PEND:                               /* Delete queue only if no task waiting     */
              if (tasks_waiting == OS_FALSE) {
+#if OS_POLL_EN > 0
+                 OS_PollRemove(pevent);                    /* Take queue out of its poll set           */
+#endif
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
@@ -271,6 +351,9 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for queue        */
                  (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_Q, OS_STAT_PEND_OK);
              }
+#if OS_POLL_EN > 0
+             OS_PollRemove(pevent);                        /* Take queue out of its poll set           */
+#endif
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
@@ -385,7 +468,7 @@ INT8U  OSQFlush (OS_EVENT *pevent)
 *********************************************************************************************************
 */
 
-void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+void  *OSQPend (OS_EVENT *pevent, INT32U timeout, INT8U *perr)
 {
     void      *pmsg;
     OS_Q      *pq;
@@ -430,7 +513,11 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur, timeout);        /* Load timeout into TCB                              */
+#else
     OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+#endif
     OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
     OS_EXIT_CRITICAL();
     OS_Sched();                                  /* Find next highest priority task ready to run       */
@@ -466,6 +553,132 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                 PEND ON A QUEUE FOR SEVERAL MESSAGES
+*
+* Description: This function waits for at least one message to be sent to a queue, then removes up to
+*              'n' messages from it.  Messages posted in a batch by OSQPostMulti() are all received with a
+*              single context switch.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array of at least 'n' entries, where the messages are
+*                            stored, oldest first.
+*
+*              n             is the maximum number of messages to remove, at least 1.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message to arrive at the queue up to the amount of time
+*                            specified by this argument.  If you specify 0, however, your task will wait
+*                            forever at the specified queue or, until a message arrives.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received at least
+*                                                one message.
+*                            OS_ERR_TIMEOUT      A message was not received within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait on the queue was aborted.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer or 'n' is 0
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : The number of messages stored in 'pmsgs[]', 0 if no message was received.
+*********************************************************************************************************
+*/
+
+#if OS_Q_MULTI_EN > 0
+INT16U  OSQPendMulti (OS_EVENT *pevent, void **pmsgs, INT16U n, INT32U timeout, INT8U *perr)
+{
+    INT16U     nmsgs;
+    OS_Q      *pq;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                    /* Validate 'perr'                                    */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                   /* Validate 'pmsgs'                                   */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (n == 0) {                                /* A received message is always stored in pmsgs[0]    */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {/* Validate event block type                          */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        *perr = OS_ERR_PEND_ISR;                 /* ... can't PEND from an ISR                         */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked ...            */
+        *perr = OS_ERR_PEND_LOCKED;              /* ... can't PEND when locked                         */
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    pq    = (OS_Q *)pevent->OSEventPtr;          /* Point at queue control block                       */
+    nmsgs = OS_QGetMulti(pq, pmsgs, n);          /* Take the messages already in the queue, if any     */
+    if (nmsgs > 0) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (nmsgs);
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur, timeout);        /* Load timeout into TCB                              */
+#else
+    OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+#endif
+    OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                  /* Find next highest priority task ready to run       */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* First message was put in TCB by the post ...  */
+             pmsgs[0] = OSTCBCur->OSTCBMsg;           /* ... the rest of its batch is in the queue     */
+             nmsgs    = 1 + OS_QGetMulti(pq, &pmsgs[1], n - 1);
+            *perr     = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+            *perr =  OS_ERR_PEND_ABORT;               /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+            *perr =  OS_ERR_TIMEOUT;                  /* Indicate that we didn't get event within TO   */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    return (nmsgs);                                   /* Return number of messages received            */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                      ABORT WAITING ON A MESSAGE QUEUE
 *
 * Description: This function aborts & readies any tasks currently waiting on a queue.  This function 
@@ -562,6 +775,8 @@ INT8U  OSQPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are already pending
+*                                    (OS_ISR_POST_DEFERRED_EN).  The message is not sent.
 *
 * Note(s)    : As of V2.60, this function allows you to send NULL pointer messages.
 *********************************************************************************************************
@@ -585,6 +800,11 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                            /* Called from an ISR, let the post task do it  */
+        return (OS_IntQPost(OS_EVENT_TYPE_Q, (void *)pevent, pmsg, 0, OS_POST_OPT_NONE));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                     /* See if any task pending on queue             */
                                                        /* Ready highest priority task waiting on event */
@@ -603,6 +823,13 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
     if (pq->OSQIn == pq->OSQEnd) {                     /* Wrap IN ptr if we are at end of queue        */
         pq->OSQIn = pq->OSQStart;
     }
+#if OS_POLL_EN > 0
+    if (OS_PollSignal(pevent) == OS_TRUE) {            /* Ready the task waiting on the poll set       */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -610,6 +837,123 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                    POST SEVERAL MESSAGES TO A QUEUE
+*
+* Description: This function sends up to 'n' messages to a queue with the scheduler locked, followed by a
+*              single call to the scheduler.  As with OSQPost(), the highest priority task waiting on the
+*              queue receives the first message, the next waiting task the second one and so on; the
+*              remaining messages are inserted into the queue in order.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array of 'n' messages to send, oldest first.
+*
+*              n             is the number of messages to send.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE           All 'n' messages were sent
+*                            OS_ERR_Q_FULL         The queue became full, only the number of messages
+*                                                  returned were sent
+*                            OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
+*                            OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL     If 'pmsgs' is a NULL pointer
+*                            OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are
+*                                                  already pending (OS_ISR_POST_DEFERRED_EN).  Only the
+*                                                  number of messages returned were sent.
+*
+* Returns    : The number of messages sent.
+*
+* Note(s)    : 1) Interrupts are only disabled while one message is sent.  Messages that ISRs post to the
+*                 queue meanwhile may therefore be interleaved with the batch.
+*              2) With OS_ISR_POST_DEFERRED_EN set to 1 a call from an ISR queues one post per message, and
+*                 the post task sends them one at a time.
+*********************************************************************************************************
+*/
+
+#if OS_Q_MULTI_EN > 0
+INT16U  OSQPostMulti (OS_EVENT *pevent, void **pmsgs, INT16U n, INT8U *perr)
+{
+    OS_Q      *pq;
+    INT16U     nmsgs;
+    BOOLEAN    sched;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                         /* Validate 'pmsgs'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    *perr = OS_ERR_NONE;
+    nmsgs = 0;
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                            /* Called from an ISR, let the post task do it  */
+        while (nmsgs < n) {
+            *perr = OS_IntQPost(OS_EVENT_TYPE_Q, (void *)pevent, pmsgs[nmsgs], 0, OS_POST_OPT_NONE);
+            if (*perr != OS_ERR_NONE) {
+                break;
+            }
+            nmsgs++;
+        }
+        return (nmsgs);
+    }
+#endif
+    sched = OS_FALSE;
+    pq    = (OS_Q *)pevent->OSEventPtr;                /* Point to queue control block                 */
+    OS_ENTER_CRITICAL();
+    OSLockNesting++;                                   /* Lock tasks, not interrupts, for the batch    */
+    while (nmsgs < n) {
+        if (pevent->OSEventGrp != 0) {                 /* One message to each task pending on queue    */
+            (void)OS_EventTaskRdy(pevent, pmsgs[nmsgs], OS_STAT_Q, OS_STAT_PEND_OK);
+            sched = OS_TRUE;
+        } else {                                       /* Insert the remaining messages into queue     */
+            if (pq->OSQEntries >= pq->OSQSize) {       /* Make sure queue is not full                  */
+                *perr = OS_ERR_Q_FULL;
+                break;
+            }
+            *pq->OSQIn++ = pmsgs[nmsgs];
+            pq->OSQEntries++;                          /* Update the nbr of entries in the queue       */
+            if (pq->OSQIn == pq->OSQEnd) {             /* Wrap IN ptr if we are at end of queue        */
+                pq->OSQIn = pq->OSQStart;
+            }
+        }
+        nmsgs++;
+        OS_EXIT_CRITICAL();                            /* Service interrupts between two messages      */
+        OS_ENTER_CRITICAL();
+    }
+#if OS_POLL_EN > 0
+    if ((pq->OSQEntries > 0) && (OS_PollSignal(pevent) == OS_TRUE)) {
+        sched = OS_TRUE;                               /* Ready the task waiting on the poll set       */
+    }
+#endif
+    OSLockNesting--;
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+    }
+    return (nmsgs);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                   POST MESSAGE TO THE FRONT OF A QUEUE
 *
 * Description: This function sends a message to a queue but unlike OSQPost(), the message is posted at
@@ -624,6 +968,8 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are already pending
+*                                    (OS_ISR_POST_DEFERRED_EN).  The message is not sent.
 *
 * Note(s)    : As of V2.60, this function allows you to send NULL pointer messages.
 *********************************************************************************************************
@@ -647,6 +993,11 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Called from an ISR, let the post task do it   */
+        return (OS_IntQPost(OS_EVENT_TYPE_Q, (void *)pevent, pmsg, 0, OS_POST_OPT_FRONT));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on queue              */
                                                       /* Ready highest priority task waiting on event  */
@@ -666,6 +1017,13 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
     pq->OSQOut--;
     *pq->OSQOut = pmsg;                               /* Insert message into queue                     */
     pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if OS_POLL_EN > 0
+    if (OS_PollSignal(pevent) == OS_TRUE) {           /* Ready the task waiting on the poll set        */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -694,9 +1052,13 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are already pending
+*                                    (OS_ISR_POST_DEFERRED_EN).  The message is not sent.
 *
 * Warning    : Interrupts can be disabled for a long time if you do a 'broadcast'.  In fact, the
 *              interrupt disable time is proportional to the number of tasks waiting on the queue.
+*              With OS_ISR_POST_DEFERRED_EN set to 1 the scheduler is locked instead and interrupts are
+*              only disabled while one task is made ready.
 *********************************************************************************************************
 */
 
@@ -718,12 +1080,27 @@ INT8U  OSQPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Called from an ISR, let the post task do it   */
+        return (OS_IntQPost(OS_EVENT_TYPE_Q, (void *)pevent, pmsg, 0, opt));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0x00) {                 /* See if any task pending on queue              */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00) {  /* Do we need to post msg to ALL waiting tasks ? */
+#if OS_ISR_POST_DEFERRED_EN > 0
+            OSLockNesting++;                          /* ISRs don't change the wait list, lock tasks   */
+#endif
             while (pevent->OSEventGrp != 0) {         /* Yes, Post to ALL tasks waiting on queue       */
                 (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+#if OS_ISR_POST_DEFERRED_EN > 0
+                OS_EXIT_CRITICAL();                   /* Service interrupts between two tasks          */
+                OS_ENTER_CRITICAL();
+#endif
             }
+#if OS_ISR_POST_DEFERRED_EN > 0
+            OSLockNesting--;
+#endif
         } else {                                      /* No,  Post to HPT waiting on queue             */
             (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
         }
@@ -751,6 +1128,13 @@ INT8U  OSQPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         }
     }
     pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if OS_POLL_EN > 0
+    if (OS_PollSignal(pevent) == OS_TRUE) {           /* Ready the task waiting on the poll set        */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -779,7 +1163,10 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 {
     OS_Q      *pq;
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U    *psrc;
+    INT32U    *pdest;
+#elif OS_LOWEST_PRIO <= 63
     INT8U     *psrc;
     INT8U     *pdest;
 #else
@@ -823,6 +1210,47 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 }
 #endif                                                 /* OS_Q_QUERY_EN                                */
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE SEVERAL MESSAGES FROM A QUEUE
+*
+* Description: This function is called by OSQAcceptMulti() and OSQPendMulti() to remove up to 'n' messages
+*              from a queue.
+*
+* Arguments  : pq            is a pointer to the queue control block.
+*
+*              pmsgs         is a pointer to where the messages are stored, oldest first.
+*
+*              n             is the maximum number of messages to remove.
+*
+* Returns    : The number of messages removed.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_Q_MULTI_EN > 0
+static  INT16U  OS_QGetMulti (OS_Q *pq, void **pmsgs, INT16U n)
+{
+    INT16U  nmsgs;
+
+
+    if (n > pq->OSQEntries) {                    /* Remove at most the messages in the queue           */
+        n = pq->OSQEntries;
+    }
+    for (nmsgs = 0; nmsgs < n; nmsgs++) {
+        pmsgs[nmsgs] = *pq->OSQOut++;            /* Extract oldest message from the queue              */
+        if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
+            pq->OSQOut = pq->OSQStart;
+        }
+    }
+    pq->OSQEntries -= n;                         /* Update the number of entries in the queue          */
+    return (n);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
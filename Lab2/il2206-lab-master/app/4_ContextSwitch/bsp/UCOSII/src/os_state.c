@@ -0,0 +1,403 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                            STATE CHANNELS
+*
+* File    : OS_STATE.C
+* Version : V2.86
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_STATE_EN > 0
+/*
+*********************************************************************************************************
+*                                                 NOTES
+*
+* 1) A state channel holds the latest value of a variable, e.g. a sensor reading, for any number of
+*    readers.  OSStateWrite() replaces the value, OSStateRead() copies it out and OSStatePend() waits for a
+*    value newer than the one the reader has.  Unlike a mailbox a value is not consumed when it is read,
+*    so the writer does the same work whatever the number of readers.
+*
+* 2) The channel keeps two copies of the value.  Write number W goes into copy (W & 1), and is published
+*    by setting OSStateVersion to W once it is complete.  A reader copies out copy (OSStateVersion & 1),
+*    which the writer does not touch until it starts write W + 2, as counted by OSStateWrCtr.  A reader
+*    that is preempted by a writer in the middle of a write therefore still copies a consistent value
+*    without waiting, and only copies again if the writer started two writes during its copy.
+*
+* 3) Neither reading nor writing the value disables interrupts, so both may be done by ISRs.  There must
+*    be a single writer: two tasks, or a task and an ISR, writing the same channel need a lock of their
+*    own around OSStateWrite().
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT32U  OS_StateCopy (OS_STATE *pstate, void *pdata);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         CREATE A STATE CHANNEL
+*
+* Description: This function creates a state channel.
+*
+* Arguments  : pstate        is a pointer to the channel's control block, allocated by the application.
+*
+*              pbuf          is a pointer to the storage of the two copies of the value, 2 * size bytes.
+*                            The first 'size' bytes are the initial value, read as version 0.
+*
+*              size          is the size (in bytes) of the value.
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block (OS_EVENT) associated with the
+*                                created channel
+*              == (OS_EVENT *)0  if no event control blocks were available, an argument is invalid or the
+*                                function was called from an ISR
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSStateCreate (OS_STATE *pstate, void *pbuf, INT16U size)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pstate == (OS_STATE *)0) {               /* Validate arguments                                 */
+        return ((OS_EVENT *)0);
+    }
+    if (pbuf == (void *)0) {
+        return ((OS_EVENT *)0);
+    }
+    if (size == 0) {
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        return ((OS_EVENT *)0);                  /* ... can't CREATE from an ISR                       */
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                    /* Get next free event control block                  */
+    if (OSEventFreeList != (OS_EVENT *)0) {      /* See if pool of free ECB pool was empty             */
+        OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pevent != (OS_EVENT *)0) {
+        pstate->OSStateBuf     = (INT8U *)pbuf;
+        pstate->OSStateSize    = size;
+        pstate->OSStateVersion = 0;              /* The initial value is version 0, in copy 0          */
+        pstate->OSStateWrCtr   = 0;
+        pevent->OSEventType    = OS_EVENT_TYPE_STATE;
+        pevent->OSEventCnt     = 0;
+        pevent->OSEventPtr     = (void *)pstate; /* Point to the channel's control block               */
+#if OS_EVENT_NAME_SIZE > 1
+        pevent->OSEventName[0] = '?';
+        pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+        OS_EventWaitListInit(pevent);
+    }
+    return (pevent);                             /* Return pointer to event control block              */
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      READ THE VALUE OF A STATE CHANNEL
+*
+* Description: This function copies the latest value of a state channel without waiting.  It may be
+*              called by tasks and ISRs.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the channel.
+*
+*              pdata         is a pointer to where the value is copied, OSStateSize bytes.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The value was copied
+*                            OS_ERR_EVENT_TYPE   'pevent' is not pointing to a state channel
+*                            OS_ERR_PEVENT_NULL  'pevent' is a NULL pointer
+*
+* Returns    : The version of the value copied, i.e. the number of writes it is the result of.
+*********************************************************************************************************
+*/
+
+INT32U  OSStateRead (OS_EVENT *pevent, void *pdata, INT8U *perr)
+{
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_STATE) { /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    *perr = OS_ERR_NONE;
+    return (OS_StateCopy((OS_STATE *)pevent->OSEventPtr, pdata));
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 WAIT FOR A NEW VALUE OF A STATE CHANNEL
+*
+* Description: This function waits until the version of a state channel differs from 'version', then
+*              copies its latest value.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the channel.
+*
+*              pdata         is a pointer to where the value is copied, OSStateSize bytes.
+*
+*              version       is the version the caller already has, as returned by the previous call to
+*                            OSStateRead() or OSStatePend(), or 0 to wait for the first write.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a new value up to the amount of time specified by this argument.  If
+*                            you specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         A new value was copied
+*                            OS_ERR_TIMEOUT      No new value was written within 'timeout'
+*                            OS_ERR_EVENT_TYPE   'pevent' is not pointing to a state channel
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension
+*                            OS_ERR_PEVENT_NULL  'pevent' is a NULL pointer
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*
+* Returns    : The version of the value copied, or 'version' if no value was copied.
+*
+* Note(s)    : 1) Versions in between are skipped if the channel was written several times since the
+*                 caller's version; only the latest value is kept.
+*********************************************************************************************************
+*/
+
+INT32U  OSStatePend (OS_EVENT *pevent, void *pdata, INT32U version, INT32U timeout, INT8U *perr)
+{
+    OS_STATE  *pstate;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (version);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (version);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_STATE) { /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (version);
+    }
+    pstate = (OS_STATE *)pevent->OSEventPtr;
+    OS_ENTER_CRITICAL();
+    if (pstate->OSStateVersion != version) {          /* See if there is already a newer value         */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (OS_StateCopy(pstate, pdata));
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return (version);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return (version);
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_STATE;         /* No new value, task will pend                  */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur, timeout);             /* Load timeout in TCB                           */
+#else
+    OSTCBCur->OSTCBDly       = timeout;               /* Load timeout in TCB                           */
+#endif
+    OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready to run  */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out                           */
+        case OS_STAT_PEND_OK:
+            *perr =  OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+            *perr =  OS_ERR_TIMEOUT;                  /* Indicate that we didn't get event within TO   */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;
+    OS_EXIT_CRITICAL();
+    if (*perr != OS_ERR_NONE) {
+        return (version);
+    }
+    return (OS_StateCopy(pstate, pdata));             /* Copy the value that woke us up, or a newer one */
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   WRITE A NEW VALUE TO A STATE CHANNEL
+*
+* Description: This function replaces the value of a state channel and readies all tasks waiting for a
+*              new value in OSStatePend().  It may be called by a task or an ISR, but only by one of them
+*              for a given channel.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the channel.
+*
+*              pdata         is a pointer to the new value, OSStateSize bytes.
+*
+* Returns    : OS_ERR_NONE          The value was written
+*              OS_ERR_EVENT_TYPE    'pevent' is not pointing to a state channel
+*              OS_ERR_PEVENT_NULL   'pevent' is a NULL pointer
+*              OS_ERR_PDATA_NULL    'pdata' is a NULL pointer
+*              OS_ERR_INT_Q_FULL    If called from an ISR while OS_INT_Q_SIZE posts are already pending
+*                                   (OS_ISR_POST_DEFERRED_EN).  The value is written, but the tasks
+*                                   waiting for it are not readied.
+*
+* Note(s)    : 1) Interrupts are only disabled, and the scheduler called, when tasks are waiting in
+*                 OSStatePend().  Readers that poll with OSStateRead() cost the writer nothing.
+*********************************************************************************************************
+*/
+
+INT8U  OSStateWrite (OS_EVENT *pevent, void *pdata)
+{
+    OS_STATE  *pstate;
+    INT32U     wr;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (pdata == (void *)0) {                         /* Validate 'pdata'                              */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_STATE) { /* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    pstate               = (OS_STATE *)pevent->OSEventPtr;
+    wr                   = pstate->OSStateWrCtr + 1;
+    pstate->OSStateWrCtr = wr;                        /* Readers of copy (wr & 1) must copy again      */
+    OS_CPU_BARRIER();
+    OS_MemCopy(pstate->OSStateBuf + (wr & 1) * pstate->OSStateSize, (INT8U *)pdata, pstate->OSStateSize);
+    OS_CPU_BARRIER();                                 /* Write the value before publishing it          */
+    pstate->OSStateVersion = wr;
+    OS_CPU_BARRIER();                                 /* Publish it before looking for waiting tasks   */
+    if (pevent->OSEventGrp == 0) {                    /* See if any task is waiting for the value      */
+        return (OS_ERR_NONE);
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Called from an ISR, let the post task do it   */
+        return (OS_IntQPost(OS_EVENT_TYPE_STATE, (void *)pevent, (void *)0, 0, 0));
+    }
+#endif
+    OS_StateRdyAll(pevent);
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                READY ALL TASKS WAITING ON A STATE CHANNEL
+*
+* Description: This function is called by OSStateWrite(), or by the post task for a write an ISR made,
+*              to ready all tasks waiting for a new value of a state channel.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the channel.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are disabled for a time proportional to the number of waiting tasks, unless
+*                 OS_ISR_POST_DEFERRED_EN is set to 1 (see OSMboxPostOpt()).
+*********************************************************************************************************
+*/
+
+void  OS_StateRdyAll (OS_EVENT *pevent)
+{
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp == 0) {                    /* Waiting tasks may have timed out meanwhile    */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OSLockNesting++;                                  /* ISRs don't change the wait list, lock tasks   */
+#endif
+    while (pevent->OSEventGrp != 0) {                 /* Ready ALL tasks waiting on the channel        */
+        (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_STATE, OS_STAT_PEND_OK);
+#if OS_ISR_POST_DEFERRED_EN > 0
+        OS_EXIT_CRITICAL();                           /* Service interrupts between two tasks          */
+        OS_ENTER_CRITICAL();
+#endif
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OSLockNesting--;
+#endif
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find HPT ready to run                         */
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   COPY THE LATEST VALUE OF A STATE CHANNEL
+*
+* Description: This function copies the latest complete value of a state channel, again if the writer
+*              started to overwrite it during the copy (see note 2 at the top of this file).
+*
+* Arguments  : pstate        is a pointer to the channel's control block.
+*
+*              pdata         is a pointer to where the value is copied.
+*
+* Returns    : The version of the value copied.
+*********************************************************************************************************
+*/
+
+static  INT32U  OS_StateCopy (OS_STATE *pstate, void *pdata)
+{
+    INT32U  version;
+
+
+    do {
+        version = pstate->OSStateVersion;
+        OS_CPU_BARRIER();                             /* Read the version before the value             */
+        OS_MemCopy((INT8U *)pdata, pstate->OSStateBuf + (version & 1) * pstate->OSStateSize,
+                   pstate->OSStateSize);
+        OS_CPU_BARRIER();                             /* Read the value before checking the writer     */
+    } while ((INT32U)(pstate->OSStateWrCtr - version) > 1);
+    return (version);
+}
+#endif
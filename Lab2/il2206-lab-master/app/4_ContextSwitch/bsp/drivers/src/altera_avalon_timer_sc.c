@@ -41,6 +41,57 @@
 #include "alt_types.h"
 #include "sys/alt_log_printf.h"
 
+/*
+ * State of the system clock, used to support the tickless idle mode.
+ *
+ * "alt_avalon_timer_sc_period" is the number of timer clock cycles in one 
+ * system clock tick, i.e. the load value programmed by the hardware.
+ *
+ * "alt_avalon_timer_sc_load" is the number of cycles currently programmed in 
+ * the timer, and "alt_avalon_timer_sc_nticks" the number of ticks that are
+ * passed to alt_tick() or alt_tick_n() when it expires. While ticking normally, these are
+ * the tick period and one respectively.
+ *
+ * "alt_avalon_timer_sc_first" is the number of cycles, out of a suspended
+ * period, until the first of the skipped ticks.
+ */
+
+static void*   alt_avalon_timer_sc_base;
+static alt_u32 alt_avalon_timer_sc_period;
+static alt_u32 alt_avalon_timer_sc_load;
+static alt_u32 alt_avalon_timer_sc_nticks;
+static alt_u32 alt_avalon_timer_sc_first;
+
+/*
+ * alt_avalon_timer_sc_start() restarts the timer so that it expires every
+ * "load" clock cycles. Writing to the period registers stops the timer and
+ * reloads the counter.
+ */
+
+static void alt_avalon_timer_sc_start (void* base, alt_u32 load)
+{
+  alt_avalon_timer_sc_load = load;
+
+  IOWR_ALTERA_AVALON_TIMER_PERIODL (base, (load - 1) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_PERIODH (base, ((load - 1) >> 16) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (base, 
+            ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+            ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+            ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+}
+
+/*
+ * alt_avalon_timer_sc_count() returns the current value of the down counter.
+ */
+
+static alt_u32 alt_avalon_timer_sc_count (void* base)
+{
+  IOWR_ALTERA_AVALON_TIMER_SNAPL (base, 0);
+
+  return (IORD_ALTERA_AVALON_TIMER_SNAPL (base) & ALTERA_AVALON_TIMER_SNAPL_MSK) |
+         ((IORD_ALTERA_AVALON_TIMER_SNAPH (base) & ALTERA_AVALON_TIMER_SNAPH_MSK) << 16);
+}
+
 /* 
  * alt_avalon_timer_sc_irq() is the interrupt handler used for the system 
  * clock. This is called periodically when a timer interrupt occurs. The 
@@ -57,6 +108,7 @@ static void alt_avalon_timer_sc_irq (void* base, alt_u32 id)
 #endif
 {
   alt_irq_context cpu_sr;
+  alt_u32         nticks;
   
   /* clear the interrupt */
   IOWR_ALTERA_AVALON_TIMER_STATUS (base, 0);
@@ -76,7 +128,26 @@ static void alt_avalon_timer_sc_irq (void* base, alt_u32 id)
    * during this time to safely support ISR preemption
    */
   cpu_sr = alt_irq_disable_all();
-  alt_tick ();
+
+  /* 
+   * Return to the normal tick period if the period that just expired was
+   * changed by alt_sysclk_suspend() or alt_sysclk_resume(). 
+   */
+  nticks = alt_avalon_timer_sc_nticks;
+  if (alt_avalon_timer_sc_load != alt_avalon_timer_sc_period)
+  {
+    alt_avalon_timer_sc_start (base, alt_avalon_timer_sc_period);
+    alt_avalon_timer_sc_nticks = 1;
+  }
+
+  if (nticks == 1)
+  {
+    alt_tick ();
+  }
+  else
+  {
+    alt_tick_n (nticks);          /* all skipped ticks in one step */
+  }
   alt_irq_enable_all(cpu_sr);
 }
 
@@ -92,6 +163,15 @@ void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
   /* set the system clock frequency */
   
   alt_sysclk_init (freq);
+
+  /* remember the tick period for the tickless idle mode */
+
+  alt_avalon_timer_sc_base   = base;
+  alt_avalon_timer_sc_period = 
+     ((IORD_ALTERA_AVALON_TIMER_PERIODL (base) & ALTERA_AVALON_TIMER_PERIODL_MSK) |
+      ((IORD_ALTERA_AVALON_TIMER_PERIODH (base) & ALTERA_AVALON_TIMER_PERIODH_MSK) << 16)) + 1;
+  alt_avalon_timer_sc_load   = alt_avalon_timer_sc_period;
+  alt_avalon_timer_sc_nticks = 1;
   
   /* set to free running mode */
   
@@ -108,3 +188,87 @@ void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
   alt_irq_register (irq, base, alt_avalon_timer_sc_irq);
 #endif  
 }
+
+/*
+ * alt_sysclk_suspend() reprograms the system clock so that the next interrupt
+ * occurs "nticks" ticks from now, see sys/alt_alarm.h. The part of the 
+ * current tick that has already elapsed is preserved, so that the skipped 
+ * ticks stay in phase with the normal ticks.
+ *
+ * Nothing is done if a tick interrupt is already pending, or if the clock is
+ * already suspended.
+ */
+
+alt_u32 alt_sysclk_suspend (alt_u32 nticks)
+{
+  void*   base = alt_avalon_timer_sc_base;
+  alt_u32 first;
+
+  if ((base == NULL) || (nticks < 2) ||
+      (alt_avalon_timer_sc_load != alt_avalon_timer_sc_period) ||
+      (IORD_ALTERA_AVALON_TIMER_STATUS (base) & ALTERA_AVALON_TIMER_STATUS_TO_MSK))
+  {
+    return 0;
+  }
+
+  /* limit the request to what fits in the 32 bit period register */
+
+  if (nticks > 0xFFFFFFFF / alt_avalon_timer_sc_period)
+  {
+    nticks = 0xFFFFFFFF / alt_avalon_timer_sc_period;
+  }
+
+  first = alt_avalon_timer_sc_count (base) + 1;
+
+  alt_avalon_timer_sc_first  = first;
+  alt_avalon_timer_sc_nticks = nticks;
+  alt_avalon_timer_sc_start (base, 
+                             first + (nticks - 1) * alt_avalon_timer_sc_period);
+
+  return nticks;
+}
+
+/*
+ * alt_sysclk_resume() ends a suspended period early. The number of whole 
+ * ticks that have elapsed is computed from the counter, these are passed 
+ * to alt_tick_n(), and the timer is programmed to expire on the next tick 
+ * boundary. The following interrupt then restores the normal period.
+ */
+
+void alt_sysclk_resume (void)
+{
+  void*   base = alt_avalon_timer_sc_base;
+  alt_u32 elapsed;
+  alt_u32 nticks;
+  alt_u32 next;
+
+  /* 
+   * Nothing to do if the clock is not suspended, or if the suspended period
+   * has already expired; the pending interrupt accounts for all ticks. 
+   */
+
+  if ((base == NULL) || (alt_avalon_timer_sc_nticks < 2) ||
+      (IORD_ALTERA_AVALON_TIMER_STATUS (base) & ALTERA_AVALON_TIMER_STATUS_TO_MSK))
+  {
+    return;
+  }
+
+  elapsed = alt_avalon_timer_sc_load - 1 - alt_avalon_timer_sc_count (base);
+
+  if (elapsed < alt_avalon_timer_sc_first)
+  {
+    nticks = 0;
+    next   = alt_avalon_timer_sc_first - elapsed;
+  }
+  else
+  {
+    elapsed -= alt_avalon_timer_sc_first;
+    nticks   = 1 + elapsed / alt_avalon_timer_sc_period;
+    next     = alt_avalon_timer_sc_period - elapsed % alt_avalon_timer_sc_period;
+  }
+
+  alt_avalon_timer_sc_nticks = 1;
+  alt_avalon_timer_sc_start (base, next);
+
+  alt_tick_n (nticks);
+}
@@ -28,8 +28,16 @@ OS_EVENT  *DispSem2;
 #define TASK2_PRIORITY      7
 #define TASK_STAT_PRIORITY 12  // lowest priority 
 
-// ((void *)PERFORMANCE_COUNTER_BASE) p  //definition peripheral's HW base adress
- //probably it is not written in the right way 
+/* Definition of Task Periods, in clock ticks. OS_TICKS_PER_SEC is a
+ * double, so the rate of the system clock timer (TIMER_0) is taken from
+ * its integer frequency and load value */
+#define TICKS_PER_SEC (TIMER_0_FREQ / (TIMER_0_LOAD_VALUE + 1))
+#define TASK1_PERIOD  (1 * TICKS_PER_SEC / 1000)  // 1ms
+#define TASK2_PERIOD  (1 * TICKS_PER_SEC / 1000)  // 1ms
+
+#if TASK1_PERIOD == 0 || TASK2_PERIOD == 0
+#error "A task period is shorter than a clock tick"
+#endif
 
 
 void printStackSize(char* name, int prio) 
@@ -58,12 +66,15 @@ void task1(void* pdata)
 {
     INT8U err;
     char state = '0';
+    INT64U next = OSTimeGet64();  // Absolute time of the next release
+    INT32U overruns = 0;
 
     while (1)
     { 
       printf("Task 0 - State %c \n", state);
 
       OSSemPost(DispSem2); // Semaphore is signaled 
+
       PERF_RESET( PERFORMANCE_COUNTER_BASE );   //reset of the counter 
       
       PERF_START_MEASURING( PERFORMANCE_COUNTER_BASE );  //start the counter  when the semaphores say to wait
@@ -74,12 +85,17 @@ void task1(void* pdata)
       else
           state = '0';  
       
-      OSTimeDlyHMSM(0, 0, 0, 1); // 1ms delay
-      
       /* Context Switch to next task
 		    * Task will go to the ready state
-		    * after the specified delay
+		    * at its next release, one period after the last one
 		  */
+      next += TASK1_PERIOD;
+      if (OSTimeDlyUntil(next) == OS_ERR_TIME_OVERRUN)
+        {
+          overruns++;
+          if (DEBUG == 1)
+            printf("Task 0 overrun (%" PRIu32 ")\n", overruns);
+        }
 
     }
 }
@@ -89,23 +105,25 @@ void task2(void* pdata)
 {
     INT8U err;
     char state = '0';
-    int clock_cycles = 0;
+    alt_u64 clock_cycles = 0;
     long double ContextSwitch_Seconds = 0;
 
     int count = 0;
     long double ContextSwitchAverage = 0;
     long double ContextSwitchAccumulator=0;
+    INT64U next = OSTimeGet64();  // Absolute time of the next release
+    INT32U overruns = 0;
 
     while (1)
     { 
-        // PERF_STOP_MEASURING( PERFORMANCE_COUNTER_BASE ); //stop the counter when the semaphores say to start next task
-        
       OSSemPend(DispSem2, 0, &err); // semaphore is waiting 
 
       PERF_STOP_MEASURING( PERFORMANCE_COUNTER_BASE ); //stop the counter when the semaphores say to start next task
 
-      clock_cycles = perf_get_total_time( (void *) PERFORMANCE_COUNTER_BASE ); // alt_u64 number;
-      ContextSwitch_Seconds  = (long double) clock_cycles/ 50 ;
+      // The BSP has no timestamp timer, so OSTimeTsGet() would only count
+      // ticks; the performance counter counts CPU cycles
+      clock_cycles = perf_get_total_time( (void *) PERFORMANCE_COUNTER_BASE );
+      ContextSwitch_Seconds  = (long double) clock_cycles / (ALT_CPU_FREQ / 1000000);
 
       if(ContextSwitchAverage == 0 || ContextSwitch_Seconds < ContextSwitchAverage*1.5)
       {
@@ -128,7 +146,14 @@ void task2(void* pdata)
       
       
       OSSemPost(DispSem1);  // Semaphore is signaled
-      OSTimeDlyHMSM(0, 0, 0, 1);  // 1ms delay
+
+      next += TASK2_PERIOD;
+      if (OSTimeDlyUntil(next) == OS_ERR_TIME_OVERRUN)
+        {
+          overruns++;
+          if (DEBUG == 1)
+            printf("Task 1 overrun (%" PRIu32 ")\n", overruns);
+        }
 
     }
 }
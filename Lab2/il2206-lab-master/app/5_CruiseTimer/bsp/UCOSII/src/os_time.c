@@ -27,7 +27,7 @@
 
 /*
 *********************************************************************************************************
-*                                DELAY TASK 'n' TICKS   (n from 0 to 65535)
+*                              DELAY TASK 'n' TICKS   (n from 0 to 4294967295)
 *
 * Description: This function is called to delay execution of the currently running task until the
 *              specified number of system ticks expires.  This, of course, directly equates to delaying
@@ -41,9 +41,11 @@
 *********************************************************************************************************
 */
 
-void  OSTimeDly (INT16U ticks)
+void  OSTimeDly (INT32U ticks)
 {
+#if (OS_SCHED_RR_EN == 0) && (OS_SCHED_EDF_EN == 0)
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -55,12 +57,22 @@ void  OSTimeDly (INT16U ticks)
     }
     if (ticks > 0) {                             /* 0 means no delay!                                  */
         OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskUnRdy(OSTCBCur);                /* Delay current task                                 */
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskUnRdy(OSTCBCur);               /* Delay current task                                 */
+#else
         y            =  OSTCBCur->OSTCBY;        /* Delay current task                                 */
         OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
         if (OSRdyTbl[y] == 0) {
             OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
         }
+#endif
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur, ticks);      /* Load ticks in TCB and insert in tick list          */
+#else
         OSTCBCur->OSTCBDly = ticks;              /* Load ticks in TCB                                  */
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                              /* Find next task to run!                             */
     }
@@ -86,9 +98,11 @@ void  OSTimeDly (INT16U ticks)
 *              OS_ERR_TIME_ZERO_DLY
 *              OS_ERR_TIME_DLY_ISR
 *
-* Note(s)    : The resolution on the milliseconds depends on the tick rate.  For example, you can't do
-*              a 10 mS delay if the ticker interrupts every 100 mS.  In this case, the delay would be
-*              set to 0.  The actual delay is rounded to the nearest tick.
+* Note(s)    : 1) The resolution on the milliseconds depends on the tick rate.  For example, you can't do
+*                 a 10 mS delay if the ticker interrupts every 100 mS.  In this case, the delay would be
+*                 set to 0.  The actual delay is rounded to the nearest tick.
+*              2) The delay is made with a single call to OSTimeDly(), so the longest delay (255 hours)
+*                 requires OS_TICKS_PER_SEC <= 4677.
 *********************************************************************************************************
 */
 
@@ -96,7 +110,6 @@ void  OSTimeDly (INT16U ticks)
 INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 {
     INT32U ticks;
-    INT16U loops;
 
 
     if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
@@ -126,14 +139,7 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
                                                  /* .. (rounded to the nearest tick)                   */
     ticks = ((INT32U)hours * 3600L + (INT32U)minutes * 60L + (INT32U)seconds) * OS_TICKS_PER_SEC
           + OS_TICKS_PER_SEC * ((INT32U)ms + 500L / OS_TICKS_PER_SEC) / 1000L;
-    loops = (INT16U)(ticks >> 16);               /* Compute the integral number of 65536 tick delays   */
-    ticks = ticks & 0xFFFFL;                     /* Obtain  the fractional number of ticks             */
-    OSTimeDly((INT16U)ticks);
-    while (loops > 0) {
-        OSTimeDly((INT16U)32768u);
-        OSTimeDly((INT16U)32768u);
-        loops--;
-    }
+    OSTimeDly(ticks);
     return (OS_ERR_NONE);
 }
 #endif
@@ -147,12 +153,6 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 *              task that is waiting for an event with timeout.  This would make the task look
 *              like a timeout occurred.
 *
-*              Also, you cannot resume a task that has called OSTimeDlyHMSM() with a combined time that
-*              exceeds 65535 clock ticks.  In other words, if the clock tick runs at 100 Hz then, you will
-*              not be able to resume a delayed task that called OSTimeDlyHMSM(0, 10, 55, 350) or higher:
-*
-*                  (10 Minutes * 60 + 55 Seconds + 0.35) * 100 ticks/second.
-*
 * Arguments  : prio                      specifies the priority of the task to resume
 *
 * Returns    : OS_ERR_NONE               Task has been resumed
@@ -191,7 +191,11 @@ INT8U  OSTimeDlyResume (INT8U prio)
         return (OS_ERR_TIME_NOT_DLY);                          /* Indicate that task was not delayed   */
     }
 
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);                                   /* Clear the time delay                 */
+#else
     ptcb->OSTCBDly = 0;                                        /* Clear the time delay                 */
+#endif
     if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
         ptcb->OSTCBStat     &= ~OS_STAT_PEND_ANY;              /* Yes, Clear status flag               */
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_TO;               /* Indicate PEND timeout                */
@@ -199,8 +203,14 @@ INT8U  OSTimeDlyResume (INT8U prio)
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_OK;
     }
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                   */
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskRdy(ptcb);                                    /* No,  Make ready                      */
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskRdy(ptcb);                                   /* No,  Make ready                      */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                      */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                                            /* See if this is new highest priority  */
     } else {
@@ -212,6 +222,158 @@ INT8U  OSTimeDlyResume (INT8U prio)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                  DELAY TASK UNTIL ITS NEXT RELEASE (EDF)
+*
+* Description: This function is called by a periodic task (see OSTaskPeriodSet()) when its current job is
+*              complete.  The task is delayed until the next job is released, one period after the
+*              previous release, and its deadline is moved on by one period as well.  Releases and
+*              deadlines are in ticks of OSTimeGet64().
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE               if the call was successful
+*              OS_ERR_TIME_DLY_ISR       if you called this function from an ISR
+*              OS_ERR_PEND_LOCKED        if you called this function while the scheduler is locked
+*              OS_ERR_TASK_NOT_PERIODIC  if the calling task is not periodic
+*
+* Note(s)    : 1) A job that completes after its deadline is counted in the task's .OSTCBDlMiss.  The next
+*                 job is then released immediately, so the task catches up with its original release
+*                 times rather than drifting.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_EDF_EN > 0
+INT8U  OSTimeDlyPeriod (void)
+{
+    INT64U     release;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked                */
+        return (OS_ERR_PEND_LOCKED);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBCur->OSTCBPeriod == 0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    if (OSTCBCur->OSTCBDeadline < OSTickCtr) {   /* See if this job completed late                     */
+        OSTCBCur->OSTCBDlMiss++;
+    }
+    OS_EDFTaskUnRdy(OSTCBCur);                   /* Leave the heap while the key changes               */
+    release                  = OSTCBCur->OSTCBRelTime + OSTCBCur->OSTCBPeriod;
+    OSTCBCur->OSTCBRelTime   = release;
+    OSTCBCur->OSTCBDeadline += OSTCBCur->OSTCBPeriod;
+    if (release > OSTickCtr) {                   /* Delay current task until the release               */
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur, (INT32U)(release - OSTickCtr));
+#else
+        OSTCBCur->OSTCBDly = (INT32U)(release - OSTickCtr);
+#endif
+    } else {
+        OS_EDFTaskRdy(OSTCBCur);                 /* Released already, rejoin with its new deadline     */
+    }
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                  /* Find next task to run!                             */
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    DELAY TASK UNTIL AN ABSOLUTE TIME
+*
+* Description: This function is called to delay execution of the currently running task until the 64-bit
+*              monotonic tick counter (see OSTimeGet64()) reaches 'time'.  Unlike OSTimeDly(), the time the task spent
+*              running since it last computed 'time' does not add to the delay, so a periodic loop keeps
+*              its phase exactly:
+*
+*                  next = OSTimeGet64();
+*                  for (;;) {
+*                      ...                           (Work)
+*                      next += PERIOD;
+*                      OSTimeDlyUntil(next);
+*                  }
+*
+* Arguments  : time      is the value of the 64-bit tick counter at which the task is made ready again.
+*
+* Returns    : OS_ERR_NONE           if the task was delayed until 'time', or 'time' is the current tick
+*              OS_ERR_TIME_OVERRUN   if 'time' has already passed; the task is not delayed
+*              OS_ERR_TIME_DLY_ISR   if you called this function from an ISR
+*              OS_ERR_PEND_LOCKED    if you called this function while the scheduler is locked
+*
+* Note(s)    : 1) A loop that overruns should not skip 'time' ahead: the next calls then return at once
+*                 until it has caught up with its original release times.
+*              2) A task woken up early (e.g. by OSTimeDlyResume()) is delayed again until 'time'.  Only
+*                 delays longer than the 2^32 - 1 ticks a TCB can hold are made of several delays.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT8U  OSTimeDlyUntil (INT64U time)
+{
+    INT64U     now;
+    INT64U     ticks;
+#if (OS_SCHED_RR_EN == 0) && (OS_SCHED_EDF_EN == 0)
+    INT8U      y;
+#endif
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked                */
+        return (OS_ERR_PEND_LOCKED);
+    }
+    OS_ENTER_CRITICAL();
+    now = OSTickCtr;
+    if (time < now) {                            /* See if the target time has already passed          */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TIME_OVERRUN);
+    }
+    while (time > now) {
+        ticks = time - now;
+        if (ticks > 0xFFFFFFFFu) {               /* Longest delay the tick counter of a TCB can hold   */
+            ticks = 0xFFFFFFFFu;
+        }
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskUnRdy(OSTCBCur);                /* Delay current task                                 */
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskUnRdy(OSTCBCur);               /* Delay current task                                 */
+#else
+        y            =  OSTCBCur->OSTCBY;        /* Delay current task                                 */
+        OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+        }
+#endif
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(OSTCBCur, (INT32U)ticks);  /* Load ticks in TCB and insert in tick list      */
+#else
+        OSTCBCur->OSTCBDly = (INT32U)ticks;      /* Load ticks in TCB                                  */
+#endif
+        OS_EXIT_CRITICAL();
+        OS_Sched();                              /* Find next task to run!                             */
+        OS_ENTER_CRITICAL();
+        now = OSTickCtr;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                         GET CURRENT SYSTEM TIME
 *
 * Description: This function is used by your application to obtain the current value of the 32-bit
@@ -240,6 +402,39 @@ INT32U  OSTimeGet (void)
 }
 #endif
 
+/*
+*********************************************************************************************************
+*                                      GET CURRENT 64-BIT SYSTEM TIME
+*
+* Description: This function is used by your application to obtain the number of clock ticks since
+*              OSInit() as a 64-bit value.  This counter is monotonic: it does not wrap around and is not
+*              changed by OSTimeSet(), so it is the time base for absolute delays (OSTimeDlyUntil()) and,
+*              on the Nios II HAL, for the alarms of alt_alarm_start() as well.
+*
+* Arguments  : none
+*
+* Returns    : The current value of OSTickCtr
+*
+* Note(s)    : 1) The low 32 bits are equal to OSTimeGet() unless OSTimeSet() was called.
+*              2) This function may be called from an ISR.
+*********************************************************************************************************
+*/
+
+INT64U  OSTimeGet64 (void)
+{
+    INT64U     ticks;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ticks = OSTickCtr;                           /* Two loads on a 32-bit CPU, must not be interrupted */
+    OS_EXIT_CRITICAL();
+    return (ticks);
+}
+
 /*
 *********************************************************************************************************
 *                                            SET SYSTEM CLOCK
@@ -249,6 +444,9 @@ INT32U  OSTimeGet (void)
 * Arguments  : ticks      specifies the new value that OSTime needs to take.
 *
 * Returns    : none
+*
+* Note(s)    : 1) The 64-bit monotonic counter of OSTimeGet64() is not changed, so absolute delays (see
+*                 OSTimeDlyUntil()) in progress are not affected.
 *********************************************************************************************************
 */
 
@@ -266,3 +464,150 @@ void  OSTimeSet (INT32U ticks)
     OS_EXIT_CRITICAL();
 }
 #endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      GET THE TIMESTAMP FREQUENCY
+*
+* Description: This function returns the frequency of the timestamps of OSTimeTsGet(), in Hz.  It is the
+*              frequency of the port's cycle counter (OSCPUCyclesGet()), or OS_TICKS_PER_SEC if the port has
+*              none, in which case the timestamps are the ticks of OSTimeGet64().
+*
+* Arguments  : none
+*
+* Returns    : The number of timestamp counts per second.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_TS_EN > 0
+INT32U  OSTimeTsFreq (void)
+{
+    INT32U  freq;
+
+
+    freq = OSCPUCyclesFreq();
+    if (freq == 0L) {                            /* No cycle counter, fall back on the tick counter    */
+        freq = (INT32U)OS_TICKS_PER_SEC;
+    }
+    return (freq);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          GET A 64-BIT TIMESTAMP
+*
+* Description: This function returns a 64-bit timestamp which counts at OSTimeTsFreq() and does not wrap.
+*              It extends the 32-bit cycle counter of the port (OSCPUCyclesGet()), so it is as accurate as
+*              that counter and only costs one read of it in a critical section.  Tasks, ISRs and hooks
+*              that take their timestamps from here all measure time on the same clock, so their
+*              measurements can be correlated.
+*
+* Arguments  : none
+*
+* Returns    : The number of OSTimeTsFreq() counts since the first call.
+*
+* Note(s)    : 1) A wrap of the cycle counter is only seen if the counter is read at least once per
+*                 period of it, about 85 seconds for a 32-bit counter at 50 MHz.  OSTimeTick() reads it
+*                 on every tick; with OS_TICKLESS_EN, the tick must not be suspended for that long.
+*              2) This function may be called from an ISR.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_TS_EN > 0
+INT64U  OSTimeTsGet (void)
+{
+    INT32U     cycles;
+    INT64U     ts;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSCPUCyclesFreq() == 0L) {               /* No cycle counter, count ticks                      */
+        return (OSTimeGet64());
+    }
+    OS_ENTER_CRITICAL();
+    cycles = OSCPUCyclesGet();
+    if (cycles < OSTimeTsLast) {                 /* The counter has wrapped since the last read        */
+        OSTimeTsHi++;
+    }
+    OSTimeTsLast = cycles;
+    ts           = ((INT64U)OSTimeTsHi << 32) | cycles;
+    OS_EXIT_CRITICAL();
+    return (ts);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CONVERT A TIMESTAMP TO NANOSECONDS
+*
+* Description: This function converts a timestamp of OSTimeTsGet(), or the difference of two, to
+*              nanoseconds, at the frequency of OSTimeTsFreq().
+*
+* Arguments  : ts        is the timestamp or interval to convert.
+*
+* Returns    : The number of nanoseconds.
+*
+* Note(s)    : 1) Whole seconds and the rest are converted separately, so that no intermediate result
+*                 overflows before the number of nanoseconds itself does.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_TS_EN > 0
+INT64U  OSTimeTsToNs (INT64U ts)
+{
+    INT64U  freq;
+
+
+    freq = (INT64U)OSTimeTsFreq();
+    return ((ts / freq) * 1000000000L + ((ts % freq) * 1000000000L) / freq);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  GET TICKS UNTIL NEXT DELAY EXPIRES
+*
+* Description: This function is called by the port's idle hook when OS_TICKLESS_EN is enabled to find out
+*              for how many clock ticks OSTimeTick() will have nothing to do.  The port can then stop the
+*              tick interrupt for that long and pass the skipped ticks to OSTimeTickN() on wake up.
+*
+* Arguments  : none
+*
+* Returns    : The number of ticks until the first task delay or pend timeout expires, or
+*              0 if no task is delayed.
+*
+* Note(s)    : 1) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+INT32U  OSTimeTickNext (void)
+{
+#if OS_TICK_LIST_EN > 0
+    if (OSTickList == (OS_TCB *)0) {             /* No task is delayed                                 */
+        return (0L);
+    }
+    return ((INT32U)OSTickList->OSTCBTickDelta); /* First expiry is at the head of the tick list       */
+#else
+    OS_TCB  *ptcb;
+    INT32U   ticks;
+
+
+    ticks = 0L;
+    ptcb  = OSTCBList;
+    while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {   /* Find the smallest delay of all tasks           */
+        if (ptcb->OSTCBDly != 0) {
+            if ((ticks == 0L) || (ptcb->OSTCBDly < ticks)) {
+                ticks = ptcb->OSTCBDly;
+            }
+        }
+        ptcb = ptcb->OSTCBNext;
+    }
+    return (ticks);
+#endif
+}
+#endif
@@ -70,13 +70,13 @@ OS_TMR *VehicleTmr;
 OS_TMR *ControlTmr;
 
 /* Timer Callback Functions */ 
+/* VehicleTmrSem and ControlTmrSem are posted by the timer task, the */
+/* callbacks run later in the lowest priority dispatch task           */
 void VehicleTmrCallback (void *ptmr, void *callback_arg){
-  OSSemPost(VehicleTmrSem);
-  printf("OSSemPost(VehicleTmr);\n");
+  printf("VehicleTmr expired\n");
 }
 void ControlTmrCallback (void *ptmr, void *callback_arg){
-  OSSemPost(ControlTmrSem);
-  printf("OSSemPost(ControlTmr);\n");
+  printf("ControlTmr expired\n");
 }
 
 /*
@@ -384,6 +384,27 @@ void StartTask(void* pdata)
     }
    }
 
+  /*
+   * Creation of Kernel Objects
+   */
+  
+  VehicleTmrSem = OSSemCreate(0);   
+  ControlTmrSem = OSSemCreate(0); 
+
+  /*
+   * Release the periodic tasks directly from the timer task, and leave the
+   * printf() of the callbacks to the lowest priority dispatch task, so a slow
+   * callback does not delay the next release. This is set before the timers
+   * are started, so that no expiry is missed
+   */
+  err = OSTmrDispatchSet(VehicleTmr, OS_TMR_DISP_LEVELS, VehicleTmrSem);
+  if (err != OS_ERR_NONE) {
+    printf("Cannot set the dispatch of VehicleTmr (error %d)\n", err);
+  }
+  err = OSTmrDispatchSet(ControlTmr, OS_TMR_DISP_LEVELS, ControlTmrSem);
+  if (err != OS_ERR_NONE) {
+    printf("Cannot set the dispatch of ControlTmr (error %d)\n", err);
+  }
 
   //start VehicleTask Timer
   OSTmrStart(VehicleTmr, &err);
@@ -403,13 +424,6 @@ void StartTask(void* pdata)
     }
   } 
 
-  /*
-   * Creation of Kernel Objects
-   */
-  
-  VehicleTmrSem = OSSemCreate(0);   
-  ControlTmrSem = OSSemCreate(0); 
-
 
   // Mailboxes
   Mbox_Throttle = OSMboxCreate((void*) 0); /* Empty Mailbox - Throttle */
@@ -60,6 +60,22 @@ extern OS_EVENT *alt_heapsem;
 #define ALT_OS_INT_ENTER OSIntEnter
 #define ALT_OS_INT_EXIT  OSIntExit
 
+/*
+ * The system clock ticks are counted by uC/OS-II (OSTickCtr), so that the 
+ * alarms and the kernel share one 64 bit monotonic time base, see alt_tick.c.
+ */
+
+#define ALT_OS_NTICKS    OSTimeGet64
+
+/*
+ * The ticks skipped in the tickless idle mode are passed to uC/OS-II in one
+ * call, see alt_tick_n().
+ */
+
+#if OS_TICKLESS_EN > 0
+#define ALT_OS_TIME_TICK_N OSTimeTickN
+#endif
+
 #endif /* ALT_ASM_SRC */
 
 /* These macros are used by the VIC funnel assembly code */
@@ -45,16 +45,63 @@ extern "C"
                                        /* ---------------------- MISCELLANEOUS ----------------------- */
 #define OS_APP_HOOKS_EN           1    /* Application-defined hooks are called from the uC/OS-II hooks */
 #define OS_EVENT_MULTI_EN         1    /* Include code for OSEventPendMulti()                          */
+#define OS_IRQ_STATS_EN           0    /* Record per-IRQ service times in alt_irq_handler() (HAL)      */
+
+                                       /* -------------------- DEFERRED ISR POSTS -------------------- */
+#define OS_ISR_POST_DEFERRED_EN   0    /* Queue posts made by ISRs, a kernel task performs them        */
+#define OS_INT_Q_SIZE            16    /*     Nbr of ISR posts that can be pending                     */
+#define OS_TASK_INT_Q_PRIO        1    /*     Priority of the post task, not available to applications */
+#define OS_TASK_INT_Q_STK_SIZE  512    /*     Size of the post task's stack (# of OS_STK entries)      */
+
+                                       /* --------------------- TASK MANAGEMENT ---------------------- */
+#define OS_SCHED_FFS_EN           1    /* Use 32-bit ready lists and count trailing zeros (no table)   */
+#define OS_SCHED_RR_EN            0    /* Allow tasks to share a priority, time sliced round-robin     */
+#define OS_SCHED_RR_QUANTUM      10    /*     Nbr of ticks a task runs before yielding to its peers    */
+#define OS_SCHED_EDF_EN           0    /* Run periodic tasks earliest deadline first (needs RR off)    */
+#define OS_SCHED_EDF_PRIO_HI      5    /*     Highest priority of the band scheduled by deadline       */
+#define OS_SCHED_EDF_PRIO_LO      9    /*     Lowest priority of the band scheduled by deadline        */
+#define OS_TASK_PERIODIC_EN       1    /* Tasks released by the kernel (OSTaskCreatePeriodic())        */
+#define OS_TASK_PROFILE_PERIOD 1000    /* Nbr of ticks per CPU accounting period (OS_TASK_PROFILE_EN)  */
+
+                                       /* --------------------- TIME MANAGEMENT ---------------------- */
+#define OS_TICK_LIST_EN           1    /* Keep delayed tasks in a delta list instead of scanning TCBs  */
+#define OS_TICKLESS_EN            0    /* Stop the tick while idle until the next delay/timer expires  */
+#define OS_TIME_DLY_UNTIL_EN      1    /* Include code for OSTimeDlyUntil() (absolute 64-bit ticks)    */
+#define OS_TIME_TS_EN             1    /* Include code for OSTimeTsGet() (64-bit cycle timestamps)     */
+
+                                       /* --------------------- TIMER MANAGEMENT --------------------- */
+#define OS_TMR_HWHEEL_EN          1    /* Hierarchical timer wheel, a tick only visits expiring timers */
+#define OS_TMR_HWHEEL_BITS        4    /*     log2 of the nbr of spokes per level of the wheel         */
+#define OS_TMR_HWHEEL_LEVELS      4    /*     Nbr of levels, BITS * LEVELS must not exceed 32          */
+#define OS_TMR_STATS_EN           1    /* Keep callback cost and lateness per timer (OSTmrQuery())     */
+#define OS_TMR_DISP_EN            1    /* Callbacks may run in dispatch tasks (OSTmrDispatchSet())     */
+#define OS_TMR_DISP_LEVELS        2    /*     Nbr of dispatch tasks, 1 to 4                            */
+#define OS_TMR_DISP_PRIO_1        3    /*     Priority of the dispatch task of level 1 (urgent)        */
+#define OS_TMR_DISP_PRIO_2       18    /*     Priority of the dispatch task of level 2                 */
+#define OS_TMR_DISP_STK_SIZE    512    /*     Size of each dispatch task's stack (# of OS_STK entries) */
+
+                                       /* -------------------- MEMORY MANAGEMENT --------------------- */
+#define OS_MEM_MSG_EN             1    /* Include code for OSMsgGet()/OSMsgPut() (message blocks)      */
 
                                        /* -------------------- MESSAGE MAILBOXES --------------------- */
 #define OS_MBOX_PEND_ABORT_EN     1    /*     Include code for OSMboxPendAbort()                       */
 
                                        /* ---------------------- MESSAGE QUEUES ---------------------- */
 #define OS_Q_PEND_ABORT_EN        1    /*     Include code for OSQPendAbort()                          */
+#define OS_Q_MULTI_EN             1    /*     Include code for OSQPostMulti()/OSQPendMulti() (batches) */
+
+                                       /* ------------------------ POLL SETS ------------------------- */
+#define OS_POLL_EN                0    /* Include code for OSPollPend() (persistent multi-event waits) */
+
+                                       /* ----------------------- RING BUFFERS ----------------------- */
+#define OS_RING_EN                1    /* Include code for OSRingPut()/OSRingGet() (SPSC ring buffers) */
 
                                        /* ------------------------ SEMAPHORES ------------------------ */
 #define OS_SEM_PEND_ABORT_EN      1    /*    Include code for OSSemPendAbort()                         */
 
+                                       /* ---------------------- STATE CHANNELS ---------------------- */
+#define OS_STATE_EN               1    /* Include code for OSStateWrite()/OSStateRead() (latest value) */
+
                                                                                                                      
 #include "system.h"
 
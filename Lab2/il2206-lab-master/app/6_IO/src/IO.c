@@ -115,15 +115,16 @@ alt_u32 alarm_handler(void* context)
 }
 
 /* Timer Callback Functions */ 
+/* VehicleTmrSem and ControlTmrSem are posted by the timer task, and so */
+/* are ButtonTmrSem and SwitchTmrSem by ControlTmrCallback. The trace   */
+/* printf() of VehicleTmr runs later in the lowest priority dispatch    */
+/* task. ControlTmrCallback runs in the timer task and has no trace.    */
 void VehicleTmrCallback (void *ptmr, void *callback_arg){
-  OSSemPost(VehicleTmrSem);
-  printf("OSSemPost(VehicleTmr);\n");
+  printf("VehicleTmr expired\n");
 }
 void ControlTmrCallback (void *ptmr, void *callback_arg){
-  OSSemPost(ControlTmrSem);
   OSSemPost(ButtonTmrSem);  // Same period, we don't need others timers 
   OSSemPost(SwitchTmrSem);  // Same period, we don't need others timers
-  printf("OSSemPost(ControlTmr);\n");
 }
 
 static int b2sLUT[] = 
@@ -501,6 +502,32 @@ void StartTask(void* pdata)
     }
    }
 
+  /*
+   * Creation of Kernel Objects
+   */
+  
+  VehicleTmrSem = OSSemCreate(0);   
+  ControlTmrSem = OSSemCreate(0); 
+  ButtonTmrSem  = OSSemCreate(0);
+  SwitchTmrSem  = OSSemCreate(0);
+
+  /*
+   * Release the periodic tasks directly from the timer task, and leave the
+   * printf() of VehicleTmrCallback to the lowest priority dispatch task, so a
+   * slow callback does not delay the next release. ControlTmrCallback stays in
+   * the timer task: it releases ButtonIOTask and SwitchIOTask, which have a
+   * higher priority than the dispatch task. This is set before the timers
+   * are started, so that no expiry is missed.
+   */
+  err = OSTmrDispatchSet(VehicleTmr, OS_TMR_DISP_LEVELS, VehicleTmrSem);
+  if (err != OS_ERR_NONE) {
+    printf("Cannot set the dispatch of VehicleTmr (error %d)\n", err);
+  }
+  err = OSTmrDispatchSet(ControlTmr, OS_TMR_DISP_TMR_TASK, ControlTmrSem);
+  if (err != OS_ERR_NONE) {
+    printf("Cannot set the dispatch of ControlTmr (error %d)\n", err);
+  }
+
   /* 
    * Start Software Timers
    */
@@ -523,15 +550,6 @@ void StartTask(void* pdata)
     }
   } 
 
-  /*
-   * Creation of Kernel Objects
-   */
-  
-  VehicleTmrSem = OSSemCreate(0);   
-  ControlTmrSem = OSSemCreate(0); 
-  ButtonTmrSem  = OSSemCreate(0);
-  SwitchTmrSem  = OSSemCreate(0);
-
   // Mailboxes
   Mbox_Throttle = OSMboxCreate((void*) 0); /* Empty Mailbox - Throttle */
   Mbox_Velocity = OSMboxCreate((void*) 0); /* Empty Mailbox - Velocity */
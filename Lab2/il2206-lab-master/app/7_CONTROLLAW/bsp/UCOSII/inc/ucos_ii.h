@@ -69,8 +69,10 @@ extern "C" {
 
 #define  OS_PRIO_SELF              0xFFu                /* Indicate SELF priority                      */
 
-#if OS_TASK_STAT_EN > 0
-#define  OS_N_SYS_TASKS               2u                /* Number of system tasks                      */
+#if   (OS_TASK_STAT_EN > 0) && (OS_ISR_POST_DEFERRED_EN > 0)
+#define  OS_N_SYS_TASKS               3u                /* Number of system tasks                      */
+#elif (OS_TASK_STAT_EN > 0) || (OS_ISR_POST_DEFERRED_EN > 0)
+#define  OS_N_SYS_TASKS               2u
 #else
 #define  OS_N_SYS_TASKS               1u
 #endif
@@ -78,7 +80,10 @@ extern "C" {
 #define  OS_TASK_STAT_PRIO  (OS_LOWEST_PRIO - 1)        /* Statistic task priority                     */
 #define  OS_TASK_IDLE_PRIO  (OS_LOWEST_PRIO)            /* IDLE      task priority                     */
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 32 + 1)  /* Size of event table                         */
+#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 32 + 1)  /* Size of ready table                         */
+#elif OS_LOWEST_PRIO <= 63
 #define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of event table                         */
 #define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of ready table                         */
 #else
@@ -89,11 +94,17 @@ extern "C" {
 #define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat and Timer tasks   */
 #define  OS_TASK_STAT_ID          65534u
 #define  OS_TASK_TMR_ID           65533u
+#define  OS_TASK_INT_Q_ID         65532u
+#define  OS_TASK_TMR_DISP_ID      65531u
 
-#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0))
+#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0) || (OS_STATE_EN > 0) || (OS_POLL_EN > 0))
 
 #define  OS_TCB_RESERVED        ((OS_TCB *)1)
 
+#define  OS_EDF_IX_NONE              255u                /* TCB is not in the deadline heap             */
+                                                               /* See if 'prio' is scheduled by deadline      */
+#define  OS_EDF_PRIO_IN_BAND(prio)   (((prio) >= OS_SCHED_EDF_PRIO_HI) && ((prio) <= OS_SCHED_EDF_PRIO_LO))
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -107,9 +118,11 @@ extern "C" {
 #define  OS_STAT_SUSPEND           0x08u    /* Task is suspended                                       */
 #define  OS_STAT_MUTEX             0x10u    /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG              0x20u    /* Pending on event flag group                             */
+#define  OS_STAT_STATE             0x40u    /* Pending on a new value of a state channel               */
 #define  OS_STAT_MULTI             0x80u    /* Pending on multiple events                              */
+#define  OS_STAT_POLL             0x100u    /* Pending on a poll set                                   */
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | OS_STAT_STATE | OS_STAT_POLL)
 
 /*
 *********************************************************************************************************
@@ -131,6 +144,8 @@ extern "C" {
 #define  OS_EVENT_TYPE_SEM            3u
 #define  OS_EVENT_TYPE_MUTEX          4u
 #define  OS_EVENT_TYPE_FLAG           5u
+#define  OS_EVENT_TYPE_STATE          6u
+#define  OS_EVENT_TYPE_POLL           7u
 
 #define  OS_TMR_TYPE                100u    /* Used to identify Timers ...                             */
                                             /* ... (Must be different value than OS_EVENT_TYPE_xxx)    */
@@ -226,6 +241,8 @@ extern "C" {
 #define  OS_TMR_OPT_CALLBACK          3u    /* OSTmrStop() option to call 'callback' w/ timer arg.     */
 #define  OS_TMR_OPT_CALLBACK_ARG      4u    /* OSTmrStop() option to call 'callback' w/ new   arg.     */
 
+#define  OS_TMR_DISP_TMR_TASK         0u    /* OSTmrDispatchSet() level to call 'callback' in OSTmr_Task() */
+
 /*
 *********************************************************************************************************
 *                                            TIMER STATES
@@ -287,6 +304,8 @@ extern "C" {
 #define OS_ERR_TASK_SUSPEND_IDLE     71u
 #define OS_ERR_TASK_SUSPEND_PRIO     72u
 #define OS_ERR_TASK_WAITING          73u
+#define OS_ERR_TASK_NOT_PERIODIC     74u
+#define OS_ERR_TASK_PERIOD_INVALID   75u
 
 #define OS_ERR_TIME_NOT_DLY          80u
 #define OS_ERR_TIME_INVALID_MINUTES  81u
@@ -294,6 +313,7 @@ extern "C" {
 #define OS_ERR_TIME_INVALID_MS       83u
 #define OS_ERR_TIME_ZERO_DLY         84u
 #define OS_ERR_TIME_DLY_ISR          85u
+#define OS_ERR_TIME_OVERRUN          86u
 
 #define OS_ERR_MEM_INVALID_PART      90u
 #define OS_ERR_MEM_INVALID_BLKS      91u
@@ -331,6 +351,16 @@ extern "C" {
 #define OS_ERR_TMR_INVALID_STATE    141u
 #define OS_ERR_TMR_STOPPED          142u
 #define OS_ERR_TMR_NO_CALLBACK      143u
+#define OS_ERR_TMR_INVALID_LEVEL    144u
+
+#define OS_ERR_INT_Q_FULL           150u
+
+#define OS_ERR_RING_INVALID         160u
+#define OS_ERR_RING_INVALID_SIZE    161u
+#define OS_ERR_RING_NO_SEM          162u
+
+#define OS_ERR_POLL_IN_SET          170u
+#define OS_ERR_POLL_NOT_IN_SET      171u
 
 /*
 *********************************************************************************************************
@@ -390,7 +420,10 @@ typedef struct os_event {
     INT8U    OSEventType;                    /* Type of event control block (see OS_EVENT_TYPE_xxxx)    */
     void    *OSEventPtr;                     /* Pointer to message or queue structure                   */
     INT16U   OSEventCnt;                     /* Semaphore Count (not used if other EVENT type)          */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+    INT32U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+#elif OS_LOWEST_PRIO <= 63
     INT8U    OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
     INT8U    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
 #else
@@ -401,6 +434,10 @@ typedef struct os_event {
 #if OS_EVENT_NAME_SIZE > 1
     INT8U    OSEventName[OS_EVENT_NAME_SIZE];
 #endif
+#if OS_POLL_EN > 0
+    struct os_event *OSEventPoll;            /* Poll set the event is registered in                     */
+    struct os_event *OSEventPollNext;        /* Next event in the poll set's ready ring, NULL if not in */
+#endif
 } OS_EVENT;
 #endif
 
@@ -461,7 +498,10 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 #if OS_MBOX_EN > 0
 typedef struct os_mbox_data {
     void   *OSMsg;                         /* Pointer to message in mailbox                            */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
+    INT32U  OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
+#elif OS_LOWEST_PRIO <= 63
     INT8U   OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
     INT8U   OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
 #else
@@ -498,6 +538,22 @@ typedef struct os_mem_data {
     INT32U  OSNFree;                   /* Number of memory blocks free                                 */
     INT32U  OSNUsed;                   /* Number of memory blocks used                                 */
 } OS_MEM_DATA;
+
+
+#if OS_MEM_MSG_EN > 0
+typedef struct os_msg_hdr {               /* HEADER OF A MESSAGE BLOCK (see OSMsgGet())                */
+    void   *OSMsgLink;                    /* Link of the partition's free list while the block is free */
+    OS_MEM *OSMsgMem;                     /* Partition of the block, NULL while nobody owns it         */
+} OS_MSG_HDR;
+
+                                          /* Size of the block holding a message of 'size' bytes       */
+#define  OS_MSG_BLK_SIZE(size)         ((((INT32U)sizeof(OS_MSG_HDR) + (INT32U)(size) + sizeof(void *) - 1u) \
+                                         / sizeof(void *)) * sizeof(void *))
+                                          /* Nbr of (void *) of storage for OSMsgPoolCreate()          */
+#define  OS_MSG_POOL_SIZE(nmsgs, size) ((nmsgs) * (OS_MSG_BLK_SIZE(size) / sizeof(void *)))
+                                          /* Get a block of the size of 'type', as a pointer to 'type' */
+#define  OS_MSG_NEW(pmem, type, perr)  ((type *)OSMsgGet((pmem), (INT32U)sizeof(type), (perr)))
+#endif
 #endif
 
 /*$PAGE*/
@@ -509,7 +565,10 @@ typedef struct os_mem_data {
 
 #if OS_MUTEX_EN > 0
 typedef struct os_mutex_data {
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT32U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+#elif OS_LOWEST_PRIO <= 63
     INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
     INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
 #else
@@ -544,7 +603,10 @@ typedef struct os_q_data {
     void          *OSMsg;               /* Pointer to next message to be extracted from queue          */
     INT16U         OSNMsgs;             /* Number of messages in message queue                         */
     INT16U         OSQSize;             /* Size of message queue                                       */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U         OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
+    INT32U         OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
+#elif OS_LOWEST_PRIO <= 63
     INT8U          OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
     INT8U          OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
 #else
@@ -554,6 +616,28 @@ typedef struct os_q_data {
 } OS_Q_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                            RING BUFFER DATA
+*********************************************************************************************************
+*/
+
+#if OS_RING_EN > 0
+typedef struct os_ring {                /* SINGLE PRODUCER, SINGLE CONSUMER RING BUFFER                */
+    INT8U           *OSRingBuf;         /* Pointer to storage of the entries                           */
+    INT16U           OSRingSize;        /* Number of entries, a power of 2                             */
+    INT16U           OSRingEntrySize;   /* Size (in bytes) of each entry                               */
+    volatile INT16U  OSRingIn;          /* Nbr of entries put, only written by the producer            */
+    volatile INT16U  OSRingOut;         /* Nbr of entries taken, only written by the consumer          */
+#if OS_SEM_EN > 0
+    OS_EVENT        *OSRingSem;         /* Semaphore posted when the ring becomes non-empty, or NULL   */
+#endif
+} OS_RING;
+
+                                        /* Number of entries in the ring                               */
+#define  OS_RING_ENTRIES(pring)  ((INT16U)((pring)->OSRingIn - (pring)->OSRingOut))
+#endif
+
 /*
 *********************************************************************************************************
 *                                           SEMAPHORE DATA
@@ -563,7 +647,10 @@ typedef struct os_q_data {
 #if OS_SEM_EN > 0
 typedef struct os_sem_data {
     INT16U  OSCnt;                          /* Semaphore count                                         */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT32U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+#elif OS_LOWEST_PRIO <= 63
     INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
     INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
 #else
@@ -573,6 +660,21 @@ typedef struct os_sem_data {
 } OS_SEM_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                           STATE CHANNEL DATA
+*********************************************************************************************************
+*/
+
+#if OS_STATE_EN > 0
+typedef struct os_state {               /* STATE CHANNEL CONTROL BLOCK (see OS_STATE.C)                */
+    INT8U           *OSStateBuf;        /* Pointer to the two copies of the value                      */
+    INT16U           OSStateSize;       /* Size (in bytes) of the value                                */
+    volatile INT32U  OSStateVersion;    /* Nbr of writes completed, copy (version & 1) is the latest   */
+    volatile INT32U  OSStateWrCtr;      /* Nbr of writes started                                       */
+} OS_STATE;
+#endif
+
 /*
 *********************************************************************************************************
 *                                            TASK STACK DATA
@@ -586,6 +688,44 @@ typedef struct os_stk_data {
 } OS_STK_DATA;
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          TASK EXECUTION TIME DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+typedef struct os_cycles_data {
+    INT32U  OSCtxSwCtr;                /* Number of times the task was switched in                     */
+    INT32U  OSCyclesTot;               /* Total number of cycles the task ran (wraps around)           */
+    INT32U  OSCyclesMax;               /* Longest time the task ran without being switched out         */
+    INT32U  OSCyclesPeriod;            /* Number of cycles the task ran in the last accounting period  */
+    INT8U   OSUsage;                   /* ... as a percentage of the period                            */
+} OS_CYCLES_DATA;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         PERIODIC TASK DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+typedef struct os_periodic_data {
+    INT16U  OSPeriod;                  /* Nbr of ticks between two releases                            */
+    INT16U  OSDeadline;                /* Nbr of ticks from a release to the job's deadline            */
+    INT64U  OSRelTime;                 /* Release time of the current (or first) job (in ticks)        */
+    INT32U  OSRelCtr;                  /* Number of jobs released so far                               */
+    INT32U  OSDlMiss;                  /* Number of jobs that completed after their deadline           */
+    INT32U  OSJitterLast;              /* OSTimeTsGet() counts from release to start of current job    */
+    INT32U  OSJitterMax;               /* ... largest value so far                                     */
+    INT32U  OSRespLast;                /* OSTimeTsGet() counts from release to completion of last job  */
+    INT32U  OSRespMax;                 /* ... largest value so far                                     */
+} OS_PERIODIC_DATA;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -626,14 +766,48 @@ typedef struct os_tcb {
     OS_FLAGS         OSTCBFlagsRdy;         /* Event flags that made task ready to run                 */
 #endif
 
-    INT16U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
-    INT8U            OSTCBStat;             /* Task      status                                        */
+    INT32U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
+#if OS_TICK_LIST_EN > 0
+    struct os_tcb   *OSTCBTickNext;         /* Pointer to next     TCB in the tick (delta) list        */
+    struct os_tcb   *OSTCBTickPrev;         /* Pointer to previous TCB in the tick (delta) list        */
+    INT32U           OSTCBTickDelta;        /* Nbr ticks between previous TCB's expiry and this one's  */
+#endif
+#if OS_SCHED_RR_EN > 0
+    struct os_tcb   *OSTCBRRNext;           /* Pointer to next     TCB sharing this task's priority    */
+    struct os_tcb   *OSTCBRRPrev;           /* Pointer to previous TCB sharing this task's priority    */
+    INT16U           OSTCBRRCtr;            /* Nbr ticks left in the task's round-robin time quantum   */
+    BOOLEAN          OSTCBRRRdy;            /* Task is in the ready list (its priority's bit may be    */
+                                            /* ... set on behalf of another task sharing it)           */
+#endif
+#if (OS_SCHED_EDF_EN > 0) || (OS_TASK_PERIODIC_EN > 0)
+    INT64U           OSTCBRelTime;          /* Release time of the current (or first) job (in ticks)   */
+    INT64U           OSTCBDeadline;         /* Absolute deadline of the current job (in ticks)         */
+    INT16U           OSTCBPeriod;           /* Nbr of ticks between two releases, 0 if not periodic    */
+    INT32U           OSTCBDlMiss;           /* Nbr of jobs that completed after their deadline         */
+#endif
+#if OS_SCHED_EDF_EN > 0
+    INT8U            OSTCBEDFIx;            /* Position in the deadline heap, OS_EDF_IX_NONE if absent */
+    INT8U            OSTCBEDFPrio;          /* Priority the task was given (i.e. not one inherited ... */
+                                            /* ... from a mutex), deadline order only applies at it    */
+#endif
+#if OS_TASK_PERIODIC_EN > 0
+    INT64U           OSTCBRelTs;            /* OSTimeTsGet() at the release of the current job         */
+    INT32U           OSTCBRelCtr;           /* Nbr of jobs released so far                             */
+    INT32U           OSTCBJitterLast;       /* Ts counts from release to start of the current job      */
+    INT32U           OSTCBJitterMax;        /* ... largest value so far                                */
+    INT32U           OSTCBRespLast;         /* Ts counts from release to completion of the last job    */
+    INT32U           OSTCBRespMax;          /* ... largest value so far                                */
+#endif
+    INT16U           OSTCBStat;             /* Task      status                                        */
     INT8U            OSTCBStatPend;         /* Task PEND status                                        */
     INT8U            OSTCBPrio;             /* Task priority (0 == highest)                            */
 
     INT8U            OSTCBX;                /* Bit position in group  corresponding to task priority   */
     INT8U            OSTCBY;                /* Index into ready table corresponding to task priority   */
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U           OSTCBBitX;             /* Bit mask to access bit position in ready table          */
+    INT32U           OSTCBBitY;             /* Bit mask to access bit position in ready group          */
+#elif OS_LOWEST_PRIO <= 63
     INT8U            OSTCBBitX;             /* Bit mask to access bit position in ready table          */
     INT8U            OSTCBBitY;             /* Bit mask to access bit position in ready group          */
 #else
@@ -649,6 +823,10 @@ typedef struct os_tcb {
     INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
     INT32U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
     INT32U           OSTCBCyclesStart;      /* Snapshot of cycle counter at start of task resumption   */
+    INT32U           OSTCBCyclesBurst;      /* Cycles already charged to the task since it resumed     */
+    INT32U           OSTCBCyclesMax;        /* Longest time the task ran without being switched out    */
+    INT32U           OSTCBCyclesPeriod;     /* Cycles the task ran in the current accounting period    */
+    INT32U           OSTCBCyclesLast;       /* Cycles the task ran in the last complete period         */
     OS_STK          *OSTCBStkBase;          /* Pointer to the beginning of the task stack              */
     INT32U           OSTCBStkUsed;          /* Number of bytes used from the stack                     */
 #endif
@@ -687,14 +865,82 @@ typedef  struct  os_tmr {
                                                       /*     OS_TMR_STATE_UNUSED                                       */
                                                       /*     OS_TMR_STATE_RUNNING                                      */
                                                       /*     OS_TMR_STATE_STOPPED                                      */
+#if OS_TMR_HWHEEL_EN > 0
+    struct os_tmr_wheel *OSTmrSpoke;                  /* Spoke the timer is linked into while running                  */
+#endif
+#if OS_TMR_STATS_EN > 0
+    INT32U           OSTmrCallCtr;                    /* Nbr of times the callback was invoked                         */
+    INT32U           OSTmrCyclesMax;                  /* Longest callback, in OSCPUCyclesGet() cycles                  */
+    INT64U           OSTmrCyclesTot;                  /* Total time spent in the callback                              */
+    INT32U           OSTmrLateMax;                    /* Longest time from the timer tick to the callback, in cycles   */
+    INT64U           OSTmrLateTot;                    /* Total of these times                                          */
+    INT32U           OSTmrLateTicksMax;               /* Most timer ticks the callback ran after its match             */
+#endif
+#if OS_TMR_DISP_EN > 0
+    INT8U            OSTmrDispLevel;                  /* Dispatch task running the callback, 0 for OSTmr_Task()        */
+    OS_EVENT        *OSTmrDispSem;                    /* Semaphore posted by OSTmr_Task() on expiry, or NULL           */
+    struct os_tmr   *OSTmrDispNext;                   /* Next timer in the queue of the dispatch task                  */
+    INT16U           OSTmrDispCtr;                    /* Nbr of expiries queued for the dispatch task                  */
+#if OS_TMR_STATS_EN > 0
+    INT32U           OSTmrDispTs;                     /* OSTmrSignalTs when the oldest queued expiry was queued        */
+    INT32U           OSTmrDispTime;                   /* OSTmrTime     when the oldest queued expiry was queued        */
+#endif
+#endif
 } OS_TMR;
 
 
 
+typedef struct os_tmr_data {
+    INT32U           OSCallCtr;                       /* Nbr of times the callback was invoked                         */
+    INT32U           OSCyclesMax;                     /* Longest callback, in OSCPUCyclesGet() cycles                  */
+    INT32U           OSCyclesMean;                    /* Mean duration of the callback                                 */
+    INT32U           OSLateMax;                       /* Longest time from the timer tick to the callback, in cycles   */
+    INT32U           OSLateMean;                      /* Mean time from the timer tick to the callback                 */
+    INT32U           OSLateTicksMax;                  /* Most timer ticks the callback ran after its match             */
+} OS_TMR_DATA;
+
+
+
 typedef  struct  os_tmr_wheel {
     OS_TMR          *OSTmrFirst;                      /* Pointer to first timer in linked list                         */
     INT16U           OSTmrEntries;
 } OS_TMR_WHEEL;
+
+
+
+#if OS_TMR_DISP_EN > 0
+typedef  struct  os_tmr_disp {
+    OS_EVENT        *OSDispSem;                       /* Counts the expiries queued for the dispatch task              */
+    OS_TMR          *OSDispFirst;                     /* Queue of timers with expiries to dispatch, oldest first       */
+    OS_TMR          *OSDispLast;
+} OS_TMR_DISP;
+#endif
+
+#if OS_TMR_HWHEEL_EN > 0
+#define  OS_TMR_HWHEEL_SPOKES     (1u << OS_TMR_HWHEEL_BITS)  /* Nbr of spokes per level of the wheel        */
+#define  OS_TMR_HWHEEL_MASK       (OS_TMR_HWHEEL_SPOKES - 1u)
+#define  OS_TMR_WHEEL_TBL_SIZE    (OS_TMR_HWHEEL_SPOKES * OS_TMR_HWHEEL_LEVELS)
+#else
+#define  OS_TMR_WHEEL_TBL_SIZE    OS_TMR_CFG_WHEEL_SIZE
+#endif
+
+#define  OS_TMR_TICK_DIV          ((INT32U)(OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC))  /* Clock ticks per timer tick */
+#endif
+
+/*
+*********************************************************************************************************
+*                                          DEFERRED ISR POSTS
+*********************************************************************************************************
+*/
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+typedef struct os_int_q {
+    void            *OSIntQObj;             /* Pointer to the event control block or event flag group  */
+    void            *OSIntQMsg;             /* Message posted to a mailbox or queue                    */
+    INT32U           OSIntQFlags;           /* Flags posted to an event flag group                     */
+    INT8U            OSIntQType;            /* Type of object posted to (OS_EVENT_TYPE_xxx)            */
+    INT8U            OSIntQOpt;             /* Post options (OS_POST_OPT_xxx, OS_FLAG_SET or _CLR)     */
+} OS_INT_Q;
 #endif
 
 /*$PAGE*/
@@ -724,14 +970,32 @@ OS_EXT  BOOLEAN           OSStatRdy;                /* Flag indicating that the
 OS_EXT  OS_STK            OSTaskStatStk[OS_TASK_STAT_STK_SIZE];      /* Statistics task stack          */
 #endif
 
+#if OS_TASK_PROFILE_EN > 0
+OS_EXT  INT32U            OSCyclesPeriod;           /* Length of the last accounting period in cycles  */
+#endif
+
 OS_EXT  INT8U             OSIntNesting;             /* Interrupt nesting level                         */
 
+#if OS_ISR_POST_DEFERRED_EN > 0
+OS_EXT  OS_INT_Q          OSIntQTbl[OS_INT_Q_SIZE]; /* Posts made by ISRs, waiting for the post task   */
+OS_EXT  OS_INT_Q         *OSIntQIn;                 /* Pointer to where the next ISR post is inserted  */
+OS_EXT  OS_INT_Q         *OSIntQOut;                /* Pointer to the next post to perform             */
+OS_EXT  INT16U            OSIntQEntries;            /* Number of posts pending                         */
+OS_EXT  INT16U            OSIntQEntriesMax;         /* Largest number of posts that were pending       */
+OS_EXT  INT32U            OSIntQOvfCtr;             /* Number of ISR posts lost, the queue was full    */
+OS_EXT  BOOLEAN           OSIntQTaskRdy;            /* Flag indicating that the post task is ready     */
+OS_EXT  OS_STK            OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE];     /* Post task stack                */
+#endif
+
 OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting level                 */
 
 OS_EXT  INT8U             OSPrioCur;                /* Priority of current task                        */
 OS_EXT  INT8U             OSPrioHighRdy;            /* Priority of highest priority task               */
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+OS_EXT  INT32U            OSRdyGrp;                        /* Ready list group                         */
+OS_EXT  INT32U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
+#elif OS_LOWEST_PRIO <= 63
 OS_EXT  INT8U             OSRdyGrp;                        /* Ready list group                         */
 OS_EXT  INT8U             OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
 #else
@@ -755,6 +1019,19 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+#if OS_TICK_LIST_EN > 0
+OS_EXT  OS_TCB           *OSTickList;                      /* Delta list of delayed/timed-out TCBs     */
+#endif
+
+#if OS_SCHED_RR_EN > 0
+OS_EXT  OS_TCB           *OSTCBEventRdy;                   /* TCB readied by last OS_EventTaskRdy()    */
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+OS_EXT  OS_TCB           *OSEDFHeap[OS_MAX_TASKS + OS_N_SYS_TASKS]; /* Ready tasks of EDF band, min-heap*/
+OS_EXT  INT8U             OSEDFHeapCnt;                    /* ... ordered by absolute deadline         */
+#endif
+
 #if OS_TICK_STEP_EN > 0
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
 #endif
@@ -772,11 +1049,18 @@ OS_EXT  OS_Q              OSQTbl[OS_MAX_QS];        /* Table of QUEUE control bl
 #if OS_TIME_GET_SET_EN > 0
 OS_EXT  volatile  INT32U  OSTime;                   /* Current value of system time (in ticks)         */
 #endif
+OS_EXT  volatile  INT64U  OSTickCtr;                /* Nbr of ticks since OSInit(), never wraps or set */
+
+#if OS_TIME_TS_EN > 0
+OS_EXT  INT32U            OSTimeTsLast;             /* OSCPUCyclesGet() at the last OSTimeTsGet()      */
+OS_EXT  INT32U            OSTimeTsHi;               /* Nbr of times OSCPUCyclesGet() has wrapped       */
+OS_EXT  INT64U            OSTickTs;                 /* OSTimeTsGet() at the last OSTimeTick()          */
+#endif
 
 #if OS_TMR_EN > 0
 OS_EXT  INT16U            OSTmrFree;                /* Number of free entries in the timer pool        */
 OS_EXT  INT16U            OSTmrUsed;                /* Number of timers used                           */
-OS_EXT  INT32U            OSTmrTime;                /* Current timer time                              */
+OS_EXT  INT32U            OSTmrTime;                /* Timer ticks handled, OSTimeGet64() / DIV        */
 
 OS_EXT  OS_EVENT         *OSTmrSem;                 /* Sem. used to gain exclusive access to timers    */
 OS_EXT  OS_EVENT         *OSTmrSemSignal;           /* Sem. used to signal the update of timers        */
@@ -785,10 +1069,24 @@ OS_EXT  OS_TMR            OSTmrTbl[OS_TMR_CFG_MAX]; /* Table containing pool of
 OS_EXT  OS_TMR           *OSTmrFreeList;            /* Pointer to free list of timers                  */
 OS_EXT  OS_STK            OSTmrTaskStk[OS_TASK_TMR_STK_SIZE];
 
-OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_CFG_WHEEL_SIZE];
+OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_WHEEL_TBL_SIZE];
+#if OS_TMR_STATS_EN > 0
+OS_EXT  volatile  INT32U  OSTmrSignalTs;            /* OSCPUCyclesGet() at the last OSTmrSignal()      */
+#endif
+
+#if OS_TMR_DISP_EN > 0
+OS_EXT  OS_TMR_DISP       OSTmrDispTbl[OS_TMR_DISP_LEVELS];              /* Queues of the dispatch tasks  */
+OS_EXT  OS_STK            OSTmrDispTaskStk[OS_TMR_DISP_LEVELS][OS_TMR_DISP_STK_SIZE];
+#endif
 #endif
 
+#if OS_SCHED_FFS_EN > 0
+#ifndef  OS_CPU_CNT_TRAIL_ZEROS                     /* Port may provide a count trailing zeros instr.  */
+#define  OS_CPU_CNT_TRAIL_ZEROS(word)  OS_CntTrailZeros(word)
+#endif
+#else
 extern  INT8U   const     OSUnMapTbl[256];          /* Priority->Index    lookup table                 */
+#endif
 
 /*$PAGE*/
 /*
@@ -820,7 +1118,7 @@ void          OSEventNameSet          (OS_EVENT        *pevent,
 INT16U        OSEventPendMulti        (OS_EVENT       **pevents_pend,
                                        OS_EVENT       **pevents_rdy,
                                        void           **pmsgs_rdy,
-                                       INT16U           timeout,
+                                       INT32U           timeout,
                                        INT8U           *perr);
 #endif
 
@@ -863,7 +1161,7 @@ void          OSFlagNameSet           (OS_FLAG_GRP     *pgrp,
 OS_FLAGS      OSFlagPend              (OS_FLAG_GRP     *pgrp,
                                        OS_FLAGS         flags,
                                        INT8U            wait_type,
-                                       INT16U           timeout,
+                                       INT32U           timeout,
                                        INT8U           *perr);
 
 OS_FLAGS      OSFlagPendGetFlagsRdy   (void);
@@ -899,7 +1197,7 @@ OS_EVENT     *OSMboxDel               (OS_EVENT        *pevent,
 #endif
 
 void         *OSMboxPend              (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       INT32U           timeout,
                                        INT8U           *perr);
 
 #if OS_MBOX_PEND_ABORT_EN > 0
@@ -957,6 +1255,19 @@ INT8U         OSMemQuery              (OS_MEM          *pmem,
                                        OS_MEM_DATA     *p_mem_data);
 #endif
 
+#if OS_MEM_MSG_EN > 0
+void         *OSMsgGet                (OS_MEM          *pmem,
+                                       INT32U           size,
+                                       INT8U           *perr);
+
+OS_MEM       *OSMsgPoolCreate         (void            *addr,
+                                       INT32U           nmsgs,
+                                       INT32U           size,
+                                       INT8U           *perr);
+
+INT8U         OSMsgPut                (void            *pmsg);
+#endif
+
 #endif
 
 /*
@@ -982,7 +1293,7 @@ OS_EVENT     *OSMutexDel              (OS_EVENT        *pevent,
 #endif
 
 void          OSMutexPend             (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       INT32U           timeout,
                                        INT8U           *perr);
 
 INT8U         OSMutexPost             (OS_EVENT        *pevent);
@@ -1008,6 +1319,13 @@ void         *OSQAccept               (OS_EVENT        *pevent,
                                        INT8U           *perr);
 #endif
 
+#if OS_Q_MULTI_EN > 0
+INT16U        OSQAcceptMulti          (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           n,
+                                       INT8U           *perr);
+#endif
+
 OS_EVENT     *OSQCreate               (void           **start,
                                        INT16U           size);
 
@@ -1022,9 +1340,17 @@ INT8U         OSQFlush                (OS_EVENT        *pevent);
 #endif
 
 void         *OSQPend                 (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       INT32U           timeout,
                                        INT8U           *perr);
 
+#if OS_Q_MULTI_EN > 0
+INT16U        OSQPendMulti            (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           n,
+                                       INT32U           timeout,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_PEND_ABORT_EN > 0
 INT8U         OSQPendAbort            (OS_EVENT        *pevent,
                                        INT8U            opt,
@@ -1036,6 +1362,13 @@ INT8U         OSQPost                 (OS_EVENT        *pevent,
                                        void            *pmsg);
 #endif
 
+#if OS_Q_MULTI_EN > 0
+INT16U        OSQPostMulti            (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           n,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_FRONT_EN > 0
 INT8U         OSQPostFront            (OS_EVENT        *pevent,
                                        void            *pmsg);
@@ -1054,6 +1387,69 @@ INT8U         OSQQuery                (OS_EVENT        *pevent,
 
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            POLL SET MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if OS_POLL_EN > 0
+INT16U        OSPollAccept            (OS_EVENT        *ppoll,
+                                       OS_EVENT       **pevents_rdy,
+                                       INT16U           n,
+                                       INT8U           *perr);
+
+INT8U         OSPollAdd               (OS_EVENT        *ppoll,
+                                       OS_EVENT        *pevent);
+
+OS_EVENT     *OSPollCreate            (void);
+
+OS_EVENT     *OSPollDel               (OS_EVENT        *ppoll,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+
+INT16U        OSPollPend              (OS_EVENT        *ppoll,
+                                       OS_EVENT       **pevents_rdy,
+                                       INT16U           n,
+                                       INT32U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSPollRemove            (OS_EVENT        *ppoll,
+                                       OS_EVENT        *pevent);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          RING BUFFER MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if OS_RING_EN > 0
+INT8U         OSRingCreate            (OS_RING         *pring,
+                                       void            *pbuf,
+                                       INT16U           size,
+                                       INT16U           entry_size,
+                                       OS_EVENT        *psem);
+
+INT16U        OSRingGet               (OS_RING         *pring,
+                                       void            *pdata,
+                                       INT16U           n);
+
+#if OS_SEM_EN > 0
+INT16U        OSRingPend              (OS_RING         *pring,
+                                       void            *pdata,
+                                       INT16U           n,
+                                       INT32U           timeout,
+                                       INT8U           *perr);
+#endif
+
+INT16U        OSRingPut               (OS_RING         *pring,
+                                       void            *pdata,
+                                       INT16U           n);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1075,7 +1471,7 @@ OS_EVENT     *OSSemDel                (OS_EVENT        *pevent,
 #endif
 
 void          OSSemPend               (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       INT32U           timeout,
                                        INT8U           *perr);
 
 #if OS_SEM_PEND_ABORT_EN > 0
@@ -1099,6 +1495,32 @@ void          OSSemSet                (OS_EVENT        *pevent,
 
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         STATE CHANNEL MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if OS_STATE_EN > 0
+OS_EVENT     *OSStateCreate           (OS_STATE        *pstate,
+                                       void            *pbuf,
+                                       INT16U           size);
+
+INT32U        OSStatePend             (OS_EVENT        *pevent,
+                                       void            *pdata,
+                                       INT32U           version,
+                                       INT32U           timeout,
+                                       INT8U           *perr);
+
+INT32U        OSStateRead             (OS_EVENT        *pevent,
+                                       void            *pdata,
+                                       INT8U           *perr);
+
+INT8U         OSStateWrite            (OS_EVENT        *pevent,
+                                       void            *pdata);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1129,6 +1551,21 @@ INT8U         OSTaskCreateExt         (void           (*task)(void *p_arg),
                                        INT16U           opt);
 #endif
 
+#if OS_TASK_PERIODIC_EN > 0
+INT8U         OSTaskCreatePeriodic    (void           (*task)(void *p_arg),
+                                       void            *p_arg,
+                                       OS_STK          *ptos,
+                                       INT8U            prio,
+                                       INT16U           id,
+                                       OS_STK          *pbos,
+                                       INT32U           stk_size,
+                                       void            *pext,
+                                       INT16U           opt,
+                                       INT16U           period,
+                                       INT16U           phase,
+                                       INT16U           deadline);
+#endif
+
 #if OS_TASK_DEL_EN > 0
 INT8U         OSTaskDel               (INT8U            prio);
 INT8U         OSTaskDelReq            (INT8U            prio);
@@ -1154,6 +1591,23 @@ INT8U         OSTaskStkChk            (INT8U            prio,
                                        OS_STK_DATA     *p_stk_data);
 #endif
 
+#if OS_TASK_PROFILE_EN > 0
+INT8U         OSTaskCyclesGet         (INT8U            prio,
+                                       OS_CYCLES_DATA  *p_cycles_data);
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+INT8U         OSTaskPeriodSet         (INT8U            prio,
+                                       INT16U           period);
+#endif
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U         OSTaskPeriodicGet       (INT8U            prio,
+                                       OS_PERIODIC_DATA *p_periodic_data);
+
+INT8U         OSTaskPeriodWait        (void);
+#endif
+
 #if OS_TASK_QUERY_EN > 0
 INT8U         OSTaskQuery             (INT8U            prio,
                                        OS_TCB          *p_task_data);
@@ -1166,7 +1620,7 @@ INT8U         OSTaskQuery             (INT8U            prio,
 *********************************************************************************************************
 */
 
-void          OSTimeDly               (INT16U           ticks);
+void          OSTimeDly               (INT32U           ticks);
 
 #if OS_TIME_DLY_HMSM_EN > 0
 INT8U         OSTimeDlyHMSM           (INT8U            hours,
@@ -1179,13 +1633,34 @@ INT8U         OSTimeDlyHMSM           (INT8U            hours,
 INT8U         OSTimeDlyResume         (INT8U            prio);
 #endif
 
+#if OS_SCHED_EDF_EN > 0
+INT8U         OSTimeDlyPeriod         (void);
+#endif
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT8U         OSTimeDlyUntil          (INT64U           time);
+#endif
+
 #if OS_TIME_GET_SET_EN > 0
 INT32U        OSTimeGet               (void);
 void          OSTimeSet               (INT32U           ticks);
 #endif
 
+INT64U        OSTimeGet64             (void);
+
+#if OS_TIME_TS_EN > 0
+INT32U        OSTimeTsFreq            (void);
+INT64U        OSTimeTsGet             (void);
+INT64U        OSTimeTsToNs            (INT64U           ts);
+#endif
+
 void          OSTimeTick              (void);
 
+#if OS_TICKLESS_EN > 0
+void          OSTimeTickN             (INT32U           nticks);
+INT32U        OSTimeTickNext          (void);
+#endif
+
 /*
 *********************************************************************************************************
 *                                            TIMER MANAGEMENT
@@ -1224,6 +1699,21 @@ BOOLEAN      OSTmrStop                (OS_TMR          *ptmr,
                                        INT8U           *perr);
 
 INT8U        OSTmrSignal              (void);
+
+#if OS_TMR_DISP_EN > 0
+INT8U        OSTmrDispatchSet         (OS_TMR          *ptmr,
+                                       INT8U            level,
+                                       OS_EVENT        *psem);
+#endif
+
+#if OS_TMR_STATS_EN > 0
+INT8U        OSTmrQuery               (OS_TMR          *ptmr,
+                                       OS_TMR_DATA     *p_tmr_data);
+#endif
+
+#if OS_TICKLESS_EN > 0
+INT32U       OSTmrNextGet             (void);
+#endif
 #endif
 
 /*
@@ -1263,7 +1753,7 @@ void          OS_Dummy                (void);
 #if (OS_EVENT_EN)
 INT8U         OS_EventTaskRdy         (OS_EVENT        *pevent,
                                        void            *pmsg,
-                                       INT8U            msk,
+                                       INT16U           msk,
                                        INT8U            pend_stat);
 
 void          OS_EventTaskWait        (OS_EVENT        *pevent);
@@ -1281,11 +1771,33 @@ void          OS_EventTaskRemoveMulti (OS_TCB          *ptcb,
 void          OS_EventWaitListInit    (OS_EVENT        *pevent);
 #endif
 
+#if OS_ISR_POST_DEFERRED_EN > 0
+void          OS_IntQInit             (void);
+
+INT8U         OS_IntQPost             (INT8U            type,
+                                       void            *pobj,
+                                       void            *pmsg,
+                                       INT32U           flags,
+                                       INT8U            opt);
+
+void          OS_IntQTask             (void            *p_arg);
+#endif
+
 #if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
 void          OS_FlagInit             (void);
 void          OS_FlagUnlink           (OS_FLAG_NODE    *pnode);
 #endif
 
+#if OS_POLL_EN > 0
+void          OS_PollRemove           (OS_EVENT        *pevent);
+
+BOOLEAN       OS_PollSignal           (OS_EVENT        *pevent);
+#endif
+
+#if OS_STATE_EN > 0
+void          OS_StateRdyAll          (OS_EVENT        *pevent);
+#endif
+
 void          OS_MemClr               (INT8U           *pdest,
                                        INT16U           size);
 
@@ -1326,6 +1838,37 @@ void          OS_TaskStkClr           (OS_STK          *pbos,
 void          OS_TaskStatStkChk       (void);
 #endif
 
+#if OS_SCHED_FFS_EN > 0
+INT8U         OS_CntTrailZeros        (INT32U           word);
+#endif
+
+#if OS_TICK_LIST_EN > 0
+void          OS_TickListInsert       (OS_TCB          *ptcb,
+                                       INT32U           ticks);
+
+void          OS_TickListRemove       (OS_TCB          *ptcb);
+#endif
+
+#if OS_SCHED_RR_EN > 0
+void          OS_RRLink               (OS_TCB          *ptcb);
+
+BOOLEAN       OS_RRUnlink             (OS_TCB          *ptcb);
+
+BOOLEAN       OS_RRPrioShare          (INT8U            prio);
+
+void          OS_RRTaskRdy            (OS_TCB          *ptcb);
+
+void          OS_RRTaskUnRdy          (OS_TCB          *ptcb);
+
+void          OS_RRTick               (void);
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+void          OS_EDFTaskRdy           (OS_TCB          *ptcb);
+
+void          OS_EDFTaskUnRdy         (OS_TCB          *ptcb);
+#endif
+
 INT8U         OS_TCBInit              (INT8U            prio,
                                        OS_STK          *ptos,
                                        OS_STK          *pbos,
@@ -1370,10 +1913,26 @@ void          OSTaskSwHook            (void);
 
 void          OSTCBInitHook           (OS_TCB          *ptcb);
 
+#if OS_TICKLESS_EN > 0
+void          OSTicklessExitHook      (void);
+#endif
+
+#if (OS_TIME_TS_EN > 0) || ((OS_TMR_EN > 0) && (OS_TMR_STATS_EN > 0))
+INT32U        OSCPUCyclesGet          (void);
+#endif
+
+#if OS_TIME_TS_EN > 0
+INT32U        OSCPUCyclesFreq         (void);
+#endif
+
 #if OS_TIME_TICK_HOOK_EN > 0
 void          OSTimeTickHook          (void);
 #endif
 
+#if (OS_TICKLESS_EN > 0) && (OS_TIME_TICK_HOOK_EN > 0)
+void          OSTimeTickNHook         (INT32U           nticks);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1527,6 +2086,10 @@ void          OSCtxSw                 (void);
     #ifndef OS_MEM_QUERY_EN
     #error  "OS_CFG.H, Missing OS_MEM_QUERY_EN: Include code for OSMemQuery()"
     #endif
+
+    #ifndef OS_MEM_MSG_EN
+    #error  "OS_CFG.H, Missing OS_MEM_MSG_EN: Include code for OSMsgGet()/OSMsgPut() (message blocks)"
+    #endif
 #endif
 
 /*
@@ -1580,6 +2143,10 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H, Missing OS_Q_FLUSH_EN: Include code for OSQFlush()"
     #endif
 
+    #ifndef OS_Q_MULTI_EN
+    #error  "OS_CFG.H, Missing OS_Q_MULTI_EN: Include code for OSQPostMulti()/OSQPendMulti()/OSQAcceptMulti()"
+    #endif
+
     #ifndef OS_Q_PEND_ABORT_EN
     #error  "OS_CFG.H, Missing OS_Q_PEND_ABORT_EN: Include code for OSQPendAbort()"
     #endif
@@ -1601,6 +2168,34 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                               POLL SETS
+*********************************************************************************************************
+*/
+
+#ifndef OS_POLL_EN
+#error  "OS_CFG.H, Missing OS_POLL_EN: Include code for OSPollPend() (persistent multi-event waits)"
+#else
+    #if     (OS_POLL_EN > 0) && (OS_SEM_EN == 0) && (OS_MBOX_EN == 0) && ((OS_Q_EN == 0) || (OS_MAX_QS == 0))
+    #error  "OS_CFG.H, OS_POLL_EN requires semaphores, mailboxes or queues to poll"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                             RING BUFFERS
+*********************************************************************************************************
+*/
+
+#ifndef OS_RING_EN
+#error  "OS_CFG.H, Missing OS_RING_EN: Include code for OSRingPut()/OSRingGet() (SPSC ring buffers)"
+#else
+    #if     (OS_RING_EN > 0) && !defined(OS_CPU_BARRIER)
+    #error  "OS_CPU.H, Missing OS_CPU_BARRIER(): Compiler barrier needed by the ring buffers"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                              SEMAPHORES
@@ -1631,6 +2226,20 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                            STATE CHANNELS
+*********************************************************************************************************
+*/
+
+#ifndef OS_STATE_EN
+#error  "OS_CFG.H, Missing OS_STATE_EN: Include code for OSStateWrite()/OSStateRead() (latest value)"
+#else
+    #if     (OS_STATE_EN > 0) && !defined(OS_CPU_BARRIER)
+    #error  "OS_CPU.H, Missing OS_CPU_BARRIER(): Compiler barrier needed by the state channels"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TASK MANAGEMENT
@@ -1698,6 +2307,16 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TASK_QUERY_EN: Include code for OSTaskQuery()"
 #endif
 
+#if     OS_TASK_PROFILE_EN > 0
+    #ifndef OS_TASK_PROFILE_PERIOD
+    #error  "OS_CFG.H, Missing OS_TASK_PROFILE_PERIOD: Nbr of ticks per CPU accounting period"
+    #else
+        #if     OS_TASK_PROFILE_PERIOD == 0
+        #error  "OS_CFG.H, OS_TASK_PROFILE_PERIOD must be > 0"
+        #endif
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIME MANAGEMENT
@@ -1720,6 +2339,109 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TIME_GET_SET_EN: Include code for OSTimeGet() and OSTimeSet()"
 #endif
 
+#ifndef OS_TIME_DLY_UNTIL_EN
+#error  "OS_CFG.H, Missing OS_TIME_DLY_UNTIL_EN: Include code for OSTimeDlyUntil()"
+#endif
+
+#ifndef OS_TIME_TS_EN
+#error  "OS_CFG.H, Missing OS_TIME_TS_EN: Include code for OSTimeTsGet() (64-bit cycle timestamps)"
+#endif
+
+#ifndef OS_SCHED_FFS_EN
+#error  "OS_CFG.H, Missing OS_SCHED_FFS_EN: Resolve the highest ready priority with count trailing zeros"
+#endif
+
+#ifndef OS_SCHED_RR_EN
+#error  "OS_CFG.H, Missing OS_SCHED_RR_EN: Allow tasks to share a priority and time slice them round-robin"
+#else
+    #if     OS_SCHED_RR_EN > 0
+        #ifndef OS_SCHED_RR_QUANTUM
+        #error  "OS_CFG.H, Missing OS_SCHED_RR_QUANTUM: Nbr of ticks a task runs before yielding to its peers"
+        #else
+            #if     OS_SCHED_RR_QUANTUM == 0
+            #error  "OS_CFG.H, OS_SCHED_RR_QUANTUM must be > 0"
+            #endif
+        #endif
+    #endif
+#endif
+
+#ifndef OS_SCHED_EDF_EN
+#error  "OS_CFG.H, Missing OS_SCHED_EDF_EN: Run periodic tasks earliest deadline first"
+#else
+    #if     (OS_SCHED_EDF_EN > 0) && (OS_SCHED_RR_EN > 0)
+    #error  "OS_CFG.H, OS_SCHED_EDF_EN and OS_SCHED_RR_EN cannot both be enabled"
+    #endif
+    #if     OS_SCHED_EDF_EN > 0
+        #if     !defined(OS_SCHED_EDF_PRIO_HI) || !defined(OS_SCHED_EDF_PRIO_LO)
+        #error  "OS_CFG.H, Missing OS_SCHED_EDF_PRIO_HI/LO: Band of priorities scheduled by deadline"
+        #elif   (OS_SCHED_EDF_PRIO_HI > OS_SCHED_EDF_PRIO_LO) || (OS_SCHED_EDF_PRIO_LO >= OS_LOWEST_PRIO - 1)
+        #error  "OS_CFG.H, OS_SCHED_EDF_PRIO_HI must be <= OS_SCHED_EDF_PRIO_LO, above the statistic task"
+        #elif   (OS_TMR_EN > 0) && OS_EDF_PRIO_IN_BAND(OS_TASK_TMR_PRIO)
+        #error  "OS_CFG.H, OS_TASK_TMR_PRIO must be outside the EDF band"
+        #elif   (OS_ISR_POST_DEFERRED_EN > 0) && OS_EDF_PRIO_IN_BAND(OS_TASK_INT_Q_PRIO)
+        #error  "OS_CFG.H, OS_TASK_INT_Q_PRIO must be outside the EDF band"
+        #elif   (OS_TMR_EN > 0) && (OS_TMR_DISP_EN > 0) && \
+                (                                     OS_EDF_PRIO_IN_BAND(OS_TMR_DISP_PRIO_1)  || \
+                 ((OS_TMR_DISP_LEVELS > 1) && OS_EDF_PRIO_IN_BAND(OS_TMR_DISP_PRIO_2)) || \
+                 ((OS_TMR_DISP_LEVELS > 2) && OS_EDF_PRIO_IN_BAND(OS_TMR_DISP_PRIO_3)) || \
+                 ((OS_TMR_DISP_LEVELS > 3) && OS_EDF_PRIO_IN_BAND(OS_TMR_DISP_PRIO_4)))
+        #error  "OS_CFG.H, OS_TMR_DISP_PRIO_1..4 must be outside the EDF band"
+        #endif
+    #endif
+#endif
+
+#ifndef OS_TASK_PERIODIC_EN
+#error  "OS_CFG.H, Missing OS_TASK_PERIODIC_EN: Include code for OSTaskCreatePeriodic() and OSTaskPeriodWait()"
+#else
+    #if     (OS_TASK_PERIODIC_EN > 0) && (OS_TASK_CREATE_EXT_EN == 0)
+    #error  "OS_CFG.H, OS_TASK_PERIODIC_EN requires OS_TASK_CREATE_EXT_EN (periodic tasks are created with it)"
+    #endif
+    #if     (OS_TASK_PERIODIC_EN > 0) && (OS_SCHED_LOCK_EN == 0)
+    #error  "OS_CFG.H, OS_TASK_PERIODIC_EN requires OS_SCHED_LOCK_EN"
+    #endif
+    #if     (OS_TASK_PERIODIC_EN > 0) && (OS_TIME_TS_EN == 0)
+    #error  "OS_CFG.H, OS_TASK_PERIODIC_EN requires OS_TIME_TS_EN (jitter and response are timestamped)"
+    #endif
+#endif
+
+#ifndef OS_ISR_POST_DEFERRED_EN
+#error  "OS_CFG.H, Missing OS_ISR_POST_DEFERRED_EN: Queue posts made by ISRs, a kernel task performs them"
+#else
+    #if     OS_ISR_POST_DEFERRED_EN > 0
+        #ifndef OS_INT_Q_SIZE
+        #error  "OS_CFG.H, Missing OS_INT_Q_SIZE: Nbr of ISR posts that can be pending"
+        #else
+            #if     (OS_INT_Q_SIZE < 2) || (OS_INT_Q_SIZE > 65500)
+            #error  "OS_CFG.H, OS_INT_Q_SIZE must be >= 2 and <= 65500"
+            #endif
+        #endif
+        #ifndef OS_TASK_INT_Q_PRIO
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_PRIO: Priority of the post task"
+        #else
+            #if     OS_TASK_INT_Q_PRIO >= OS_TASK_STAT_PRIO
+            #error  "OS_CFG.H, OS_TASK_INT_Q_PRIO must be higher (lower number) than the statistic task's"
+            #endif
+            #if     (OS_TMR_EN > 0) && (OS_TASK_INT_Q_PRIO == OS_TASK_TMR_PRIO)
+            #error  "OS_CFG.H, OS_TASK_INT_Q_PRIO and OS_TASK_TMR_PRIO must be different"
+            #endif
+        #endif
+        #ifndef OS_TASK_INT_Q_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_STK_SIZE: Size of the post task's stack"
+        #endif
+        #if     OS_SCHED_LOCK_EN == 0
+        #error  "OS_CFG.H, OS_ISR_POST_DEFERRED_EN requires OS_SCHED_LOCK_EN (posts are made with the scheduler locked)"
+        #endif
+    #endif
+#endif
+
+#ifndef OS_TICK_LIST_EN
+#error  "OS_CFG.H, Missing OS_TICK_LIST_EN: Keep delayed tasks in a delta list processed by OSTimeTick()"
+#endif
+
+#ifndef OS_TICKLESS_EN
+#error  "OS_CFG.H, Missing OS_TICKLESS_EN: Suppress clock ticks while the idle task runs"
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIMER MANAGEMENT
@@ -1758,6 +2480,98 @@ void          OSCtxSw                 (void);
         #endif
     #endif
 
+    #ifndef OS_TMR_HWHEEL_EN
+    #error  "OS_CFG.H, Missing OS_TMR_HWHEEL_EN: Use a hierarchical timer wheel"
+    #elif   OS_TMR_HWHEEL_EN > 0
+        #ifndef OS_TMR_HWHEEL_BITS
+        #error  "OS_CFG.H, Missing OS_TMR_HWHEEL_BITS: log2 of the nbr of spokes per level of the timer wheel"
+        #endif
+
+        #ifndef OS_TMR_HWHEEL_LEVELS
+        #error  "OS_CFG.H, Missing OS_TMR_HWHEEL_LEVELS: Nbr of levels of the timer wheel"
+        #endif
+
+        #if     (OS_TMR_HWHEEL_BITS < 1) || (OS_TMR_HWHEEL_BITS > 8)
+        #error  "OS_CFG.H, OS_TMR_HWHEEL_BITS should be between 1 and 8"
+        #endif
+
+        #if     (OS_TMR_HWHEEL_LEVELS < 2) || (OS_TMR_HWHEEL_BITS * OS_TMR_HWHEEL_LEVELS > 32)
+        #error  "OS_CFG.H, OS_TMR_HWHEEL_LEVELS should be at least 2 and OS_TMR_HWHEEL_BITS * OS_TMR_HWHEEL_LEVELS <= 32"
+        #endif
+    #endif
+
+    #ifndef OS_TMR_STATS_EN
+    #error  "OS_CFG.H, Missing OS_TMR_STATS_EN: Keep callback statistics per timer (OSTmrQuery())"
+    #endif
+
+    #ifndef OS_TMR_DISP_EN
+    #error  "OS_CFG.H, Missing OS_TMR_DISP_EN: Callbacks may run in dispatch tasks (OSTmrDispatchSet())"
+    #elif   OS_TMR_DISP_EN > 0
+        #ifndef OS_TMR_DISP_LEVELS
+        #error  "OS_CFG.H, Missing OS_TMR_DISP_LEVELS: Nbr of dispatch tasks"
+        #endif
+
+        #if     (OS_TMR_DISP_LEVELS < 1) || (OS_TMR_DISP_LEVELS > 4)
+        #error  "OS_CFG.H, OS_TMR_DISP_LEVELS should be between 1 and 4"
+        #endif
+
+        #ifndef OS_TMR_DISP_PRIO_1
+        #error  "OS_CFG.H, Missing OS_TMR_DISP_PRIO_1: Priority of the dispatch task of level 1"
+        #elif   (OS_TMR_DISP_PRIO_1 >= OS_LOWEST_PRIO) || (OS_TMR_DISP_PRIO_1 == OS_TASK_TMR_PRIO)
+        #error  "OS_CFG.H, OS_TMR_DISP_PRIO_1 must be above the idle task's and differ from OS_TASK_TMR_PRIO"
+        #elif   (OS_TASK_STAT_EN > 0) && (OS_TMR_DISP_PRIO_1 == OS_TASK_STAT_PRIO)
+        #error  "OS_CFG.H, OS_TMR_DISP_PRIO_1 and the statistic task's priority must be different"
+        #elif   (OS_ISR_POST_DEFERRED_EN > 0) && (OS_TMR_DISP_PRIO_1 == OS_TASK_INT_Q_PRIO)
+        #error  "OS_CFG.H, OS_TMR_DISP_PRIO_1 and OS_TASK_INT_Q_PRIO must be different"
+        #endif
+
+        #if     OS_TMR_DISP_LEVELS > 1
+            #ifndef OS_TMR_DISP_PRIO_2
+            #error  "OS_CFG.H, Missing OS_TMR_DISP_PRIO_2: Priority of the dispatch task of level 2"
+            #elif   (OS_TMR_DISP_PRIO_2 >= OS_LOWEST_PRIO) || (OS_TMR_DISP_PRIO_2 == OS_TASK_TMR_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_2 must be above the idle task's and differ from OS_TASK_TMR_PRIO"
+            #elif   (OS_TASK_STAT_EN > 0) && (OS_TMR_DISP_PRIO_2 == OS_TASK_STAT_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_2 and the statistic task's priority must be different"
+            #elif   (OS_ISR_POST_DEFERRED_EN > 0) && (OS_TMR_DISP_PRIO_2 == OS_TASK_INT_Q_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_2 and OS_TASK_INT_Q_PRIO must be different"
+            #elif   (OS_TMR_DISP_PRIO_2 == OS_TMR_DISP_PRIO_1)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_2 must differ from the priorities of the other levels"
+            #endif
+        #endif
+
+        #if     OS_TMR_DISP_LEVELS > 2
+            #ifndef OS_TMR_DISP_PRIO_3
+            #error  "OS_CFG.H, Missing OS_TMR_DISP_PRIO_3: Priority of the dispatch task of level 3"
+            #elif   (OS_TMR_DISP_PRIO_3 >= OS_LOWEST_PRIO) || (OS_TMR_DISP_PRIO_3 == OS_TASK_TMR_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_3 must be above the idle task's and differ from OS_TASK_TMR_PRIO"
+            #elif   (OS_TASK_STAT_EN > 0) && (OS_TMR_DISP_PRIO_3 == OS_TASK_STAT_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_3 and the statistic task's priority must be different"
+            #elif   (OS_ISR_POST_DEFERRED_EN > 0) && (OS_TMR_DISP_PRIO_3 == OS_TASK_INT_Q_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_3 and OS_TASK_INT_Q_PRIO must be different"
+            #elif   (OS_TMR_DISP_PRIO_3 == OS_TMR_DISP_PRIO_1) || (OS_TMR_DISP_PRIO_3 == OS_TMR_DISP_PRIO_2)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_3 must differ from the priorities of the other levels"
+            #endif
+        #endif
+
+        #if     OS_TMR_DISP_LEVELS > 3
+            #ifndef OS_TMR_DISP_PRIO_4
+            #error  "OS_CFG.H, Missing OS_TMR_DISP_PRIO_4: Priority of the dispatch task of level 4"
+            #elif   (OS_TMR_DISP_PRIO_4 >= OS_LOWEST_PRIO) || (OS_TMR_DISP_PRIO_4 == OS_TASK_TMR_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_4 must be above the idle task's and differ from OS_TASK_TMR_PRIO"
+            #elif   (OS_TASK_STAT_EN > 0) && (OS_TMR_DISP_PRIO_4 == OS_TASK_STAT_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_4 and the statistic task's priority must be different"
+            #elif   (OS_ISR_POST_DEFERRED_EN > 0) && (OS_TMR_DISP_PRIO_4 == OS_TASK_INT_Q_PRIO)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_4 and OS_TASK_INT_Q_PRIO must be different"
+            #elif   (OS_TMR_DISP_PRIO_4 == OS_TMR_DISP_PRIO_1) || (OS_TMR_DISP_PRIO_4 == OS_TMR_DISP_PRIO_2) || (OS_TMR_DISP_PRIO_4 == OS_TMR_DISP_PRIO_3)
+            #error  "OS_CFG.H, OS_TMR_DISP_PRIO_4 must differ from the priorities of the other levels"
+            #endif
+        #endif
+
+        #ifndef OS_TMR_DISP_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TMR_DISP_STK_SIZE: Size of each dispatch task's stack"
+        #endif
+    #endif
+
     #ifndef OS_TMR_CFG_NAME_SIZE
     #error  "OS_CFG.H, Missing OS_TMR_CFG_NAME_SIZE: Determines the number of characters used for Timer names"
     #endif
@@ -0,0 +1,204 @@
+/******************************************************************************
+*                                                                             *
+* altera_avalon_timer_hr.c - high resolution timer driver.                    *
+*                                                                             *
+* Drives the timer selected by ALT_HRTIMER_CLK for sys/alt_hrtimer.h. The     *
+* timer runs in continuous mode, with its period set to the time until the    *
+* next expiry. The 64 bit clock is the time at which the counter was last     *
+* loaded plus the cycles counted down since, so the timer never has to be     *
+* stopped while no timer is running.                                          *
+*                                                                             *
+******************************************************************************/
+
+#include "system.h"
+#include "sys/alt_hrtimer.h"
+#include "sys/alt_irq.h"
+
+#include "altera_avalon_timer.h"
+#include "altera_avalon_timer_regs.h"
+
+#include "alt_types.h"
+
+#if (ALT_HRTIMER_CLK_BASE != none_BASE)
+
+/*
+ * Shortest period programmed, in microseconds. The clock is only correct
+ * if the interrupt is served before the counter wraps a second time, so
+ * expiries that are closer together are served by one interrupt, up to
+ * ALT_AVALON_TIMER_HR_MIN_US late.
+ */
+
+#define ALT_AVALON_TIMER_HR_MIN_US 10
+
+/*
+ * "alt_avalon_timer_hr_start" is the value of the clock when the counter
+ * was last loaded, and "alt_avalon_timer_hr_load" the number of cycles in
+ * one period of the counter.
+ */
+
+static void*   alt_avalon_timer_hr_base;
+static alt_u64 alt_avalon_timer_hr_start;
+static alt_u32 alt_avalon_timer_hr_load;
+
+/*
+ * alt_avalon_timer_hr_program() restarts the counter with a period of "load"
+ * cycles at clock value "now". Writing to the period registers stops the
+ * timer and reloads the counter; the few cycles until it is started again
+ * are lost to the clock.
+ */
+
+static void alt_avalon_timer_hr_program (void* base, alt_u64 now, alt_u32 load)
+{
+  alt_avalon_timer_hr_start = now;
+  alt_avalon_timer_hr_load  = load;
+
+  IOWR_ALTERA_AVALON_TIMER_PERIODL (base, (load - 1) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_PERIODH (base, ((load - 1) >> 16) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_STATUS (base, 0);
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (base,
+            ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+            ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+            ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+
+  /*
+   * Dummy read to ensure the IRQ is negated before the interrupt handler
+   * returns, see altera_avalon_timer_sc.c.
+   */
+  IORD_ALTERA_AVALON_TIMER_CONTROL (base);
+}
+
+/*
+ * alt_avalon_timer_hr_count() returns the current value of the down counter.
+ */
+
+static alt_u32 alt_avalon_timer_hr_count (void* base)
+{
+  IOWR_ALTERA_AVALON_TIMER_SNAPL (base, 0);
+
+  return (IORD_ALTERA_AVALON_TIMER_SNAPL (base) & ALTERA_AVALON_TIMER_SNAPL_MSK) |
+         ((IORD_ALTERA_AVALON_TIMER_SNAPH (base) & ALTERA_AVALON_TIMER_SNAPH_MSK) << 16);
+}
+
+/*
+ * If the counter has wrapped since it was loaded, the interrupt is pending.
+ * The counter is read again in that case, because it may have wrapped just
+ * after the first snapshot.
+ */
+
+alt_u64 alt_hrtimer_clock (void)
+{
+  void*   base  = alt_avalon_timer_hr_base;
+  alt_u64 start = alt_avalon_timer_hr_start;
+  alt_u32 count;
+
+  if (base == NULL)
+  {
+    return 0;
+  }
+
+  count = alt_avalon_timer_hr_count (base);
+  if (IORD_ALTERA_AVALON_TIMER_STATUS (base) & ALTERA_AVALON_TIMER_STATUS_TO_MSK)
+  {
+    start += alt_avalon_timer_hr_load;
+    count  = alt_avalon_timer_hr_count (base);
+  }
+
+  return start + alt_avalon_timer_hr_load - 1 - count;
+}
+
+/*
+ * The period is limited to the range of the 32 bit period register; a later
+ * expiry is reached through several interrupts.
+ */
+
+void alt_hrtimer_set (alt_u64 time)
+{
+  void*   base = alt_avalon_timer_hr_base;
+  alt_u64 now;
+  alt_u64 load;
+  alt_u32 min;
+
+  if (base == NULL)
+  {
+    return;
+  }
+
+  now  = alt_hrtimer_clock ();
+  min  = (alt_u32) ((alt_u64) ALT_AVALON_TIMER_HR_MIN_US * _alt_hrtimer_freq / 1000000);
+  load = (time > now) ? time - now : 0;
+
+  if (load < min)
+  {
+    load = min;
+  }
+  else if (load > 0xFFFFFFFF)
+  {
+    load = 0xFFFFFFFF;
+  }
+
+  alt_avalon_timer_hr_program (base, now, (alt_u32) load);
+}
+
+/*
+ * alt_avalon_timer_hr_irq() is the interrupt handler of the timer. Interrupts
+ * are disabled while the callbacks run, as for the system clock alarms.
+ */
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+static void alt_avalon_timer_hr_irq (void* base)
+#else
+static void alt_avalon_timer_hr_irq (void* base, alt_u32 id)
+#endif
+{
+  alt_irq_context cpu_sr;
+
+  cpu_sr = alt_irq_disable_all ();
+  alt_hrtimer_expire ();
+  alt_irq_enable_all (cpu_sr);
+}
+
+/*
+ * alt_avalon_timer_hr_init() is called from the auto-generated alt_sys_init()
+ * function. The timer is started with the longest period, to keep the clock
+ * running until a timer is started.
+ */
+
+void alt_avalon_timer_hr_init (void* base, alt_u32 irq_controller_id,
+                               alt_u32 irq, alt_u32 freq)
+{
+  alt_hrtimer_init (freq);
+
+  alt_avalon_timer_hr_base = base;
+  alt_avalon_timer_hr_program (base, 0, 0xFFFFFFFF);
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+  alt_ic_isr_register (irq_controller_id, irq, alt_avalon_timer_hr_irq,
+                       base, NULL);
+#else
+  alt_irq_register (irq, base, alt_avalon_timer_hr_irq);
+#endif
+}
+
+#else /* ALT_HRTIMER_CLK */
+
+/*
+ * Without a high resolution timer alt_hrtimer_freq() is zero, and
+ * alt_hrtimer_start() fails before it calls these. alt_sys_init() still
+ * refers to alt_avalon_timer_hr_init(), in a branch that is never taken.
+ */
+
+void alt_avalon_timer_hr_init (void* base, alt_u32 irq_controller_id,
+                               alt_u32 irq, alt_u32 freq)
+{
+}
+
+alt_u64 alt_hrtimer_clock (void)
+{
+  return 0;
+}
+
+void alt_hrtimer_set (alt_u64 time)
+{
+}
+
+#endif /* ALT_HRTIMER_CLK */
@@ -3,12 +3,9 @@
 #include "includes.h"
 #include "altera_avalon_pio_regs.h"
 #include "sys/alt_irq.h"
-#include "sys/alt_alarm.h"
 
 #define DEBUG 1
 
-#define HW_TIMER_PERIOD 100 /* 100ms */
-
 /* Button Patterns */
 
 #define GAS_PEDAL_FLAG      0x08
@@ -62,35 +59,41 @@ OS_STK SwitchIO_Stack[TASK_STACKSIZE];
 #define CONTROL_PERIOD  300
 #define VEHICLE_PERIOD  300
 
+// The tasks are released by the kernel, periods are given in clock ticks
+
+#define MS_TO_TICKS(ms) ((ms) * OS_TICKS_PER_SEC / 1000)
+
 /*
  * Definition of Kernel Objects 
 */
 
 // Mailboxes
 OS_EVENT *Mbox_Throttle;
-OS_EVENT *Mbox_Velocity;
-OS_EVENT *Mbox_Velocity_BUTTON;
 
 OS_EVENT *Mbox_Brake;
 OS_EVENT *Mbox_Cruise;
-OS_EVENT *Mbox_Velocity_BUTTON;
 
 OS_EVENT *Mbox_Engine;
 OS_EVENT *Mbox_Gear;
 OS_EVENT *Mbox_Gas;
 //OS_EVENT *Mbox_Reset;
 
-// Semaphores
+// State channels: the latest value, read by any number of tasks
 
-OS_EVENT *VehicleTmrSem;
-OS_EVENT *ControlTmrSem;
-OS_EVENT *ButtonTmrSem;
-OS_EVENT *SwitchTmrSem;
+OS_EVENT *Velocity;          // Written by VehicleTask every period
+OS_STATE  VelocityState;
+INT16S    VelocityCopies[2]; // Two copies of the value, initially 0
 
-// SW-Timer
+// Message pools: values are posted in blocks the receiver owns and releases,
+// never as pointers to the locals of the sender
 
-OS_TMR *VehicleTmr;
-OS_TMR *ControlTmr; // Since they have the same period the callback fuction could be just one (Possiblility to add two other functions)
+#define VELOCITY_MSGS 4  // Mbox_Cruise
+#define THROTTLE_MSGS 4  // Mbox_Throttle
+
+void   *VelocityStorage[OS_MSG_POOL_SIZE(VELOCITY_MSGS, sizeof(INT16S))];
+void   *ThrottleStorage[OS_MSG_POOL_SIZE(THROTTLE_MSGS, sizeof(INT8U))];
+OS_MEM *VelocityPool;
+OS_MEM *ThrottlePool;
 
 /*
  * Types
@@ -108,10 +111,50 @@ enum active cruise_control = off;
  * Global variables
  */
 
-int delay; // Delay of HW-timer 
 INT16U led_green = 0; // Green LEDs
 INT32U led_red = 0;   // Red LEDs
 
+/*
+ * Posts a message block to a mailbox. A message the receiver has not read
+ * yet is released and replaced, so the receiver always reads the latest
+ * value. The block belongs to the receiver once posted.
+ */
+
+void postMsg(OS_EVENT *mbox, void *msg)
+{
+  void *old;
+
+  old = OSMboxAccept(mbox);
+  if (old != NULL)
+    OSMsgPut(old);
+  if (OSMboxPost(mbox, msg) != OS_NO_ERR)
+    OSMsgPut(msg);
+}
+
+void postVelocity(OS_EVENT *mbox, INT16S velocity)
+{
+  INT8U err;
+  INT16S *msg = OS_MSG_NEW(VelocityPool, INT16S, &err);
+
+  if (err == OS_NO_ERR)
+    {
+      *msg = velocity;
+      postMsg(mbox, msg);
+    }
+}
+
+void postThrottle(OS_EVENT *mbox, INT8U throttle)
+{
+  INT8U err;
+  INT8U *msg = OS_MSG_NEW(ThrottlePool, INT8U, &err);
+
+  if (err == OS_NO_ERR)
+    {
+      *msg = throttle;
+      postMsg(mbox, msg);
+    }
+}
+
 int buttons_pressed(void)
 {
   return ~IORD_ALTERA_AVALON_PIO_DATA(D2_PIO_KEYS4_BASE);    
@@ -139,32 +182,6 @@ void change_GREEN_led_status(int mask, int led_values)
   IOWR_ALTERA_AVALON_PIO_DATA(DE2_PIO_GREENLED9_BASE, led_green);
 }
 
-/*
- * ISR for HW Timer
- */
-
-alt_u32 alarm_handler(void* context)
-{
-  OSTmrSignal(); /* Signals a 'tick' to the SW timers */
-  return delay;
-}
-
-/* Timer Callback Functions */ 
-void VehicleTmrCallback (void *ptmr, void *callback_arg)
-{
-  OSSemPost(VehicleTmrSem);
-  if (DEBUG) 
-    printf("OSSemPost(VehicleTmr);\n");
-}
-void ControlTmrCallback (void *ptmr, void *callback_arg)
-{
-  OSSemPost(ControlTmrSem);
-  OSSemPost(ButtonTmrSem);  // Same period, we don't need others timers 
-  OSSemPost(SwitchTmrSem);  // Same period, we don't need others timers
-  if (DEBUG) 
-    printf("OSSemPost(ControlTmr);\n");
-}
-
 static int b2sLUT[] = 
           {0x40, //0
 		       0x79, //1
@@ -322,7 +339,7 @@ void VehicleTask(void* pdata)
 { 
   INT8U err;  
   void* msg;
-  INT8U* throttle; 
+  INT8U throttle = 0; 
   INT8S acceleration;  
   INT8S retardation;   
   INT16U position = 0; 
@@ -334,10 +351,9 @@ void VehicleTask(void* pdata)
 
   while(1)
     {
-      err = OSMboxPost(Mbox_Velocity, (void *) &velocity);
-      err = OSMboxPost(Mbox_Velocity_BUTTON, (void *) &velocity);
+      OSStateWrite(Velocity, &velocity);
 
-      OSSemPend(VehicleTmrSem, 0, &err);
+      OSTaskPeriodWait();
 
       /* Non-blocking read of mailbox: 
 	    - message in mailbox: update throttle
@@ -346,18 +362,21 @@ void VehicleTask(void* pdata)
 
       msg = OSMboxPend(Mbox_Throttle, 1, &err); 
       if (err == OS_NO_ERR) 
-	      throttle = (INT8U*) msg;
+        {
+          throttle = *(INT8U*) msg;
+          OSMsgPut(msg);
+        }
       msg = OSMboxPend(Mbox_Brake, 1, &err); 
       if (err == OS_NO_ERR) 
 	      brake_pedal = (enum active) msg; 
 
       // vehichle cannot effort more than 80 units of throttle
-      if (*throttle > 80) *throttle = 80;
+      if (throttle > 80) throttle = 80;
 
       // brakes + wind
       if (brake_pedal == off)
 	    {
-	      acceleration = (*throttle) - 1*velocity;
+	      acceleration = throttle - 1*velocity;
 
 	      if (400 <= position && position < 800)
 	        acceleration -= 2; // traveling uphill
@@ -374,7 +393,7 @@ void VehicleTask(void* pdata)
       printf("Position: %d m\n", position);
       printf("Velocity: %d m/s\n", velocity);
       printf("Accell: %d m/s2\n", acceleration);
-      printf("Throttle: %d V\n", *throttle);
+      printf("Throttle: %d V\n", throttle);
 
       // position = position + velocity * VEHICLE_PERIOD / 1000;
       //velocity = velocity  + acceleration * VEHICLE_PERIOD / 1000.0;
@@ -401,10 +420,8 @@ void ControlTask(void* pdata)
 
   INT8U throttle = 0; /* Value between 0 and 80, which is interpreted as between 0.0V and 8.0V */
   void* msg;
-  INT16S* current_velocity;
-  INT16S* cruise_velocity;
-  *cruise_velocity  = 0;
-  *current_velocity = 0;
+  INT16S current_velocity = 0;
+  INT16S cruise_velocity = 0;
 
   // Store imputs from the swetches;
   int gas_pedal_tmp=0;
@@ -416,29 +433,32 @@ void ControlTask(void* pdata)
 
   while(1)
     {
-      msg = OSMboxPend(Mbox_Velocity, 1, &err);
-      if (err == OS_NO_ERR)
-         current_velocity = (INT16S*) msg;
+      OSTaskPeriodWait();
+
+      OSStateRead(Velocity, &current_velocity, &err);
        
       msg = OSMboxPend(Mbox_Cruise, 1, &err);
       if (err == OS_NO_ERR)
-        cruise_velocity = (INT16S*) msg;
+        {
+          cruise_velocity = *(INT16S*) msg;
+          OSMsgPut(msg);
+        }
       
       if (DEBUG) 
       {
-        printf("CRUISE VELOCITY: %d \n", *cruise_velocity);
-        printf("CURRENT VELOCITY: %d \n", *current_velocity);
+        printf("CRUISE VELOCITY: %d \n", cruise_velocity);
+        printf("CURRENT VELOCITY: %d \n", current_velocity);
       }
 
       // Use green led to indicate cruise is on
       change_GREEN_led_status(0x1, (cruise_control == on)*0xff & LED_GREEN_0);
       
-      if(*current_velocity < 25 || cruise_control == off)
+      if(current_velocity < 25 || cruise_control == off)
       {
         cruise_control == off;
         show_target_velocity(0);
         
-        if (engine == off && *current_velocity != 0 ){
+        if (engine == off && current_velocity != 0 ){
           engine = on; 
           change_RED_led_status(0x1, LED_RED_0);       
         }
@@ -448,12 +468,12 @@ void ControlTask(void* pdata)
 
       if (cruise_control == on)
       {
-        show_target_velocity(*cruise_velocity);
+        show_target_velocity(cruise_velocity);
         
         // Basic proportional control
-        if( (*cruise_velocity - *current_velocity) > 4 )
+        if( (cruise_velocity - current_velocity) > 4 )
           throttle = throttle + 10;
-        if( (*cruise_velocity - *current_velocity) < 4 )
+        if( (cruise_velocity - current_velocity) < 4 )
           throttle = throttle - 10;
       }
 
@@ -465,9 +485,7 @@ void ControlTask(void* pdata)
         throttle = 40; 
       }
 
-      err = OSMboxPost(Mbox_Throttle, (void *) &throttle);
-      
-      OSSemPend(ControlTmrSem, 0, &err);
+      postThrottle(Mbox_Throttle, throttle);
     }
 }
 
@@ -482,33 +500,34 @@ void ButtonIOTask(void* pdata)
   INT8U err;
   int ButtonState;
   
-  void* msg;
-  INT16S* current_velocity = 0;
+  INT16S current_velocity = 0;
+  INT32U velocity_version = 0;
 
   printf ("ButtonIO Task created!\n");
 
   while (1)
   {
+    OSTaskPeriodWait();
+
     ButtonState = buttons_pressed(); // 1,2,3 considering how many switches are on
     ButtonState = (ButtonState) & 0xf;
     
-    msg = OSMboxPend(Mbox_Velocity_BUTTON, 0, &err);
-    current_velocity = (INT16S*) msg;
+    // Wait for the velocity of the next vehicle period
+    velocity_version = OSStatePend(Velocity, &current_velocity,
+                                   velocity_version, 0, &err);
 
     switch (ButtonState)
       {
         case CRUISE_CONTROL_FLAG:   // Key1 is pressed
 
-          if(top_gear == on && *current_velocity >= 25)
+          if(top_gear == on && current_velocity >= 25)
           {
             if (DEBUG) 
               printf( "CRUISE_CONTROL_FLAG \n");
 
             cruise_control = on;    // start cruise control 
-            int cruise_velocity = *current_velocity;
-
             // Send the cruise velocity to the control task
-            err = OSMboxPost(Mbox_Cruise, (void *) &cruise_velocity);
+            postVelocity(Mbox_Cruise, current_velocity);
 
             change_GREEN_led_status(0x7E, LED_GREEN_2);
           }
@@ -544,20 +563,19 @@ void ButtonIOTask(void* pdata)
             printf("Default state: led, cruise, break, gas remain equals \n");
         break;
       }
-      
-      OSSemPend(ButtonTmrSem, 0, &err);
   }   
 }
 
 void SwitchIOTask(void* pdata)
 {
   int SwitchState;
-  INT8U err;
   INT32U led_interested = 0x3;
   printf ("SwitchIO Task created!\n");
   
   while (1)
    {
+      OSTaskPeriodWait();
+
       SwitchState = (~SwitchState) & 0xf;
       SwitchState = switches_pressed(); // 1,2,3 considering how many switches are on
 
@@ -607,7 +625,6 @@ void SwitchIOTask(void* pdata)
 
         break;
       }
-     OSSemPend(SwitchTmrSem, 0, &err);
    }
 }
     
@@ -619,104 +636,22 @@ void SwitchIOTask(void* pdata)
 void StartTask(void* pdata)
 {
   INT8U err;
-  void* context;
-
-  static alt_alarm alarm;     /* Is needed for timer ISR function */
-  
-  /* Base resolution for SW timer : HW_TIMER_PERIOD ms */
-  delay = alt_ticks_per_second() * HW_TIMER_PERIOD / 1000; 
-  printf("delay in ticks %d\n", delay);
-
-  /* 
-   * Create Hardware Timer with a period of 'delay' 
-   */
-  if (alt_alarm_start (&alarm,
-		                    delay,
-		                    alarm_handler,
-		                    context) < 0)
-  {
-    printf("No system clock available!n");
-  }
-
-  /* 
-   * Create Software Timers
-   */
-
-   //Create VehicleTask Timer
-   VehicleTmr = OSTmrCreate(0, //delay
-                          VEHICLE_PERIOD/HW_TIMER_PERIOD, //period
-                          OS_TMR_OPT_PERIODIC,
-                          VehicleTmrCallback, //OS_TMR_CALLBACK
-                          (void *)0,
-                          "VehicleTmr",
-                          &err);
-                            
-   if (DEBUG) 
-   {
-    if (err == OS_ERR_NONE) 
-    { //if creation successful
-      printf("VehicleTmr created\n");
-    }
-   }
-   
-   //Create ControlTask Timer
-   ControlTmr = OSTmrCreate(0, //delay
-                            CONTROL_PERIOD/HW_TIMER_PERIOD, //period
-                            OS_TMR_OPT_PERIODIC,
-                            ControlTmrCallback, //OS_TMR_CALLBACK
-                            (void *)0,
-                            "ControlTmr",
-                            &err);
-                            
-   if (DEBUG) 
-   {
-    if (err == OS_ERR_NONE) 
-    { //if creation successful
-      printf("ControlTmr created\n");
-    }
-   }
-
-  /* 
-   * Start Software Timers
-   */
-
-  //start VehicleTask Timer
-  OSTmrStart(VehicleTmr, &err);
-   
-  if (DEBUG) 
-  {
-    if (err == OS_ERR_NONE) 
-    { //if start successful
-      printf("VehicleTmr started\n");
-    }
-  }
-
-  //start ControlTask Timer
-  OSTmrStart(ControlTmr, &err);
-   
-  if (DEBUG) 
-  {
-    if (err == OS_ERR_NONE) 
-    { //if start successful
-      printf("ControlTmr started\n");
-    }
-  } 
 
   /*
    * Creation of Kernel Objects
    */
   
-  VehicleTmrSem = OSSemCreate(0);   
-  ControlTmrSem = OSSemCreate(0); 
-  ButtonTmrSem  = OSSemCreate(0);
-  SwitchTmrSem  = OSSemCreate(0);
+  // Message pools
+  VelocityPool = OSMsgPoolCreate(VelocityStorage, VELOCITY_MSGS, sizeof(INT16S), &err);
+  ThrottlePool = OSMsgPoolCreate(ThrottleStorage, THROTTLE_MSGS, sizeof(INT8U), &err);
+
+  // State channels
+  Velocity = OSStateCreate(&VelocityState, VelocityCopies, sizeof(VelocityCopies[0]));
 
   // Mailboxes
   Mbox_Throttle = OSMboxCreate((void*) 0); /* Empty Mailbox - Throttle */
-  Mbox_Velocity = OSMboxCreate((void*) 0); /* Empty Mailbox - Velocity */
   Mbox_Brake    = OSMboxCreate((void*) 0); /* Empty Mailbox - Brake */
   Mbox_Cruise   = OSMboxCreate((void*) 0); /* Empty Mailbox - Cruise */
-  Mbox_Velocity_BUTTON = OSMboxCreate((void*) 0);
   Mbox_Gas = OSMboxCreate((void*) 0);
   Mbox_Gear = OSMboxCreate((void*) 0); /* Empty Mailbox -  Gear*/
   Mbox_Engine = OSMboxCreate((void*) 0); 
@@ -728,11 +663,12 @@ void StartTask(void* pdata)
   OSStatInit();
 
   /* 
-   * Creating Tasks in the system 
+   * Creating Tasks in the system, each one is released by the kernel
+   * at the start of its period (see OSTaskCreatePeriodic())
    */
 
 
-  err = OSTaskCreateExt(
+  err = OSTaskCreatePeriodic(
 			ControlTask, // Pointer to task code
 			NULL,        // Pointer to argument that is
 			// passed to task
@@ -743,9 +679,12 @@ void StartTask(void* pdata)
 			(void *)&ControlTask_Stack[0],
 			TASK_STACKSIZE,
 			(void *) 0,
-			OS_TASK_OPT_STK_CHK);
+			OS_TASK_OPT_STK_CHK,
+			MS_TO_TICKS(CONTROL_PERIOD), // Period
+			0,           // Phase
+			0);          // Deadline (0: end of the period)
 
-  err = OSTaskCreateExt(
+  err = OSTaskCreatePeriodic(
 			VehicleTask, // Pointer to task code
 			NULL,        // Pointer to argument that is
 			// passed to task
@@ -756,9 +695,12 @@ void StartTask(void* pdata)
 			(void *)&VehicleTask_Stack[0],
 			TASK_STACKSIZE,
 			(void *) 0,
-			OS_TASK_OPT_STK_CHK);
+			OS_TASK_OPT_STK_CHK,
+			MS_TO_TICKS(VEHICLE_PERIOD), // Period
+			0,           // Phase
+			0);          // Deadline (0: end of the period)
   
-  err = OSTaskCreateExt(
+  err = OSTaskCreatePeriodic(
 			ButtonIOTask, // Pointer to task code
 			NULL,        // Pointer to argument that is
 			// passed to task
@@ -769,9 +711,12 @@ void StartTask(void* pdata)
 			(void *)&ButtonIO_Stack[0],
 			TASK_STACKSIZE,
 			(void *) 0,
-			OS_TASK_OPT_STK_CHK);
+			OS_TASK_OPT_STK_CHK,
+			MS_TO_TICKS(CONTROL_PERIOD), // Period
+			0,           // Phase
+			0);          // Deadline (0: end of the period)
 
-  err = OSTaskCreateExt(
+  err = OSTaskCreatePeriodic(
 			SwitchIOTask, // Pointer to task code
 			NULL,        // Pointer to argument that is
 			// passed to task
@@ -782,7 +727,10 @@ void StartTask(void* pdata)
 			(void *)&SwitchIO_Stack[0],
 			TASK_STACKSIZE,
 			(void *) 0,
-			OS_TASK_OPT_STK_CHK);
+			OS_TASK_OPT_STK_CHK,
+			MS_TO_TICKS(CONTROL_PERIOD), // Period
+			0,           // Phase
+			0);          // Deadline (0: end of the period)
 
   printf("All Tasks and Kernel Objects generated!\n");
 
@@ -0,0 +1,132 @@
+// File: TickBench.c
+//
+// Measures the cost of one OSTimeTick() call as a function of the number
+// of delayed tasks. Build once with OS_TICK_LIST_EN set to 1 and once with
+// it set to 0 (os_cfg.h) to compare the delta list with the TCB scan.
+
+#include <stdio.h>
+#include <stdint.h>
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+#include "sys/alt_irq.h"
+#include "system.h"
+
+#define BENCH_ITERATIONS   1000   // OSTimeTick() calls per measurement
+#define BENCH_DELAY       30000   // Delay of the sleeping tasks, never expires during a run
+
+/* Definition of Task Stacks */
+/* Stack grows from HIGH to LOW memory */
+#define   TASK_STACKSIZE       2048
+#define   DELAY_STACKSIZE       256
+#define   MAX_DELAY_TASKS        64
+OS_STK    bench_stk[TASK_STACKSIZE];
+OS_STK    delay_stk[MAX_DELAY_TASKS][DELAY_STACKSIZE];
+
+/* Definition of Task Priorities */
+#define BENCH_PRIORITY       4   // highest priority
+#define DELAY_PRIORITY_BASE  5   // delay tasks use 5 .. 5 + MAX_DELAY_TASKS - 1
+
+static const int task_counts[] = { 8, 32, 64 };
+
+/* Sleeps forever, only present to populate the kernel's delay bookkeeping */
+void delayTask(void* pdata)
+{
+  INT16U dly = (INT16U)(uintptr_t)pdata;
+
+  while (1)
+    {
+      OSTimeDly(dly);
+    }
+}
+
+/* Creates more delayed tasks until there are 'count' of them, and returns
+   how many there are. Stops at the first task that cannot be created. */
+int createDelayTasks(int created, int count)
+{
+  INT8U err;
+
+  for (; created < count; created++)
+    {
+      err = OSTaskCreateExt
+        ( delayTask,                                 // Pointer to task code
+          (void *)(uintptr_t)(BENCH_DELAY + 7 * created), // Spread expiries over the delay list
+          &delay_stk[created][DELAY_STACKSIZE-1],    // Pointer to top of task stack
+          DELAY_PRIORITY_BASE + created,             // Desired Task priority
+          DELAY_PRIORITY_BASE + created,             // Task ID
+          &delay_stk[created][0],                    // Pointer to bottom of task stack
+          DELAY_STACKSIZE,                           // Stacksize
+          NULL,                                      // Pointer to user supplied memory (not needed)
+          OS_TASK_OPT_STK_CHK |                      // Stack Checking enabled
+          OS_TASK_OPT_STK_CLR                        // Stack Cleared
+          );
+      if (err != OS_NO_ERR)
+        {
+          printf("Cannot create delay task %d (error %d)\n", created, err);
+          break;
+        }
+    }
+  return created;
+}
+
+/* Times BENCH_ITERATIONS back-to-back ticks with interrupts disabled */
+alt_u64 measureTick(void)
+{
+  alt_irq_context context;
+  int i;
+
+  context = alt_irq_disable_all();
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+      OSTimeTick();
+    }
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  alt_irq_enable_all(context);
+
+  return perf_get_total_time((void *)PERFORMANCE_COUNTER_BASE);
+}
+
+void benchTask(void* pdata)
+{
+  alt_u64 cycles;
+  int created = 0;
+  int n;
+
+  printf("TickBench: OS_TICK_LIST_EN=%d, %d ticks per sample\n",
+         OS_TICK_LIST_EN, BENCH_ITERATIONS);
+  printf("tasks,cycles_per_tick,us_per_tick\n");
+  for (n = 0; n < sizeof(task_counts) / sizeof(task_counts[0]); n++)
+    {
+      created = createDelayTasks(created, task_counts[n]);
+      if (created < task_counts[n])
+        break;
+      OSTimeDly(2);                  // Let all delay tasks run and go to sleep
+
+      cycles = measureTick() / BENCH_ITERATIONS;
+      printf("%d,%lu,%lu\n", created, (unsigned long)cycles,
+             (unsigned long)(cycles / (ALT_CPU_FREQ / 1000000)));
+    }
+  OSTaskDel(OS_PRIO_SELF);
+}
+
+int main(void)
+{
+  printf("Lab - Tick benchmark\n");
+
+  OSTaskCreateExt
+    ( benchTask,                    // Pointer to task code
+      NULL,                         // Pointer to argument passed to task
+      &bench_stk[TASK_STACKSIZE-1], // Pointer to top of task stack
+      BENCH_PRIORITY,               // Desired Task priority
+      BENCH_PRIORITY,               // Task ID
+      &bench_stk[0],                // Pointer to bottom of task stack
+      TASK_STACKSIZE,               // Stacksize
+      NULL,                         // Pointer to user supplied memory (not needed)
+      OS_TASK_OPT_STK_CHK |         // Stack Checking enabled
+      OS_TASK_OPT_STK_CLR           // Stack Cleared
+      );
+
+  OSStart();
+  return 0;
+}
@@ -25,20 +25,24 @@
  * Altera does not recommend, suggest or require that this reference design 
  * file be used in conjunction or combination with any other product.
  *
- * alt_busy_sleep.c - Microsecond delay routine which uses a calibrated busy
- *                    loop to perform the delay. This is used to implement
- *                    usleep for both uC/OS-II and the standalone HAL.  
+ * alt_busy_sleep.c - Microsecond delay routine which spins on the free
+ *                    running timestamp timer, or on a calibrated busy loop
+ *                    when there is none. This is used to implement usleep
+ *                    for both uC/OS-II and the standalone HAL.
  *
  * Author PRR
  *
- * Calibrated delay with no timer required
- * 
- * The ASM instructions in the routine are equivalent to 
+ * The busy loop
  *
- * for (i=0;i<us*(ALT_CPU_FREQ/3);i++);
- * 
- * and takes three cycles each time around the loop
+ * for (i=0;i<loops;i++);
  *
+ * takes three cycles each time around on a "fast" or "standard" core and nine
+ * on a "tiny" one, but caches and memory latency change that. When a
+ * timestamp timer is selected, its driver calls alt_busy_sleep_calibrate() at
+ * boot, which measures the loop and the cost of reading the timer. Delays are
+ * then counted on the timer itself, and only fall back to the loop if the
+ * timer has been stopped, e.g. by alt_timestamp_start() running it to the end
+ * of its period.
  */
 
 #include <limits.h>
@@ -46,56 +50,42 @@
 
 #include "system.h"
 #include "alt_types.h"
+#include "sys/alt_irq.h"
+#include "sys/alt_timestamp.h"
 
 #include "priv/alt_busy_sleep.h"
 
-unsigned int alt_busy_sleep (unsigned int us)
-{
 /*
- * Only delay if ALT_SIM_OPTIMIZE is not defined; i.e., if software
- * is built targetting ModelSim RTL simulation, the delay will be
- * skipped to speed up simulation.
+ * Number of loops and runs used by alt_busy_sleep_calibrate(). The shortest
+ * run is kept, the others may include a cache miss.
  */
-#ifndef ALT_SIM_OPTIMIZE
-  int i;
-  int big_loops;
-  alt_u32 cycles_per_loop;
-  
-  if (!strcmp(NIOS2_CPU_IMPLEMENTATION,"tiny"))
-  {
-    cycles_per_loop = 9;
-  }
-  else  
-  {
-    cycles_per_loop = 3;
-  }
-  
 
-  big_loops = us / (INT_MAX/
-  (ALT_CPU_FREQ/(cycles_per_loop * 1000000)));
+#define ALT_BUSY_SLEEP_CAL_LOOPS 1000
+#define ALT_BUSY_SLEEP_CAL_RUNS  4
 
-  if (big_loops)
-  {
-    for(i=0;i<big_loops;i++)
-    {
-      /*
-      * Do NOT Try to single step the asm statement below 
-      * (single step will never return)
-      * Step out of this function or set a breakpoint after the asm statements
-      */
-      __asm__ volatile (
-        "\n0:"
-        "\n\taddi %0,%0, -1"
-        "\n\tbne %0,zero,0b"
-        "\n1:"
-        "\n\t.pushsection .debug_alt_sim_info"
-        "\n\t.int 4, 0, 0b, 1b"
-        "\n\t.popsection"
-        :: "r" (INT_MAX));
-      us -= (INT_MAX/(ALT_CPU_FREQ/
-      (cycles_per_loop * 1000000)));
-    }
+/*
+ * "alt_busy_sleep_loops" is the number of times around the busy loop per
+ * microsecond, in units of 1/65536, zero until it is first needed or
+ * measured.
+ *
+ * "alt_busy_sleep_ts_freq" is the frequency of the timestamp timer once it
+ * has been calibrated, and zero while delays use the busy loop.
+ * "alt_busy_sleep_ts_cost" is the number of timer cycles taken by one
+ * alt_timestamp() call.
+ */
+
+static alt_u32 alt_busy_sleep_loops   = 0;
+static alt_u32 alt_busy_sleep_ts_freq = 0;
+static alt_u32 alt_busy_sleep_ts_cost = 0;
+
+/*
+ * alt_busy_sleep_loop() goes "loops" times around the busy loop.
+ */
 
+static void alt_busy_sleep_loop (alt_u32 loops)
+{
+  if (loops)
+  {
     /*
     * Do NOT Try to single step the asm statement below 
     * (single step will never return)
@@ -109,25 +99,175 @@ unsigned int alt_busy_sleep (unsigned int us)
       "\n\t.pushsection .debug_alt_sim_info"
       "\n\t.int 4, 0, 0b, 1b"
       "\n\t.popsection"
-      :: "r" (us*(ALT_CPU_FREQ/(cycles_per_loop * 1000000))));
+      : "+r" (loops));
   }
-  else
+}
+
+/*
+ * alt_busy_sleep_loop_us() delays for "us" microseconds in the busy loop.
+ * Without a calibration, the speed of the loop is estimated from the CPU
+ * frequency.
+ */
+
+static void alt_busy_sleep_loop_us (alt_u32 us)
+{
+  alt_u64 loops;
+  alt_u32 cycles_per_loop;
+
+  if (!alt_busy_sleep_loops)
   {
-    /*
-    * Do NOT Try to single step the asm statement below 
-    * (single step will never return)
-    * Step out of this function or set a breakpoint after the asm statements
-    */
-    __asm__ volatile (
-      "\n0:"
-      "\n\taddi %0,%0, -1"
-      "\n\tbgt %0,zero,0b"
-      "\n1:"
-      "\n\t.pushsection .debug_alt_sim_info"
-      "\n\t.int 4, 0, 0b, 1b"
-      "\n\t.popsection"
-      :: "r" (us*(ALT_CPU_FREQ/(cycles_per_loop * 1000000))));
+    if (!strcmp(NIOS2_CPU_IMPLEMENTATION,"tiny"))
+    {
+      cycles_per_loop = 9;
+    }
+    else  
+    {
+      cycles_per_loop = 3;
+    }
+    alt_busy_sleep_loops = (alt_u32) (((alt_u64) ALT_CPU_FREQ << 16) /
+                                      (cycles_per_loop * 1000000));
+  }
+
+  loops = ((alt_u64) us * alt_busy_sleep_loops) >> 16;
+  while (loops > UINT_MAX)
+  {
+    alt_busy_sleep_loop (UINT_MAX);
+    loops -= UINT_MAX;
+  }
+  alt_busy_sleep_loop ((alt_u32) loops);
+}
+
+#if (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+
+/*
+ * alt_busy_sleep_ts() delays for "us" microseconds on the timestamp timer.
+ * It returns as soon as less than one read of the timer is left, so that
+ * the delay ends within half a read of the deadline on average. If two
+ * reads return the same value, while a read takes at least one timer cycle,
+ * the timer has stopped; the number of microseconds still to wait is then
+ * returned.
+ */
+
+static alt_u32 alt_busy_sleep_ts (alt_u32 us)
+{
+  alt_u64 left;
+  alt_u32 last;
+  alt_u32 now;
+  alt_u32 step;
+
+  last = (alt_u32) alt_timestamp ();
+  left = (alt_u64) us * alt_busy_sleep_ts_freq / 1000000;
+
+  while (left > alt_busy_sleep_ts_cost)
+  {
+    now  = (alt_u32) alt_timestamp ();
+    step = now - last;
+    if (!step && alt_busy_sleep_ts_cost)
+    {
+      return (alt_u32) (left * 1000000 / alt_busy_sleep_ts_freq);
+    }
+    last = now;
+    left = (step < left) ? left - step : 0;
+  }
+  return 0;
+}
+
+#endif /* ALT_TIMESTAMP_CLK_BASE */
+
+void alt_busy_sleep_calibrate (void)
+{
+#if (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+  alt_irq_context context;
+  alt_u32 freq;
+  alt_u32 t0, t1, t2;
+  alt_u32 cost = UINT_MAX;
+  alt_u32 loop = UINT_MAX;
+  int i;
+
+  freq = alt_timestamp_freq ();
+  if (!freq)
+  {
+    return;
+  }
+
+  context = alt_irq_disable_all ();
+  for (i = 0; i < ALT_BUSY_SLEEP_CAL_RUNS; i++)
+  {
+    t0 = (alt_u32) alt_timestamp ();
+    t1 = (alt_u32) alt_timestamp ();
+    alt_busy_sleep_loop (ALT_BUSY_SLEEP_CAL_LOOPS);
+    t2 = (alt_u32) alt_timestamp ();
+    if (t1 - t0 < cost)
+    {
+      cost = t1 - t0;
+    }
+    if (t2 - t1 < loop)
+    {
+      loop = t2 - t1;
+    }
+  }
+  alt_irq_enable_all (context);
+
+  /*
+   * The loop was timed with one read of the timer; if nothing is left, the
+   * timer is not running and the estimate from the CPU frequency is kept.
+   */
+
+  if (loop <= cost)
+  {
+    return;
+  }
+  loop -= cost;
+
+  alt_busy_sleep_loops   = (alt_u32) ((((alt_u64) ALT_BUSY_SLEEP_CAL_LOOPS *
+                                        freq) << 16) /
+                                      ((alt_u64) loop * 1000000));
+  alt_busy_sleep_ts_cost = cost;
+  alt_busy_sleep_ts_freq = freq;
+#endif /* ALT_TIMESTAMP_CLK_BASE */
+}
+
+int alt_busy_sleep_timed (void)
+{
+  return alt_busy_sleep_ts_freq != 0;
+}
+
+alt_u32 alt_busy_sleep_stamp (void)
+{
+#if (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+  if (alt_busy_sleep_ts_freq)
+  {
+    return (alt_u32) alt_timestamp ();
+  }
+#endif
+  return 0;
+}
+
+alt_u32 alt_busy_sleep_elapsed (alt_u32 stamp)
+{
+  if (!alt_busy_sleep_ts_freq)
+  {
+    return 0;
+  }
+  return (alt_u32) ((alt_u64) (alt_busy_sleep_stamp () - stamp) * 1000000 /
+                    alt_busy_sleep_ts_freq);
+}
+
+unsigned int alt_busy_sleep (unsigned int us)
+{
+/*
+ * Only delay if ALT_SIM_OPTIMIZE is not defined; i.e., if software
+ * is built targetting ModelSim RTL simulation, the delay will be
+ * skipped to speed up simulation.
+ */
+#ifndef ALT_SIM_OPTIMIZE
+#if (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+  if (alt_busy_sleep_ts_freq)
+  {
+    us = alt_busy_sleep_ts (us);
   }
+#endif
+  alt_busy_sleep_loop_us (us);
 #endif /* #ifndef ALT_SIM_OPTIMIZE */
   return 0;
 }
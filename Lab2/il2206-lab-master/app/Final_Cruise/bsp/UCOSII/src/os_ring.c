@@ -0,0 +1,289 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                SINGLE PRODUCER, SINGLE CONSUMER RING BUFFERS
+*
+* File    : OS_RING.C
+* Version : V2.86
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_RING_EN > 0
+/*
+*********************************************************************************************************
+*                                                 NOTES
+*
+* 1) An OS_RING carries fixed size entries from exactly one producer to exactly one consumer, for example
+*    from an ISR to a task.  OSRingIn is only written by the producer and OSRingOut only by the consumer,
+*    each with a single store, so neither side disables interrupts or locks the scheduler.  A second
+*    producer or consumer needs a lock of its own around its calls.
+*
+* 2) Both indices count entries since the ring was created and are allowed to wrap.  Because OSRingSize
+*    is a power of 2, (OSRingIn - OSRingOut) is the number of entries in the ring and (index & mask) the
+*    position of an entry, even after a wrap.
+*
+* 3) OS_CPU_BARRIER() keeps the compiler from moving the copy of the entries across the load or store of
+*    an index.  The Nios II has a single in order core, so no instruction barrier is needed.
+*
+* 4) The semaphore given to OSRingCreate() is only posted when OSRingPut() finds that the consumer has
+*    taken all earlier entries, i.e. when the ring goes from empty to not empty, not for every entry.
+*    OSRingPend() therefore always empties the ring with OSRingGet() before it waits on the semaphore.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           CREATE A RING BUFFER
+*
+* Description: This function initializes a ring buffer of 'size' entries of 'entry_size' bytes each, in
+*              storage provided by the application.
+*
+* Arguments  : pring        is a pointer to the ring buffer to initialize.
+*
+*              pbuf         is a pointer to the storage of the entries, at least size * entry_size bytes.
+*
+*              size         is the number of entries, a power of 2.
+*
+*              entry_size   is the size (in bytes) of each entry.  size * entry_size must be <= 65535.
+*
+*              psem         is a pointer to a semaphore created with a count of 0 that is posted when the
+*                           ring goes from empty to not empty, or a NULL pointer if the consumer never calls
+*                           OSRingPend().
+*
+* Returns    : OS_ERR_NONE               The call was successful
+*              OS_ERR_RING_INVALID       'pring' is a NULL pointer
+*              OS_ERR_PDATA_NULL         'pbuf' is a NULL pointer
+*              OS_ERR_RING_INVALID_SIZE  'size' is not a power of 2, 'entry_size' is 0 or the storage is
+*                                        larger than 65535 bytes
+*              OS_ERR_EVENT_TYPE         'psem' is not pointing to a semaphore
+*
+* Note(s)    : The ring must not be used by the producer or the consumer while it is being created.
+*********************************************************************************************************
+*/
+
+INT8U  OSRingCreate (OS_RING *pring, void *pbuf, INT16U size, INT16U entry_size, OS_EVENT *psem)
+{
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                      /* Validate arguments                                */
+        return (OS_ERR_RING_INVALID);
+    }
+    if (pbuf == (void *)0) {
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if ((size == 0) || ((size & (size - 1)) != 0)) {  /* Number of entries must be a power of 2            */
+        return (OS_ERR_RING_INVALID_SIZE);
+    }
+    if ((entry_size == 0) || ((INT32U)size * entry_size > 65535L)) {
+        return (OS_ERR_RING_INVALID_SIZE);            /* OS_MemCopy() copies up to 64K bytes               */
+    }
+#if OS_SEM_EN > 0
+    if (psem != (OS_EVENT *)0) {
+        if (psem->OSEventType != OS_EVENT_TYPE_SEM) {
+            return (OS_ERR_EVENT_TYPE);
+        }
+    }
+    pring->OSRingSem       = psem;
+#endif
+    pring->OSRingBuf       = (INT8U *)pbuf;
+    pring->OSRingSize      = size;
+    pring->OSRingEntrySize = entry_size;
+    pring->OSRingIn        = 0;
+    pring->OSRingOut       = 0;
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     PUT ENTRIES INTO A RING BUFFER
+*
+* Description: This function copies up to 'n' entries into a ring buffer.  It is called by the producer
+*              only, from a task or an ISR.
+*
+* Arguments  : pring        is a pointer to the ring buffer.
+*
+*              pdata        is a pointer to the entries to copy, n * OSRingEntrySize bytes.
+*
+*              n            is the number of entries to put.
+*
+* Returns    : The number of entries put, less than 'n' if the ring is full.
+*
+* Note(s)    : The semaphore of the ring is posted if the consumer had taken all earlier entries.
+*********************************************************************************************************
+*/
+
+INT16U  OSRingPut (OS_RING *pring, void *pdata, INT16U n)
+{
+    INT16U  in;
+    INT16U  ix;
+    INT16U  nfree;
+    INT16U  nfirst;
+    INT16U  esize;
+    INT8U  *psrc;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                      /* Validate 'pring'                                  */
+        return (0);
+    }
+#endif
+    in    = pring->OSRingIn;
+    nfree = pring->OSRingSize - (INT16U)(in - pring->OSRingOut);
+    OS_CPU_BARRIER();                                 /* Read the consumer's index before the slots        */
+    if (n > nfree) {
+        n = nfree;
+    }
+    if (n == 0) {
+        return (0);
+    }
+    esize  = pring->OSRingEntrySize;
+    ix     = in & (pring->OSRingSize - 1);
+    nfirst = pring->OSRingSize - ix;                  /* Entries up to the end of the storage              */
+    if (nfirst > n) {
+        nfirst = n;
+    }
+    psrc   = (INT8U *)pdata;
+    OS_MemCopy(pring->OSRingBuf + ix * esize, psrc, nfirst * esize);
+    if (n > nfirst) {                                 /* Wrap around to the start of the storage           */
+        OS_MemCopy(pring->OSRingBuf, psrc + nfirst * esize, (n - nfirst) * esize);
+    }
+    OS_CPU_BARRIER();                                 /* Write the entries before publishing them          */
+    pring->OSRingIn = in + n;
+#if OS_SEM_EN > 0
+    if (pring->OSRingSem != (OS_EVENT *)0) {
+        if (pring->OSRingOut == in) {                 /* Ring was empty, the consumer may be waiting       */
+            (void)OSSemPost(pring->OSRingSem);
+        }
+    }
+#endif
+    return (n);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     GET ENTRIES FROM A RING BUFFER
+*
+* Description: This function copies up to 'n' entries out of a ring buffer without waiting.  It is called
+*              by the consumer only, from a task or an ISR.
+*
+* Arguments  : pring        is a pointer to the ring buffer.
+*
+*              pdata        is a pointer to where the entries are copied, n * OSRingEntrySize bytes.
+*
+*              n            is the maximum number of entries to get.
+*
+* Returns    : The number of entries copied, 0 if the ring is empty.
+*********************************************************************************************************
+*/
+
+INT16U  OSRingGet (OS_RING *pring, void *pdata, INT16U n)
+{
+    INT16U  out;
+    INT16U  ix;
+    INT16U  nused;
+    INT16U  nfirst;
+    INT16U  esize;
+    INT8U  *pdest;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                      /* Validate 'pring'                                  */
+        return (0);
+    }
+#endif
+    out   = pring->OSRingOut;
+    nused = (INT16U)(pring->OSRingIn - out);
+    OS_CPU_BARRIER();                                 /* Read the producer's index before the entries      */
+    if (n > nused) {
+        n = nused;
+    }
+    if (n == 0) {
+        return (0);
+    }
+    esize  = pring->OSRingEntrySize;
+    ix     = out & (pring->OSRingSize - 1);
+    nfirst = pring->OSRingSize - ix;                  /* Entries up to the end of the storage              */
+    if (nfirst > n) {
+        nfirst = n;
+    }
+    pdest  = (INT8U *)pdata;
+    OS_MemCopy(pdest, pring->OSRingBuf + ix * esize, nfirst * esize);
+    if (n > nfirst) {                                 /* Wrap around to the start of the storage           */
+        OS_MemCopy(pdest + nfirst * esize, pring->OSRingBuf, (n - nfirst) * esize);
+    }
+    OS_CPU_BARRIER();                                 /* Read the entries before freeing their slots       */
+    pring->OSRingOut = out + n;
+    return (n);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   WAIT FOR ENTRIES IN A RING BUFFER
+*
+* Description: This function copies up to 'n' entries out of a ring buffer, waiting on the semaphore of
+*              the ring while it is empty.  It is called by the consumer task only.
+*
+* Arguments  : pring        is a pointer to the ring buffer.
+*
+*              pdata        is a pointer to where the entries are copied, n * OSRingEntrySize bytes.
+*
+*              n            is the maximum number of entries to get.
+*
+*              timeout      is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                           wait for entries up to the amount of time specified by this argument.  If you
+*                           specify 0, however, your task will wait forever.
+*
+*              perr         is a pointer to where an error message will be deposited.  Possible error
+*                           messages are:
+*
+*                           OS_ERR_NONE          At least one entry was copied
+*                           OS_ERR_RING_INVALID  'pring' is a NULL pointer
+*                           OS_ERR_RING_NO_SEM   The ring was created without a semaphore
+*                           OS_ERR_TIMEOUT       The ring stayed empty for 'timeout' ticks
+*                           ...                  Any other error returned by OSSemPend()
+*
+* Returns    : The number of entries copied, 0 on an error.
+*
+* Note(s)    : 1) The semaphore may have been posted for entries that an earlier call already took.  The
+*                 function then finds the ring still empty and waits again.
+*********************************************************************************************************
+*/
+
+#if OS_SEM_EN > 0
+INT16U  OSRingPend (OS_RING *pring, void *pdata, INT16U n, INT32U timeout, INT8U *perr)
+{
+    INT16U  nget;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                                   */
+        return (0);
+    }
+    if (pring == (OS_RING *)0) {                      /* Validate 'pring'                                  */
+        *perr = OS_ERR_RING_INVALID;
+        return (0);
+    }
+#endif
+    if (pring->OSRingSem == (OS_EVENT *)0) {
+        *perr = OS_ERR_RING_NO_SEM;
+        return (0);
+    }
+    for (;;) {
+        nget = OSRingGet(pring, pdata, n);
+        if ((nget > 0) || (n == 0)) {
+            *perr = OS_ERR_NONE;
+            return (nget);
+        }
+        OSSemPend(pring->OSRingSem, timeout, perr);  /* Ring is empty, wait until the producer puts entries */
+        if (*perr != OS_ERR_NONE) {
+            return (0);
+        }
+    }
+}
+#endif
+#endif
@@ -197,6 +197,9 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
     switch (opt) {
         case OS_DEL_NO_PEND:                               /* Delete semaphore only if no task waiting */
              if (tasks_waiting == OS_FALSE) {
+#if OS_POLL_EN > 0
+                 OS_PollRemove(pevent);                    /* Take semaphore out of its poll set       */
+#endif
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
@@ -219,6 +222,9 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for semaphore    */
                  (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
              }
+#if OS_POLL_EN > 0
+             OS_PollRemove(pevent);                        /* Take semaphore out of its poll set       */
+#endif
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
@@ -278,7 +284,7 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *********************************************************************************************************
 */
 /*$PAGE*/
-void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+void  OSSemPend (OS_EVENT *pevent, INT32U timeout, INT8U *perr)
 {
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
@@ -317,7 +323,11 @@ void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                                                       /* Otherwise, must wait until event occurs       */
     OSTCBCur->OSTCBStat     |= OS_STAT_SEM;           /* Resource not available, pend on semaphore     */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB                     */
+#else
     OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+#endif
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -447,6 +457,11 @@ INT8U  OSSemPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *                                  OSSemAccept() or OSSemPend().
 *              OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a semaphore
 *              OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*              OS_ERR_INT_Q_FULL   If called from an ISR while OS_INT_Q_SIZE posts are already pending
+*                                  (OS_ISR_POST_DEFERRED_EN).  The semaphore is not signaled.
+*
+* Note(s)    : 1) With OS_ISR_POST_DEFERRED_EN set to 1, a call from an ISR only queues the post and
+*                 returns OS_ERR_NONE; OS_ERR_SEM_OVF is then not reported.
 *********************************************************************************************************
 */
 
@@ -466,6 +481,11 @@ INT8U  OSSemPost (OS_EVENT *pevent)
     if (pevent->OSEventType != OS_EVENT_TYPE_SEM) {   /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Called from an ISR, let the post task do it   */
+        return (OS_IntQPost(OS_EVENT_TYPE_SEM, (void *)pevent, (void *)0, 0, OS_POST_OPT_NONE));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task waiting for semaphore         */
                                                       /* Ready HPT waiting on event                    */
@@ -476,6 +496,13 @@ INT8U  OSSemPost (OS_EVENT *pevent)
     }
     if (pevent->OSEventCnt < 65535u) {                /* Make sure semaphore will not overflow         */
         pevent->OSEventCnt++;                         /* Increment semaphore count to register event   */
+#if OS_POLL_EN > 0
+        if (OS_PollSignal(pevent) == OS_TRUE) {       /* Ready the task waiting on the poll set        */
+            OS_EXIT_CRITICAL();
+            OS_Sched();                               /* Find HPT ready to run                         */
+            return (OS_ERR_NONE);
+        }
+#endif
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
     }
@@ -506,7 +533,10 @@ INT8U  OSSemPost (OS_EVENT *pevent)
 #if OS_SEM_QUERY_EN > 0
 INT8U  OSSemQuery (OS_EVENT *pevent, OS_SEM_DATA *p_sem_data)
 {
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U    *psrc;
+    INT32U    *pdest;
+#elif OS_LOWEST_PRIO <= 63
     INT8U     *psrc;
     INT8U     *pdest;
 #else
@@ -602,6 +632,13 @@ void  OSSemSet (OS_EVENT *pevent, INT16U cnt, INT8U *perr)
             *perr              = OS_ERR_TASK_WAITING;
         }
     }
+#if OS_POLL_EN > 0
+    if ((pevent->OSEventCnt > 0) && (OS_PollSignal(pevent) == OS_TRUE)) {
+        OS_EXIT_CRITICAL();                           /* Ready the task waiting on the poll set        */
+        OS_Sched();
+        return;
+    }
+#endif
     OS_EXIT_CRITICAL();
 }
 #endif
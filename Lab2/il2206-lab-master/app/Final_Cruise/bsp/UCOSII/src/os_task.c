@@ -59,18 +59,31 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     OS_TCB    *ptcb;
     INT8U      y_new;
     INT8U      x_new;
-    INT8U      y_old;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U     bity_new;
+    INT32U     bitx_new;
+#elif OS_LOWEST_PRIO <= 63
     INT8U      bity_new;
     INT8U      bitx_new;
-    INT8U      bity_old;
-    INT8U      bitx_old;
 #else
     INT16U     bity_new;
     INT16U     bitx_new;
+#endif
+#if OS_SCHED_RR_EN > 0
+    BOOLEAN    rdy;
+#else
+    INT8U      y_old;
+#if OS_SCHED_FFS_EN > 0
+    INT32U     bity_old;
+    INT32U     bitx_old;
+#elif OS_LOWEST_PRIO <= 63
+    INT8U      bity_old;
+    INT8U      bitx_old;
+#else
     INT16U     bity_old;
     INT16U     bitx_old;
 #endif
+#endif
 #if OS_CRITICAL_METHOD == 3
     OS_CPU_SR  cpu_sr = 0;                                  /* Storage for CPU status register         */
 #endif
@@ -104,7 +117,12 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_TASK_NOT_EXIST);
     }
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    y_new                 = (INT8U)(newprio >> 5);          /* Yes, compute new TCB fields             */
+    x_new                 = (INT8U)(newprio & 0x1F);
+    bity_new              = (INT32U)1 << y_new;
+    bitx_new              = (INT32U)1 << x_new;
+#elif OS_LOWEST_PRIO <= 63
     y_new                 = (INT8U)(newprio >> 3);          /* Yes, compute new TCB fields             */
     x_new                 = (INT8U)(newprio & 0x07);
     bity_new              = (INT8U)(1 << y_new);
@@ -116,6 +134,36 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     bitx_new              = (INT16U)(1 << x_new);
 #endif
 
+#if OS_SCHED_RR_EN > 0
+#if (OS_EVENT_EN)
+    pevent = ptcb->OSTCBEventPtr;
+    if (pevent != (OS_EVENT *)0) {
+        OS_EventTaskRemove(ptcb, pevent);                   /* Remove old task prio from wait list     */
+        pevent->OSEventGrp        |= bity_new;              /* Add    new task prio to   wait list     */
+        pevent->OSEventTbl[y_new] |= bitx_new;
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+        OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);  /* Remove old task prio from wait lists */
+        pevents =  ptcb->OSTCBEventMultiPtr;
+        pevent  = *pevents;
+        while (pevent != (OS_EVENT *)0) {
+            pevent->OSEventGrp        |= bity_new;          /* Add    new task prio to   wait lists    */
+            pevent->OSEventTbl[y_new] |= bitx_new;
+            pevents++;
+            pevent                     = *pevents;
+        }
+    }
+#endif
+#endif
+    rdy = ptcb->OSTCBRRRdy;
+    if (rdy == OS_TRUE) {                                   /* If task is ready make it not            */
+        OS_RRTaskUnRdy(ptcb);
+    }
+    if (OS_RRUnlink(ptcb) == OS_FALSE) {                    /* Leave tasks sharing the old priority    */
+        OSTCBPrioTbl[oldprio] = (OS_TCB *)0;                /* Remove TCB from old priority            */
+    }
+#else
     OSTCBPrioTbl[oldprio] = (OS_TCB *)0;                    /* Remove TCB from old priority            */
     OSTCBPrioTbl[newprio] =  ptcb;                          /* Place pointer to TCB @ new priority     */
     y_old                 =  ptcb->OSTCBY;
@@ -156,6 +204,7 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         }
     }
 #endif
+#endif
 #endif
 
     ptcb->OSTCBPrio = newprio;                              /* Set new task priority                   */
@@ -163,6 +212,21 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     ptcb->OSTCBX    = x_new;
     ptcb->OSTCBBitY = bity_new;
     ptcb->OSTCBBitX = bitx_new;
+#if OS_SCHED_EDF_EN > 0
+    if ((OSRdyTbl[y_new] & bitx_new) != 0) {                /* Leave the heap while the key changes    */
+        OS_EDFTaskUnRdy(ptcb);
+        ptcb->OSTCBEDFPrio = newprio;                       /* Deadline order applies at new priority  */
+        OS_EDFTaskRdy(ptcb);                                /* Rejoin if it is in the EDF band         */
+    } else {
+        ptcb->OSTCBEDFPrio = newprio;
+    }
+#endif
+#if OS_SCHED_RR_EN > 0
+    OS_RRLink(ptcb);                                        /* Place pointer to TCB @ new priority     */
+    if (rdy == OS_TRUE) {
+        OS_RRTaskRdy(ptcb);                                 /* Make new priority ready to run          */
+    }
+#endif
     OS_EXIT_CRITICAL();
     if (OSRunning == OS_TRUE) {
         OS_Sched();                                         /* Find new highest priority task          */
@@ -249,6 +313,17 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
         }
         return (err);
     }
+#if OS_SCHED_RR_EN > 0
+    if (OS_RRPrioShare(prio) == OS_TRUE) {   /* Share the priority with the task(s) already there      */
+        OS_EXIT_CRITICAL();
+        psp = OSTaskStkInit(task, p_arg, ptos, 0);              /* Initialize the task's stack         */
+        err = OS_TCBInit(prio, psp, (OS_STK *)0, 0, 0, (void *)0, 0);
+        if ((err == OS_ERR_NONE) && (OSRunning == OS_TRUE)) {
+            OS_Sched();
+        }
+        return (err);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_PRIO_EXIST);
 }
@@ -375,6 +450,22 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
         }
         return (err);
     }
+#if OS_SCHED_RR_EN > 0
+    if (OS_RRPrioShare(prio) == OS_TRUE) {   /* Share the priority with the task(s) already there      */
+        OS_EXIT_CRITICAL();
+
+#if (OS_TASK_STAT_STK_CHK_EN > 0)
+        OS_TaskStkClr(pbos, stk_size, opt);                    /* Clear the task stack (if needed)     */
+#endif
+
+        psp = OSTaskStkInit(task, p_arg, ptos, opt);           /* Initialize the task's stack          */
+        err = OS_TCBInit(prio, psp, pbos, id, stk_size, pext, opt);
+        if ((err == OS_ERR_NONE) && (OSRunning == OS_TRUE)) {
+            OS_Sched();
+        }
+        return (err);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_PRIO_EXIST);
 }
@@ -382,6 +473,94 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                        CREATE A PERIODIC TASK
+*
+* Description: This function creates a task that is released by the kernel every 'period' ticks, without
+*              a timer or a semaphore to release it.  The task calls OSTaskPeriodWait() at the top of its
+*              loop; the call returns when the next job of the task is released:
+*
+*                  void  Task (void *p_arg)
+*                  {
+*                      for (;;) {
+*                          OSTaskPeriodWait();
+*                          ...                       (One job)
+*                      }
+*                  }
+*
+* Arguments  : task, p_arg, ptos, prio, id, pbos, stk_size, pext and opt are as for OSTaskCreateExt().
+*
+*              period    is the number of clock ticks between two releases of the task.
+*
+*              phase     is the number of clock ticks from now to the first release.
+*
+*              deadline  is the number of clock ticks from a release to the deadline of the job.  A job
+*                        that completes later is counted as a deadline miss.  0 sets the deadline equal
+*                        to the period.
+*
+* Returns    : OS_ERR_NONE                 if the function was successful.
+*              OS_ERR_TASK_PERIOD_INVALID  if 'period' is 0.
+*              Any other value returned by OSTaskCreateExt().
+*
+* Note(s)    : 1) The release jitter, response time and deadline misses of each job are recorded by
+*                 OSTaskPeriodWait() and can be read with OSTaskPeriodicGet().
+*              2) When OS_SCHED_EDF_EN is enabled, the task is also scheduled earliest deadline first
+*                 (see OSTaskPeriodSet()) with the deadline given here.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U  OSTaskCreatePeriodic (void   (*task)(void *p_arg),
+                             void    *p_arg,
+                             OS_STK  *ptos,
+                             INT8U    prio,
+                             INT16U   id,
+                             OS_STK  *pbos,
+                             INT32U   stk_size,
+                             void    *pext,
+                             INT16U   opt,
+                             INT16U   period,
+                             INT16U   phase,
+                             INT16U   deadline)
+{
+    OS_TCB    *ptcb;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (period == 0) {                       /* A period of 0 ticks would release the task forever     */
+        return (OS_ERR_TASK_PERIOD_INVALID);
+    }
+#endif
+    if (deadline == 0) {                     /* Implicit deadline: the end of the period               */
+        deadline = period;
+    }
+    OSSchedLock();                           /* The task must not run before it is made periodic       */
+    err = OSTaskCreateExt(task, p_arg, ptos, prio, id, pbos, stk_size, pext, opt);
+    if (err == OS_ERR_NONE) {
+        OS_ENTER_CRITICAL();
+        ptcb                = OSTCBList;     /* OS_TCBInit() put the new TCB first in the TCB list   */
+#if OS_SCHED_EDF_EN > 0
+        OS_EDFTaskUnRdy(ptcb);               /* Leave the heap while the key changes                   */
+#endif
+        ptcb->OSTCBRelTime  = OSTickCtr + phase;
+        ptcb->OSTCBDeadline = ptcb->OSTCBRelTime + deadline;
+        ptcb->OSTCBPeriod   = period;
+#if OS_SCHED_EDF_EN > 0
+        OS_EDFTaskRdy(ptcb);                 /* Rejoin, in deadline order                              */
+#endif
+        OS_EXIT_CRITICAL();
+    }
+    OSSchedUnlock();                         /* Run the new task if it has a higher priority           */
+    return (err);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            DELETE A TASK
 *
 * Description: This function allows you to delete a task.  The calling task can delete itself by
@@ -458,10 +637,16 @@ INT8U  OSTaskDel (INT8U prio)
         return (OS_ERR_TASK_DEL);
     }
 
+#if OS_SCHED_RR_EN > 0
+    OS_RRTaskUnRdy(ptcb);                               /* Make task not ready                         */
+#elif OS_SCHED_EDF_EN > 0
+    OS_EDFTaskUnRdy(ptcb);                              /* Make task not ready                         */
+#else
     OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;
     if (OSRdyTbl[ptcb->OSTCBY] == 0) {                  /* Make task not ready                         */
         OSRdyGrp           &= ~ptcb->OSTCBBitY;
     }
+#endif
     
 #if (OS_EVENT_EN)
     if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {
@@ -481,7 +666,11 @@ INT8U  OSTaskDel (INT8U prio)
     }
 #endif
 
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from updating          */
+#else
     ptcb->OSTCBDly      = 0;                            /* Prevent OSTimeTick() from updating          */
+#endif
     ptcb->OSTCBStat     = OS_STAT_RDY;                  /* Prevent task from being resumed             */
     ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
     if (OSLockNesting < 255u) {                         /* Make sure we don't context switch           */
@@ -495,7 +684,13 @@ INT8U  OSTaskDel (INT8U prio)
     }
     OSTaskDelHook(ptcb);                                /* Call user defined hook                      */
     OSTaskCtr--;                                        /* One less task being managed                 */
+#if OS_SCHED_RR_EN > 0
+    if (OS_RRUnlink(ptcb) == OS_FALSE) {                /* Other tasks may remain at this priority     */
+        OSTCBPrioTbl[prio] = (OS_TCB *)0;               /* Clear old priority entry                    */
+    }
+#else
     OSTCBPrioTbl[prio] = (OS_TCB *)0;                   /* Clear old priority entry                    */
+#endif
     if (ptcb->OSTCBPrev == (OS_TCB *)0) {               /* Remove from TCB chain                       */
         ptcb->OSTCBNext->OSTCBPrev = (OS_TCB *)0;
         OSTCBList                  = ptcb->OSTCBNext;
@@ -767,6 +962,339 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       GET TASK EXECUTION TIME
+*
+* Description: This function is called to obtain the CPU time used by a task.  The times are measured in
+*              timestamp timer cycles by OSTaskSwHook() on every context switch; the accounting period is
+*              OS_TASK_PROFILE_PERIOD ticks long.
+*
+* Arguments  : prio           is the priority of the task.  If you specify OS_PRIO_SELF, the calling
+*                             task's execution time is returned.
+*
+*              p_cycles_data  is a pointer to where the execution time data will be stored.
+*
+* Returns    : OS_ERR_NONE            if the call was successful
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist or is assigned to a Mutex PIP
+*              OS_ERR_PDATA_NULL      if 'p_cycles_data' is a NULL pointer
+*
+* Note(s)    : 1) Time spent in ISRs is charged to the task they interrupted.
+*              2) All values stay 0 if the port has no cycle counter (e.g. no timestamp timer selected).
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+INT8U  OSTaskCyclesGet (INT8U prio, OS_CYCLES_DATA *p_cycles_data)
+{
+    OS_TCB    *ptcb;
+    INT32U     period;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                 /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_cycles_data == (OS_CYCLES_DATA *)0) {  /* Validate 'p_cycles_data'                           */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if querying SELF                               */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    p_cycles_data->OSCtxSwCtr     = ptcb->OSTCBCtxSwCtr;
+    p_cycles_data->OSCyclesTot    = ptcb->OSTCBCyclesTot;
+    p_cycles_data->OSCyclesMax    = ptcb->OSTCBCyclesMax;
+    p_cycles_data->OSCyclesPeriod = ptcb->OSTCBCyclesLast;
+    period                        = OSCyclesPeriod;
+    OS_EXIT_CRITICAL();
+    period /= 100L;                              /* Avoid overflowing 32 bits with large periods       */
+    if (period > 0) {
+        p_cycles_data->OSUsage = (INT8U)(p_cycles_data->OSCyclesPeriod / period);
+    } else {
+        p_cycles_data->OSUsage = 0;
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     MAKE A TASK PERIODIC (EDF)
+*
+* Description: This function makes a task periodic so that, if its priority is in the EDF band, it is
+*              dispatched earliest deadline first (see OS_SchedNew()).  The task's first job is released now and must complete within
+*              'period' ticks; the task then calls OSTimeDlyPeriod() at the end of each job to wait for
+*              the next release.
+*
+* Arguments  : prio      is the priority of the task.  If you specify OS_PRIO_SELF, the calling task is
+*                        made periodic.
+*
+*              period    is the number of clock ticks between two releases of the task.  The relative
+*                        deadline of each job is equal to its period.  0 makes the task an ordinary
+*                        task, scheduled by its priority only.
+*
+* Returns    : OS_ERR_NONE            if the call was successful
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if the task does not exist or is assigned to a Mutex PIP
+*
+* Note(s)    : 1) The task's deadline miss counter (.OSTCBDlMiss, see OSTaskQuery()) is cleared.
+*              2) Only priorities OS_SCHED_EDF_PRIO_HI to OS_SCHED_EDF_PRIO_LO (os_cfg.h) are dispatched
+*                 in deadline order.  A periodic task outside this band is scheduled by its priority,
+*                 and tasks of the band that are not periodic run after the periodic ones.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_EDF_EN > 0
+INT8U  OSTaskPeriodSet (INT8U prio, INT16U period)
+{
+    OS_TCB    *ptcb;
+    BOOLEAN    rdy;
+#if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                             /* Make sure task priority is valid      */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                               /* See if setting SELF                   */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) { /* Task must exist                       */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    rdy = ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) != 0) ? OS_TRUE : OS_FALSE;
+    if (rdy == OS_TRUE) {
+        OS_EDFTaskUnRdy(ptcb);                                /* Leave the heap while the key changes  */
+    }
+    ptcb->OSTCBRelTime  = OSTickCtr;                          /* First job is released now             */
+    ptcb->OSTCBDeadline = OSTickCtr + period;
+    ptcb->OSTCBPeriod   = period;
+    ptcb->OSTCBDlMiss   = 0L;
+    if (rdy == OS_TRUE) {
+        OS_EDFTaskRdy(ptcb);                                  /* Rejoin, in deadline order if periodic */
+    }
+    OS_EXIT_CRITICAL();
+    if (OSRunning == OS_TRUE) {
+        OS_Sched();                                           /* Find new highest priority task        */
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      GET PERIODIC TASK STATISTICS
+*
+* Description: This function is called to obtain the release statistics of a task created with
+*              OSTaskCreatePeriodic().  The period, deadline and release time are in clock ticks, the
+*              jitter and response times in counts of OSTimeTsGet() (see OSTimeTsToNs()).
+*
+* Arguments  : prio             is the priority of the task.  If you specify OS_PRIO_SELF, the calling
+*                               task's statistics are returned.
+*
+*              p_periodic_data  is a pointer to where the statistics will be stored.
+*
+* Returns    : OS_ERR_NONE               if the call was successful
+*              OS_ERR_PRIO_INVALID       if the priority you specify is higher that the maximum allowed
+*                                        (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST     if the task does not exist or is assigned to a Mutex PIP
+*              OS_ERR_TASK_NOT_PERIODIC  if the task was not created with OSTaskCreatePeriodic()
+*              OS_ERR_PDATA_NULL         if 'p_periodic_data' is a NULL pointer
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U  OSTaskPeriodicGet (INT8U prio, OS_PERIODIC_DATA *p_periodic_data)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                 /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_periodic_data == (OS_PERIODIC_DATA *)0) {  /* Validate 'p_periodic_data'                     */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if querying SELF                               */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb->OSTCBPeriod == 0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    p_periodic_data->OSPeriod     = ptcb->OSTCBPeriod;
+    p_periodic_data->OSDeadline   = (INT16U)(ptcb->OSTCBDeadline - ptcb->OSTCBRelTime);
+    p_periodic_data->OSRelTime    = ptcb->OSTCBRelTime;
+    p_periodic_data->OSRelCtr     = ptcb->OSTCBRelCtr;
+    p_periodic_data->OSDlMiss     = ptcb->OSTCBDlMiss;
+    p_periodic_data->OSJitterLast = ptcb->OSTCBJitterLast;
+    p_periodic_data->OSJitterMax  = ptcb->OSTCBJitterMax;
+    p_periodic_data->OSRespLast   = ptcb->OSTCBRespLast;
+    p_periodic_data->OSRespMax    = ptcb->OSTCBRespMax;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  WAIT FOR THE NEXT RELEASE OF A PERIODIC TASK
+*
+* Description: This function is called by a task created with OSTaskCreatePeriodic() when it is ready for
+*              its next job.  The job that ran since the previous call is complete: its response time
+*              is recorded and, if it completed after its deadline, it is counted as a miss.  The task is
+*              then delayed until the next job is released, one period after the previous release (or at
+*              the first release, on the first call).  The release jitter, the time from the release to
+*              the return from this function, is recorded before it returns.
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE               if the call was successful
+*              OS_ERR_TIME_DLY_ISR       if you called this function from an ISR
+*              OS_ERR_PEND_LOCKED        if you called this function while the scheduler is locked
+*              OS_ERR_TASK_NOT_PERIODIC  if the calling task was not created with OSTaskCreatePeriodic()
+*
+* Note(s)    : 1) Releases are kept in ticks of OSTimeGet64(), so the task does not drift.  A job that overruns
+*                 its period delays the next one, which is then released at once, with a jitter equal to
+*                 the overrun; the task catches up with its original release times.
+*              2) A task woken up early (e.g. by OSTimeDlyResume()) is delayed again until its release.
+*              3) Jitter and response times are in counts of OSTimeTsGet().  A job is stamped as released
+*                 at the OSTimeTsGet() of the tick it is released at (OSTickTs), less one tick period for
+*                 each tick it is released late by.
+*              4) The job state is shared with OSTimeDlyPeriod() and, with OS_SCHED_EDF_EN, the deadline
+*                 is the one the task is scheduled by.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U  OSTaskPeriodWait (void)
+{
+    OS_TCB    *ptcb;
+    INT32U     ticks;
+    INT64U     ts;
+#if (OS_SCHED_RR_EN == 0) && (OS_SCHED_EDF_EN == 0)
+    INT8U      y;
+#endif
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked                */
+        return (OS_ERR_PEND_LOCKED);
+    }
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBCur;
+    if (ptcb->OSTCBPeriod == 0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    if (ptcb->OSTCBRelCtr > 0) {                 /* The job released last is complete                  */
+        OS_EXIT_CRITICAL();
+        ts = OSTimeTsGet();
+        OS_ENTER_CRITICAL();
+        ptcb->OSTCBRespLast = (INT32U)(ts - ptcb->OSTCBRelTs);
+        if (ptcb->OSTCBRespLast > ptcb->OSTCBRespMax) {
+            ptcb->OSTCBRespMax = ptcb->OSTCBRespLast;
+        }
+        if (OSTickCtr > ptcb->OSTCBDeadline) {   /* See if the job completed late                      */
+            ptcb->OSTCBDlMiss++;
+        }
+#if OS_SCHED_EDF_EN > 0
+        OS_EDFTaskUnRdy(ptcb);                   /* Leave the heap while the key changes               */
+#endif
+        ptcb->OSTCBRelTime  += ptcb->OSTCBPeriod;
+        ptcb->OSTCBDeadline += ptcb->OSTCBPeriod;
+#if OS_SCHED_EDF_EN > 0
+        OS_EDFTaskRdy(ptcb);
+#endif
+    }
+    while (ptcb->OSTCBRelTime > OSTickCtr) {     /* Delay the task until the release                   */
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskUnRdy(ptcb);
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskUnRdy(ptcb);
+#else
+        y            =  ptcb->OSTCBY;
+        OSRdyTbl[y] &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~ptcb->OSTCBBitY;
+        }
+#endif
+        ticks = (INT32U)(ptcb->OSTCBRelTime - OSTickCtr);
+#if OS_TICK_LIST_EN > 0
+        OS_TickListInsert(ptcb, ticks);          /* Load ticks in TCB and insert in tick list          */
+#else
+        ptcb->OSTCBDly = ticks;                  /* Load ticks in TCB                                  */
+#endif
+        OS_EXIT_CRITICAL();
+        OS_Sched();                              /* Find next task to run!                             */
+        OS_ENTER_CRITICAL();
+    }
+    ticks            = (INT32U)(OSTickCtr - ptcb->OSTCBRelTime);  /* Nbr of ticks released late by     */
+    ptcb->OSTCBRelTs = OSTickTs;
+    if (ticks > 0) {                             /* Integer ticks/s, there may be no FPU               */
+        ptcb->OSTCBRelTs -= (INT64U)ticks * OSTimeTsFreq() / (INT32U)OS_TICKS_PER_SEC;
+    }
+    ptcb->OSTCBRelCtr++;
+    OS_EXIT_CRITICAL();
+    ts = OSTimeTsGet();                          /* The job is released and running                   */
+    OS_ENTER_CRITICAL();
+    if ((OSTickCtr == 0) || (ts < ptcb->OSTCBRelTs)) {   /* No tick stamped before the release yet    */
+        ptcb->OSTCBRelTs = ts;
+    }
+    ptcb->OSTCBJitterLast = (INT32U)(ts - ptcb->OSTCBRelTs);
+    if (ptcb->OSTCBJitterLast > ptcb->OSTCBJitterMax) {
+        ptcb->OSTCBJitterMax = ptcb->OSTCBJitterLast;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -812,11 +1340,17 @@ INT8U  OSTaskResume (INT8U prio)
         return (OS_ERR_TASK_NOT_EXIST);
     }
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) { /* Task must be suspended                */
-        ptcb->OSTCBStat &= ~(INT8U)OS_STAT_SUSPEND;           /* Remove suspension                     */
+        ptcb->OSTCBStat &= ~(INT16U)OS_STAT_SUSPEND;          /* Remove suspension                     */
         if (ptcb->OSTCBStat == OS_STAT_RDY) {                 /* See if task is now ready              */
             if (ptcb->OSTCBDly == 0) {
+#if OS_SCHED_RR_EN > 0
+                OS_RRTaskRdy(ptcb);                           /* Yes, Make task ready to run           */
+#elif OS_SCHED_EDF_EN > 0
+                OS_EDFTaskRdy(ptcb);                          /* Yes, Make task ready to run           */
+#else
                 OSRdyGrp               |= ptcb->OSTCBBitY;    /* Yes, Make task ready to run           */
                 OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
                 OS_EXIT_CRITICAL();
                 if (OSRunning == OS_TRUE) {
                     OS_Sched();                               /* Find new highest priority task        */
@@ -942,7 +1476,9 @@ INT8U  OSTaskSuspend (INT8U prio)
 {
     BOOLEAN    self;
     OS_TCB    *ptcb;
+#if (OS_SCHED_RR_EN == 0) && (OS_SCHED_EDF_EN == 0)
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -977,11 +1513,17 @@ INT8U  OSTaskSuspend (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
     }
+#if OS_SCHED_RR_EN > 0
+    OS_RRTaskUnRdy(ptcb);                                       /* Make task not ready                 */
+#elif OS_SCHED_EDF_EN > 0
+    OS_EDFTaskUnRdy(ptcb);                                      /* Make task not ready                 */
+#else
     y            = ptcb->OSTCBY;
     OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                            /* Make task not ready                 */
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~ptcb->OSTCBBitY;
     }
+#endif
     ptcb->OSTCBStat |= OS_STAT_SUSPEND;                         /* Status of task is 'SUSPENDED'       */
     OS_EXIT_CRITICAL();
     if (self == OS_TRUE) {                                      /* Context switch only if SELF         */
@@ -1007,6 +1549,12 @@ INT8U  OSTaskSuspend (INT8U prio)
 *              OS_ERR_PRIO            if the desired task has not been created
 *              OS_ERR_TASK_NOT_EXIST  if the task is assigned to a Mutex PIP
 *              OS_ERR_PDATA_NULL      if 'p_task_data' is a NULL pointer
+*
+* Note(s)    : 1) When OS_SCHED_EDF_EN or OS_TASK_PERIODIC_EN is enabled, .OSTCBDlMiss in the copy holds the
+*                 number of jobs of a periodic task that completed after their deadline (see
+*                 OSTimeDlyPeriod() and OSTaskPeriodWait()).
+*              2) When OS_TASK_PROFILE_EN is enabled, the .OSTCBCycles... fields in the copy hold the task's
+*                 execution time (see OSTaskCyclesGet()).
 *********************************************************************************************************
 */
 
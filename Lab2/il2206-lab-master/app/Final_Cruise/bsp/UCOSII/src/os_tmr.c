@@ -33,7 +33,13 @@
 *    OS_TASK_TMR_PRIO          The priority of the Timer management task
 *    OS_TASK_TMR_STK_SIZE      The size     of the Timer management task's stack
 *
-* 2) You must call OSTmrSignal() to notify the Timer management task that it's time to update the timers.
+* 2) You must call OSTmrSignal() to notify the Timer management task that it's time to update the timers.  The timer
+*    time itself is the 64-bit tick count of OSTimeGet64() divided by OS_TMR_TICK_DIV, so a signal that is lost or
+*    late only delays the timers; they are updated for every timer tick that elapsed when the task runs.
+*
+* 3) With OS_TMR_DISP_EN, OS_TMR_DISP_LEVELS dispatch tasks are created at OS_TMR_DISP_PRIO_1, OS_TMR_DISP_PRIO_2, ...
+*    A timer moved to one of them with OSTmrDispatchSet() has its callback queued there on expiry instead of being
+*    called by the Timer management task with the timers locked.
 ************************************************************************************************************************
 */
 
@@ -46,6 +52,21 @@
 #define  OS_TMR_LINK_DLY       0
 #define  OS_TMR_LINK_PERIODIC  1
 
+#if OS_TMR_EN > 0 && OS_TMR_DISP_EN > 0
+static  INT8U  const  OSTmrDispPrioTbl[OS_TMR_DISP_LEVELS] = {      /* Priority of the dispatch task of each level   */
+    OS_TMR_DISP_PRIO_1,
+#if OS_TMR_DISP_LEVELS > 1
+    OS_TMR_DISP_PRIO_2,
+#endif
+#if OS_TMR_DISP_LEVELS > 2
+    OS_TMR_DISP_PRIO_3,
+#endif
+#if OS_TMR_DISP_LEVELS > 3
+    OS_TMR_DISP_PRIO_4,
+#endif
+};
+#endif
+
 /*
 ************************************************************************************************************************
 *                                                  LOCAL PROTOTYPES
@@ -61,6 +82,20 @@ static  void     OSTmr_Unlink        (OS_TMR *ptmr);
 static  void     OSTmr_Lock          (void);
 static  void     OSTmr_Unlock        (void);
 static  void     OSTmr_Task          (void   *p_arg);
+#if OS_TMR_HWHEEL_EN > 0
+static  void     OSTmr_Insert        (OS_TMR *ptmr);
+static  void     OSTmr_Cascade       (void);
+#endif
+#if OS_TMR_STATS_EN > 0
+static  void     OSTmr_Stats         (OS_TMR *ptmr, OS_TMR_CALLBACK pfnct, void *parg,
+                                      INT32U cycles, INT32U late, INT32U late_ticks);
+#endif
+#if OS_TMR_DISP_EN > 0
+static  void     OSTmr_InitDisp      (void);
+static  void     OSTmr_DispPut       (OS_TMR *ptmr);
+static  void     OSTmr_DispRemove    (OS_TMR *ptmr);
+static  void     OSTmr_DispTask      (void   *p_arg);
+#endif
 #endif
 
 /*$PAGE*/
@@ -165,6 +200,14 @@ OS_TMR  *OSTmrCreate (INT32U           dly,
     ptmr->OSTmrOpt         = opt;
     ptmr->OSTmrCallback    = callback;
     ptmr->OSTmrCallbackArg = callback_arg;
+#if OS_TMR_STATS_EN > 0
+    ptmr->OSTmrCallCtr      = 0;                            /* Clear the statistics of the previous user              */
+    ptmr->OSTmrCyclesMax    = 0;
+    ptmr->OSTmrCyclesTot    = 0;
+    ptmr->OSTmrLateMax      = 0;
+    ptmr->OSTmrLateTot      = 0;
+    ptmr->OSTmrLateTicksMax = 0;
+#endif
 #if OS_TMR_CFG_NAME_SIZE > 0
     if (pname !=(INT8U *)0) {
         len = OS_StrLen(pname);                             /* Copy timer name                                        */
@@ -713,11 +756,203 @@ INT8U  OSTmrSignal (void)
     INT8U  err;
 
 
+#if OS_TMR_STATS_EN > 0
+    OSTmrSignalTs = OSCPUCyclesGet();                       /* Start of the timer tick, for the lateness of callbacks */
+#endif
     err = OSSemPost(OSTmrSemSignal);
     return (err);
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                         SELECT HOW THE EXPIRY OF A TIMER IS DISPATCHED
+*
+* Description: This function is called to choose the task that calls the callback of a timer when it expires, and
+*              optionally a semaphore that is posted at the same time.
+*
+*              By default callbacks are called by OSTmr_Task(), one after the other and with the timers locked, so
+*              a slow callback delays all timers that expire after it, whatever the priority of the tasks they
+*              release.  A timer set to a dispatch level has its callback queued to the dispatch task of that level
+*              instead, which calls it at OS_TMR_DISP_PRIO_1, OS_TMR_DISP_PRIO_2, ... without the timers locked.
+*              Expiries queued while the dispatch task is busy are counted and all called back in turn.
+*
+*              A task that only waits for the timer is released with the least delay by 'psem': OSTmr_Task() posts
+*              it directly when the timer expires, before it calls or queues the callback.
+*
+* Arguments  : ptmr          Is a pointer to the desired timer
+*
+*              level         Is the dispatch task to call the callback:
+*                               OS_TMR_DISP_TMR_TASK      OSTmr_Task(), as for a new timer
+*                               1 .. OS_TMR_DISP_LEVELS   the dispatch task at OS_TMR_DISP_PRIO_1 .. _4
+*
+*              psem          Is a pointer to a semaphore to post on every expiry, or a NULL pointer for none
+*
+* Returns    : OS_ERR_NONE               The call was successful
+*              OS_ERR_TMR_INVALID        'ptmr' is a NULL pointer
+*              OS_ERR_TMR_INVALID_LEVEL  'level' is higher than OS_TMR_DISP_LEVELS
+*              OS_ERR_EVENT_TYPE         'psem' is not pointing to a semaphore
+*              OS_ERR_TMR_INVALID_TYPE   'ptmr' is not pointing to an OS_TMR
+*              OS_ERR_TMR_ISR            if the call was made from an ISR
+*              OS_ERR_TMR_INACTIVE       'ptmr' points to a timer that was not created
+*
+* Note(s)    : 1) Expiries still queued at the previous level are discarded when the level is changed.
+*              2) A timer returns to OS_TMR_DISP_TMR_TASK and no semaphore when it is deleted.
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_DISP_EN > 0
+INT8U  OSTmrDispatchSet (OS_TMR    *ptmr,
+                         INT8U      level,
+                         OS_EVENT  *psem)
+{
+#if OS_ARG_CHK_EN > 0
+    if (ptmr == (OS_TMR *)0) {
+        return (OS_ERR_TMR_INVALID);
+    }
+#endif
+    if (level > OS_TMR_DISP_LEVELS) {                  /* Validate the dispatch level                                 */
+        return (OS_ERR_TMR_INVALID_LEVEL);
+    }
+    if (psem != (OS_EVENT *)0) {
+        if (psem->OSEventType != OS_EVENT_TYPE_SEM) {
+            return (OS_ERR_EVENT_TYPE);
+        }
+    }
+    if (ptmr->OSTmrType != OS_TMR_TYPE) {              /* Validate timer structure                                    */
+        return (OS_ERR_TMR_INVALID_TYPE);
+    }
+    if (OSIntNesting > 0) {                            /* See if trying to call from an ISR                           */
+        return (OS_ERR_TMR_ISR);
+    }
+    OSTmr_Lock();
+    if (ptmr->OSTmrState == OS_TMR_STATE_UNUSED) {
+        OSTmr_Unlock();
+        return (OS_ERR_TMR_INACTIVE);
+    }
+    if (ptmr->OSTmrDispLevel != level) {
+        OSTmr_DispRemove(ptmr);                        /* Discard the expiries queued at the previous level           */
+        ptmr->OSTmrDispLevel = level;
+    }
+    ptmr->OSTmrDispSem = psem;
+    OSTmr_Unlock();
+    return (OS_ERR_NONE);
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                           GET THE STATISTICS OF A TIMER
+*
+* Description: This function is called to obtain how often the callback of a timer ran, how long it took and how late
+*              it was.  Times are in cycles of OSCPUCyclesGet(), which reads zero on ports without a cycle counter.
+*
+*              Callbacks run in OSTmr_Task() with the timers locked, so a long callback delays every other timer that
+*              expires on the same tick.  The lateness of a callback is measured from the OSTmrSignal() call of the
+*              most recent timer tick to the start of the callback.  If OSTmr_Task() fell behind, more timer ticks are
+*              pending and the callback also ran that many timer ticks after its match, which is reported separately.
+*              For a callback run by a dispatch task (see OSTmrDispatchSet()) both are measured from the timer tick
+*              of the oldest expiry still queued.
+*
+*              The statistics are cleared when the timer is created.
+*
+* Arguments  : ptmr          Is a pointer to the desired timer
+*
+*              p_tmr_data    Is a pointer to a structure that will receive the statistics
+*
+* Returns    : OS_ERR_NONE               The call was successful and the statistics were copied
+*              OS_ERR_TMR_INVALID        'ptmr' is a NULL pointer
+*              OS_ERR_PDATA_NULL         'p_tmr_data' is a NULL pointer
+*              OS_ERR_TMR_INVALID_TYPE   'ptmr' is not pointing to an OS_TMR
+*              OS_ERR_TMR_ISR            if the call was made from an ISR
+*              OS_ERR_TMR_INACTIVE       'ptmr' points to a timer that was not created
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_STATS_EN > 0
+INT8U  OSTmrQuery (OS_TMR       *ptmr,
+                   OS_TMR_DATA  *p_tmr_data)
+{
+#if OS_ARG_CHK_EN > 0
+    if (ptmr == (OS_TMR *)0) {
+        return (OS_ERR_TMR_INVALID);
+    }
+    if (p_tmr_data == (OS_TMR_DATA *)0) {
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (ptmr->OSTmrType != OS_TMR_TYPE) {              /* Validate timer structure                                    */
+        return (OS_ERR_TMR_INVALID_TYPE);
+    }
+    if (OSIntNesting > 0) {                            /* See if trying to call from an ISR                           */
+        return (OS_ERR_TMR_ISR);
+    }
+    OSTmr_Lock();
+    if (ptmr->OSTmrState == OS_TMR_STATE_UNUSED) {
+        OSTmr_Unlock();
+        return (OS_ERR_TMR_INACTIVE);
+    }
+    p_tmr_data->OSCallCtr      = ptmr->OSTmrCallCtr;
+    p_tmr_data->OSCyclesMax    = ptmr->OSTmrCyclesMax;
+    p_tmr_data->OSLateMax      = ptmr->OSTmrLateMax;
+    p_tmr_data->OSLateTicksMax = ptmr->OSTmrLateTicksMax;
+    if (ptmr->OSTmrCallCtr > 0) {
+        p_tmr_data->OSCyclesMean = (INT32U)(ptmr->OSTmrCyclesTot / ptmr->OSTmrCallCtr);
+        p_tmr_data->OSLateMean   = (INT32U)(ptmr->OSTmrLateTot   / ptmr->OSTmrCallCtr);
+    } else {
+        p_tmr_data->OSCyclesMean = 0;
+        p_tmr_data->OSLateMean   = 0;
+    }
+    OSTmr_Unlock();
+    return (OS_ERR_NONE);
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                         GET TIMER TICKS UNTIL NEXT TIMER EXPIRES
+*
+* Description: This function is called by the port's idle hook when OS_TICKLESS_EN is enabled to find out how many
+*              calls to OSTmrSignal() can be skipped before a running timer expires.
+*
+* Arguments  : none
+*
+* Returns    : The number of timer ticks until the first running timer expires, or
+*              0 if no timer is running.
+*
+* Note(s)    : 1) Interrupts MUST be disabled when calling this function.
+*              2) The result is only meaningful when OSTmr_Task() is waiting for OSTmrSignal(), which is always the
+*                 case when the idle task runs.
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TICKLESS_EN > 0
+INT32U  OSTmrNextGet (void)
+{
+    OS_TMR  *ptmr;
+    INT32U   remain;
+    INT32U   ticks;
+    INT16U   i;
+
+
+    ticks = 0L;
+    ptmr  = &OSTmrTbl[0];
+    for (i = 0; i < OS_TMR_CFG_MAX; i++) {
+        if (ptmr->OSTmrState == OS_TMR_STATE_RUNNING) {
+            remain = ptmr->OSTmrMatch - OSTmrTime;              /* Wrap-safe distance to the match value           */
+            if ((ticks == 0L) || (remain < ticks)) {
+                ticks = remain;
+            }
+        }
+        ptmr++;
+    }
+    return (ticks);
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -766,6 +1001,11 @@ static  OS_TMR  *OSTmr_Alloc (void)
 #if OS_TMR_EN > 0
 static  void  OSTmr_Free (OS_TMR *ptmr)
 {
+#if OS_TMR_DISP_EN > 0
+    OSTmr_DispRemove(ptmr);                            /* Discard the expiries not yet dispatched                     */
+    ptmr->OSTmrDispLevel   = OS_TMR_DISP_TMR_TASK;
+    ptmr->OSTmrDispSem     = (OS_EVENT *)0;
+#endif
     ptmr->OSTmrState       = OS_TMR_STATE_UNUSED;      /* Clear timer object fields                                   */
     ptmr->OSTmrOpt         = OS_TMR_OPT_NONE;
     ptmr->OSTmrPeriod      = 0;
@@ -835,6 +1075,9 @@ void  OSTmr_Init (void)
     ptmr1->OSTmrName[1] = OS_ASCII_NUL;
 #endif
     OSTmrTime           = 0;
+#if OS_TMR_STATS_EN > 0
+    OSTmrSignalTs       = 0;
+#endif
     OSTmrUsed           = 0;
     OSTmrFree           = OS_TMR_CFG_MAX;
     OSTmrFreeList       = &OSTmrTbl[0];
@@ -858,6 +1101,9 @@ void  OSTmr_Init (void)
 #endif
 
     OSTmr_InitTask();
+#if OS_TMR_DISP_EN > 0
+    OSTmr_InitDisp();
+#endif
 }
 #endif
 
@@ -928,6 +1174,90 @@ static  void  OSTmr_InitTask (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                          INITIALIZE THE TIMER DISPATCH TASKS
+*
+* Description: This function is called by OSTmrInit() to create the dispatch task of each level and its semaphore.
+*
+* Arguments  : none
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_DISP_EN > 0
+static  void  OSTmr_InitDisp (void)
+{
+#if (OS_EVENT_NAME_SIZE > 10) || (OS_TASK_NAME_SIZE > 10)
+    INT8U         err;
+#endif
+    INT8U         i;
+    OS_TMR_DISP  *pdisp;
+
+
+    pdisp = &OSTmrDispTbl[0];
+    for (i = 0; i < OS_TMR_DISP_LEVELS; i++) {
+        pdisp->OSDispFirst = (OS_TMR *)0;
+        pdisp->OSDispLast  = (OS_TMR *)0;
+        pdisp->OSDispSem   = OSSemCreate(0);
+#if OS_EVENT_NAME_SIZE > 16
+        OSEventNameSet(pdisp->OSDispSem, (INT8U *)"uC/OS-II TmrDisp", &err);
+#else
+#if OS_EVENT_NAME_SIZE > 10
+        OSEventNameSet(pdisp->OSDispSem, (INT8U *)"OS-TmrDisp", &err);
+#endif
+#endif
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+        (void)OSTaskCreateExt(OSTmr_DispTask,
+                              (void *)pdisp,                                   /* Queue of the level                  */
+                              &OSTmrDispTaskStk[i][OS_TMR_DISP_STK_SIZE - 1],  /* Set Top-Of-Stack                    */
+                              OSTmrDispPrioTbl[i],
+                              OS_TASK_TMR_DISP_ID,
+                              &OSTmrDispTaskStk[i][0],                         /* Set Bottom-Of-Stack                 */
+                              OS_TMR_DISP_STK_SIZE,
+                              (void *)0,                                       /* No TCB extension                    */
+                              OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack */
+    #else
+        (void)OSTaskCreateExt(OSTmr_DispTask,
+                              (void *)pdisp,                                   /* Queue of the level                  */
+                              &OSTmrDispTaskStk[i][0],                         /* Set Top-Of-Stack                    */
+                              OSTmrDispPrioTbl[i],
+                              OS_TASK_TMR_DISP_ID,
+                              &OSTmrDispTaskStk[i][OS_TMR_DISP_STK_SIZE - 1],  /* Set Bottom-Of-Stack                 */
+                              OS_TMR_DISP_STK_SIZE,
+                              (void *)0,                                       /* No TCB extension                    */
+                              OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1
+        (void)OSTaskCreate(OSTmr_DispTask,
+                           (void *)pdisp,
+                           &OSTmrDispTaskStk[i][OS_TMR_DISP_STK_SIZE - 1],
+                           OSTmrDispPrioTbl[i]);
+    #else
+        (void)OSTaskCreate(OSTmr_DispTask,
+                           (void *)pdisp,
+                           &OSTmrDispTaskStk[i][0],
+                           OSTmrDispPrioTbl[i]);
+    #endif
+#endif
+
+#if OS_TASK_NAME_SIZE > 16
+        OSTaskNameSet(OSTmrDispPrioTbl[i], (INT8U *)"uC/OS-II TmrDisp", &err);
+#else
+#if OS_TASK_NAME_SIZE > 10
+        OSTaskNameSet(OSTmrDispPrioTbl[i], (INT8U *)"OS-TmrDisp", &err);
+#endif
+#endif
+        pdisp++;
+    }
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -943,15 +1273,19 @@ static  void  OSTmr_InitTask (void)
 *                               OS_TMR_LINK_DLY         Means to insert    the timer the first time
 *
 * Returns    : none
+*
+* Note(s)    : 1) With OS_TMR_HWHEEL_EN the spoke is selected by OSTmr_Insert().
 ************************************************************************************************************************
 */
 
 #if OS_TMR_EN > 0
 static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
 {
+#if OS_TMR_HWHEEL_EN == 0
     OS_TMR       *ptmr1;
     OS_TMR_WHEEL *pspoke;
     INT16U        spoke;
+#endif
 
 
     ptmr->OSTmrState = OS_TMR_STATE_RUNNING;
@@ -964,6 +1298,9 @@ static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
             ptmr->OSTmrMatch = ptmr->OSTmrDly    + OSTmrTime;
         }
     }
+#if OS_TMR_HWHEEL_EN > 0
+    OSTmr_Insert(ptmr);
+#else
     spoke  = (INT16U)(ptmr->OSTmrMatch % OS_TMR_CFG_WHEEL_SIZE);
     pspoke = &OSTmrWheelTbl[spoke];
 
@@ -979,6 +1316,7 @@ static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
         pspoke->OSTmrEntries++;
     }
     ptmr->OSTmrPrev = (void *)0;                                   /* Timer always inserted as first node in list     */
+#endif
 }
 #endif
 
@@ -1001,11 +1339,17 @@ static  void  OSTmr_Unlink (OS_TMR *ptmr)
     OS_TMR        *ptmr1;
     OS_TMR        *ptmr2;
     OS_TMR_WHEEL  *pspoke;
+#if OS_TMR_HWHEEL_EN == 0
     INT16U         spoke;
+#endif
 
 
+#if OS_TMR_HWHEEL_EN > 0
+    pspoke = ptmr->OSTmrSpoke;
+#else
     spoke  = (INT16U)(ptmr->OSTmrMatch % OS_TMR_CFG_WHEEL_SIZE);
     pspoke = &OSTmrWheelTbl[spoke];
+#endif
 
     if (pspoke->OSTmrFirst == ptmr) {                       /* See if timer to remove is at the beginning of list     */
         ptmr1              = (OS_TMR *)ptmr->OSTmrNext;
@@ -1028,6 +1372,254 @@ static  void  OSTmr_Unlink (OS_TMR *ptmr)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                      INSERT A TIMER INTO THE HIERARCHICAL TIMER WHEEL
+*
+* Description: This function is called to link a running timer into the spoke of the hierarchical wheel that matches
+*              its expiry time (.OSTmrMatch).  The wheel has OS_TMR_HWHEEL_LEVELS levels of OS_TMR_HWHEEL_SPOKES spokes.
+*              The timer time is seen as a number of OS_TMR_HWHEEL_BITS wide digits, one per level.  A timer is placed
+*              on the level of the most significant digit in which its match differs from OSTmrTime, in the spoke
+*              given by that digit of the match.  So every spoke of level 0 holds timers that all expire on the same
+*              timer tick, and a higher level spoke holds timers that expire in the same block of ticks.
+*
+* Arguments  : ptmr          Is a pointer to the timer to insert.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Timers that expire beyond the range of the wheel are placed on the highest level; they are inserted
+*                 again, in the same way, whenever their spoke is cascaded.
+*              2) The insertion is done in constant time, at the beginning of the spoke.
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_HWHEEL_EN > 0
+static  void  OSTmr_Insert (OS_TMR *ptmr)
+{
+    OS_TMR        *ptmr1;
+    OS_TMR_WHEEL  *pspoke;
+    INT32U         diff;
+    INT8U          level;
+
+
+    diff  = ptmr->OSTmrMatch ^ OSTmrTime;                          /* Find the highest digit that differs             */
+    level = 0;
+    while ((level < (OS_TMR_HWHEEL_LEVELS - 1)) &&
+           ((diff >> (OS_TMR_HWHEEL_BITS * (level + 1))) != 0L)) {
+        level++;
+    }
+    pspoke = &OSTmrWheelTbl[level * OS_TMR_HWHEEL_SPOKES +
+                            ((ptmr->OSTmrMatch >> (OS_TMR_HWHEEL_BITS * level)) & OS_TMR_HWHEEL_MASK)];
+
+    ptmr1              = pspoke->OSTmrFirst;                       /* Link as the first timer of the spoke            */
+    ptmr->OSTmrNext    = (void *)ptmr1;
+    ptmr->OSTmrPrev    = (void *)0;
+    ptmr->OSTmrSpoke   = pspoke;
+    if (ptmr1 != (OS_TMR *)0) {
+        ptmr1->OSTmrPrev = (void *)ptmr;
+    }
+    pspoke->OSTmrFirst = ptmr;
+    pspoke->OSTmrEntries++;
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                         CASCADE THE HIERARCHICAL TIMER WHEEL
+*
+* Description: This function is called by OSTmr_Task() when the lowest digit of OSTmrTime has just wrapped to 0.  For
+*              every level whose lower digits are all 0, starting from the highest one, the spoke for the current value
+*              of its digit is emptied and its timers are inserted again.  They move to a lower level, or to the
+*              spoke of level 0 that OSTmr_Task() processes next if they expire on this tick.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) Each timer is cascaded at most once per level, so the cost of a cascade is spread over the lifetime
+*                 of the timers.
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_HWHEEL_EN > 0
+static  void  OSTmr_Cascade (void)
+{
+    OS_TMR        *ptmr;
+    OS_TMR        *ptmr_next;
+    OS_TMR_WHEEL  *pspoke;
+    INT8U          level;
+
+
+    level = 1;                                                     /* Find the highest level to cascade               */
+    while ((level < (OS_TMR_HWHEEL_LEVELS - 1)) &&
+           (((OSTmrTime >> (OS_TMR_HWHEEL_BITS * level)) & OS_TMR_HWHEEL_MASK) == 0)) {
+        level++;
+    }
+    while (level > 0) {
+        pspoke = &OSTmrWheelTbl[level * OS_TMR_HWHEEL_SPOKES +
+                                ((OSTmrTime >> (OS_TMR_HWHEEL_BITS * level)) & OS_TMR_HWHEEL_MASK)];
+        ptmr                 = pspoke->OSTmrFirst;                 /* Empty the spoke ...                             */
+        pspoke->OSTmrFirst   = (OS_TMR *)0;
+        pspoke->OSTmrEntries = 0;
+        while (ptmr != (OS_TMR *)0) {                              /* ... and insert its timers again                 */
+            ptmr_next = (OS_TMR *)ptmr->OSTmrNext;
+            OSTmr_Insert(ptmr);
+            ptmr      = ptmr_next;
+        }
+        level--;
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                           UPDATE THE STATISTICS OF A TIMER
+*
+* Description: This function is called by OSTmr_Task() or a dispatch task after it invoked the callback of 'ptmr'.
+*              The callback may have deleted the timer, and another task may have created it again since; the
+*              statistics are only updated if the timer still has the callback and argument that were called.
+*
+* Arguments  : ptmr          Is a pointer to the timer
+*
+*              pfnct         Is the callback that was called
+*
+*              parg          Is the argument it was called with
+*
+*              cycles        Is the time spent in the callback, in OSCPUCyclesGet() cycles
+*
+*              late          Is the time from the OSTmrSignal() of the current timer tick to the start of the callback
+*
+*              late_ticks    Is the number of timer ticks still pending, i.e. how many ticks after its match it ran
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_STATS_EN > 0
+static  void  OSTmr_Stats (OS_TMR *ptmr, OS_TMR_CALLBACK pfnct, void *parg,
+                           INT32U cycles, INT32U late, INT32U late_ticks)
+{
+    if ((ptmr->OSTmrState       == OS_TMR_STATE_UNUSED) ||         /* Timer was deleted ...                           */
+        (ptmr->OSTmrCallback    != pfnct)               ||         /* ... and maybe created again                     */
+        (ptmr->OSTmrCallbackArg != parg)) {
+        return;
+    }
+    ptmr->OSTmrCallCtr++;
+    ptmr->OSTmrCyclesTot += cycles;
+    if (cycles > ptmr->OSTmrCyclesMax) {
+        ptmr->OSTmrCyclesMax = cycles;
+    }
+    ptmr->OSTmrLateTot += late;
+    if (late > ptmr->OSTmrLateMax) {
+        ptmr->OSTmrLateMax = late;
+    }
+    if (late_ticks > ptmr->OSTmrLateTicksMax) {
+        ptmr->OSTmrLateTicksMax = late_ticks;
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                      QUEUE AN EXPIRY TO THE DISPATCH TASK OF A TIMER
+*
+* Description: This function is called by OSTmr_Task() when a timer with a dispatch level expires.  A timer is in the
+*              queue of its dispatch task at most once, with the number of expiries still to call back.
+*
+* Arguments  : ptmr          Is a pointer to the timer that expired
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_DISP_EN > 0
+static  void  OSTmr_DispPut (OS_TMR *ptmr)
+{
+    OS_TMR_DISP  *pdisp;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR     cpu_sr = 0;
+#endif
+
+
+    pdisp = &OSTmrDispTbl[ptmr->OSTmrDispLevel - 1];
+    OS_ENTER_CRITICAL();                               /* The dispatch task does not lock the timers                  */
+    if (ptmr->OSTmrDispCtr == 0) {                     /* Append the timer to the queue                               */
+        ptmr->OSTmrDispNext = (OS_TMR *)0;
+        if (pdisp->OSDispLast == (OS_TMR *)0) {
+            pdisp->OSDispFirst = ptmr;
+        } else {
+            pdisp->OSDispLast->OSTmrDispNext = ptmr;
+        }
+        pdisp->OSDispLast = ptmr;
+#if OS_TMR_STATS_EN > 0
+        ptmr->OSTmrDispTs   = OSTmrSignalTs;
+        ptmr->OSTmrDispTime = OSTmrTime;
+#endif
+    }
+    if (ptmr->OSTmrDispCtr < 65535u) {
+        ptmr->OSTmrDispCtr++;
+    }
+    OS_EXIT_CRITICAL();
+    (void)OSSemPost(pdisp->OSDispSem);
+}
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                   REMOVE A TIMER FROM THE QUEUE OF ITS DISPATCH TASK
+*
+* Description: This function is called with the timers locked to discard the expiries of 'ptmr' that were not
+*              dispatched yet.  The dispatch task ignores the extra counts left in its semaphore.
+*
+* Arguments  : ptmr          Is a pointer to the timer
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_DISP_EN > 0
+static  void  OSTmr_DispRemove (OS_TMR *ptmr)
+{
+    OS_TMR_DISP  *pdisp;
+    OS_TMR       *pprev;
+    OS_TMR       *pnext;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR     cpu_sr = 0;
+#endif
+
+
+    if (ptmr->OSTmrDispLevel == OS_TMR_DISP_TMR_TASK) {
+        return;
+    }
+    pdisp = &OSTmrDispTbl[ptmr->OSTmrDispLevel - 1];
+    OS_ENTER_CRITICAL();
+    if (ptmr->OSTmrDispCtr > 0) {                      /* Queued: find the timer in front of it                       */
+        pprev = (OS_TMR *)0;
+        pnext = pdisp->OSDispFirst;
+        while (pnext != ptmr) {
+            pprev = pnext;
+            pnext = pnext->OSTmrDispNext;
+        }
+        if (pprev == (OS_TMR *)0) {
+            pdisp->OSDispFirst   = ptmr->OSTmrDispNext;
+        } else {
+            pprev->OSTmrDispNext = ptmr->OSTmrDispNext;
+        }
+        if (pdisp->OSDispLast == ptmr) {
+            pdisp->OSDispLast    = pprev;
+        }
+        ptmr->OSTmrDispNext = (OS_TMR *)0;
+        ptmr->OSTmrDispCtr  = 0;
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -1083,34 +1675,150 @@ static  void  OSTmr_Task (void *p_arg)
     OS_TMR_CALLBACK  pfnct;
     OS_TMR_WHEEL    *pspoke;
     INT16U           spoke;
+    INT32U           now;
+#if OS_TMR_STATS_EN > 0
+    void            *parg;
+    INT32U           tick_ts;
+    INT32U           late_ticks;
+    INT32U           start;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR        cpu_sr = 0;
+#endif
+#endif
 
 
     (void)p_arg;                                                 /* Not using 'p_arg', prevent compiler warning       */
     for (;;) {
         OSSemPend(OSTmrSemSignal, 0, &err);                      /* Wait for signal indicating time to update timers  */
         OSTmr_Lock();
-        OSTmrTime++;                                             /* Increment the current time                        */
-        spoke  = (INT16U)(OSTmrTime % OS_TMR_CFG_WHEEL_SIZE);    /* Position on current timer wheel entry             */
-        pspoke = &OSTmrWheelTbl[spoke];
-        ptmr   = pspoke->OSTmrFirst;
-        while (ptmr != (OS_TMR *)0) {
-            ptmr_next = (OS_TMR *)ptmr->OSTmrNext;               /* Point to next timer to update because current ... */
+        now = (INT32U)(OSTimeGet64() / OS_TMR_TICK_DIV);         /* Timer time follows the kernel's 64-bit tick count */
+#if OS_TMR_STATS_EN > 0
+        OS_ENTER_CRITICAL();
+        tick_ts = OSTmrSignalTs;                                 /* Start of the newest timer tick                    */
+        OS_EXIT_CRITICAL();
+#endif
+        while (OSTmrTime != now) {                               /* Handle every timer tick up to now, in order       */
+            OSTmrTime++;                                         /* Increment the current time                        */
+#if OS_TMR_STATS_EN > 0
+            late_ticks = now - OSTmrTime;                        /* Nbr of ticks elapsed after the one handled here   */
+#endif
+#if OS_TMR_HWHEEL_EN > 0
+            if ((OSTmrTime & OS_TMR_HWHEEL_MASK) == 0) {         /* Move timers down from the higher levels           */
+                OSTmr_Cascade();
+            }
+            spoke  = (INT16U)(OSTmrTime & OS_TMR_HWHEEL_MASK);   /* Level 0 spoke: the timers expiring now            */
+#else
+            spoke  = (INT16U)(OSTmrTime % OS_TMR_CFG_WHEEL_SIZE);/* Position on current timer wheel entry             */
+#endif
+            pspoke = &OSTmrWheelTbl[spoke];
+            ptmr   = pspoke->OSTmrFirst;
+            while (ptmr != (OS_TMR *)0) {
+                ptmr_next = (OS_TMR *)ptmr->OSTmrNext;           /* Point to next timer to update because current ... */
                                                                  /* ... timer could get unlinked from the wheel.      */
-            if (OSTmrTime == ptmr->OSTmrMatch) {                 /* Process each timer that expires                   */
-                pfnct = ptmr->OSTmrCallback;                     /* Execute callback function if available            */
-                if (pfnct != (OS_TMR_CALLBACK)0) {
-                    (*pfnct)((void *)ptmr, ptmr->OSTmrCallbackArg);
-                }
-                OSTmr_Unlink(ptmr);                              /* Remove from current wheel spoke                   */
-                if (ptmr->OSTmrOpt == OS_TMR_OPT_PERIODIC) {
-                    OSTmr_Link(ptmr, OS_TMR_LINK_PERIODIC);      /* Recalculate new position of timer in wheel        */
-                } else {
-                    ptmr->OSTmrState = OS_TMR_STATE_COMPLETED;   /* Indicate that the timer has completed             */
+                if (OSTmrTime == ptmr->OSTmrMatch) {             /* Process each timer that expires                   */
+                    pfnct = ptmr->OSTmrCallback;                 /* Execute callback function if available            */
+#if OS_TMR_DISP_EN > 0
+                    if (ptmr->OSTmrDispSem != (OS_EVENT *)0) {   /* Release the task waiting for the timer first      */
+                        (void)OSSemPost(ptmr->OSTmrDispSem);
+                    }
+                    if ((pfnct != (OS_TMR_CALLBACK)0) && (ptmr->OSTmrDispLevel != OS_TMR_DISP_TMR_TASK)) {
+                        OSTmr_DispPut(ptmr);                     /* Callback is called by the dispatch task           */
+                        pfnct = (OS_TMR_CALLBACK)0;
+                    }
+#endif
+                    if (pfnct != (OS_TMR_CALLBACK)0) {
+#if OS_TMR_STATS_EN > 0
+                        parg  = ptmr->OSTmrCallbackArg;
+                        start = OSCPUCyclesGet();
+                        (*pfnct)((void *)ptmr, parg);
+                        OSTmr_Stats(ptmr, pfnct, parg, OSCPUCyclesGet() - start, start - tick_ts, late_ticks);
+#else
+                        (*pfnct)((void *)ptmr, ptmr->OSTmrCallbackArg);
+#endif
+                    }
+                    OSTmr_Unlink(ptmr);                          /* Remove from current wheel spoke                   */
+                    if (ptmr->OSTmrOpt == OS_TMR_OPT_PERIODIC) {
+                        OSTmr_Link(ptmr, OS_TMR_LINK_PERIODIC);  /* Recalculate new position of timer in wheel        */
+                    } else {
+                        ptmr->OSTmrState = OS_TMR_STATE_COMPLETED; /* Indicate that the timer has completed           */
+                    }
                 }
+                ptmr = ptmr_next;
             }
-            ptmr = ptmr_next;
         }
         OSTmr_Unlock();
     }
 }
 #endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                                  TIMER DISPATCH TASK
+*
+* Description: This task is created by OSTmr_InitDisp() for each dispatch level.  It calls the callbacks queued by
+*              OSTmr_Task(), one expiry per count of its semaphore, at the priority of its level.  The timers are not
+*              locked while a callback runs, so a callback may use the timer services.
+*
+* Arguments  : p_arg         Is a pointer to the OS_TMR_DISP of the level
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0 && OS_TMR_DISP_EN > 0
+static  void  OSTmr_DispTask (void *p_arg)
+{
+    INT8U            err;
+    OS_TMR_DISP     *pdisp;
+    OS_TMR          *ptmr;
+    OS_TMR_CALLBACK  pfnct;
+    void            *parg;
+#if OS_TMR_STATS_EN > 0
+    INT32U           queued_ts;
+    INT32U           queued_time;
+    INT32U           start;
+    INT32U           cycles;
+#endif
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR        cpu_sr = 0;
+#endif
+
+
+    pdisp = (OS_TMR_DISP *)p_arg;
+    for (;;) {
+        OSSemPend(pdisp->OSDispSem, 0, &err);                    /* Wait for an expiry to dispatch                    */
+        OS_ENTER_CRITICAL();
+        ptmr = pdisp->OSDispFirst;
+        if (ptmr == (OS_TMR *)0) {                               /* Expiry was discarded by OSTmr_DispRemove()        */
+            OS_EXIT_CRITICAL();
+            continue;
+        }
+        pfnct = ptmr->OSTmrCallback;
+        parg  = ptmr->OSTmrCallbackArg;
+#if OS_TMR_STATS_EN > 0
+        queued_ts   = ptmr->OSTmrDispTs;
+        queued_time = ptmr->OSTmrDispTime;
+#endif
+        ptmr->OSTmrDispCtr--;
+        if (ptmr->OSTmrDispCtr == 0) {                           /* Last expiry of the timer, remove it from queue    */
+            pdisp->OSDispFirst = ptmr->OSTmrDispNext;
+            if (pdisp->OSDispFirst == (OS_TMR *)0) {
+                pdisp->OSDispLast = (OS_TMR *)0;
+            }
+            ptmr->OSTmrDispNext = (OS_TMR *)0;
+        }
+        OS_EXIT_CRITICAL();
+#if OS_TMR_STATS_EN > 0
+        start  = OSCPUCyclesGet();
+        (*pfnct)((void *)ptmr, parg);
+        cycles = OSCPUCyclesGet() - start;
+        OS_ENTER_CRITICAL();
+        OSTmr_Stats(ptmr, pfnct, parg, cycles, start - queued_ts, OSTmrTime - queued_time);
+        OS_EXIT_CRITICAL();
+#else
+        (*pfnct)((void *)ptmr, parg);
+#endif
+    }
+}
+#endif
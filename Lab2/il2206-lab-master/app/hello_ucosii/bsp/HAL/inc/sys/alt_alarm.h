@@ -104,12 +104,21 @@ static ALT_INLINE int ALT_ALWAYS_INLINE alt_sysclk_init (alt_u32 nticks)
 }
 
 /*
- * alt_nticks() returns the elapsed number of system clock ticks since reset.
+ * alt_nticks64() returns the elapsed number of system clock ticks since reset.
+ * This is the time base of the alarms, and under uC/OS-II also that of the
+ * kernel (OSTimeGet64()). It can be called at interrupt level.
+ */
+
+extern alt_u64 alt_nticks64 (void);
+
+/*
+ * alt_nticks() returns the low 32 bits of alt_nticks64(). Use 
+ * alt_nticks64() where the value may be kept for more than 2^32 ticks.
  */
 
 static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_nticks (void)
 {
-  return _alt_nticks;
+  return (alt_u32) alt_nticks64 ();
 }
 
 /*
@@ -119,6 +128,43 @@ static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_nticks (void)
 
 extern void alt_tick (void);
 
+/*
+ * alt_tick_n() has the effect of "nticks" calls to alt_tick(), but advances
+ * the tick count and the operating system in one step. It is used by the
+ * system clock driver to replay the ticks skipped in the tickless idle mode.
+ */
+
+extern void alt_tick_n (alt_u32 nticks);
+
+/*
+ * alt_alarm_next() returns the number of system clock ticks until the next
+ * registered alarm expires, or zero if no alarm is registered. It must be
+ * called with interrupts disabled.
+ */
+
+extern alt_u32 alt_alarm_next (void);
+
+/*
+ * alt_sysclk_suspend() and alt_sysclk_resume() are provided by the system 
+ * clock driver in order to support a tickless idle mode. 
+ *
+ * alt_sysclk_suspend() asks the driver to raise the next timer interrupt 
+ * "nticks" ticks from now rather than on the next tick. It returns the number 
+ * of ticks actually skipped, which can be less than requested (or zero) if 
+ * the timer range does not allow it. All skipped ticks are passed to 
+ * alt_tick_n() when the timer interrupt occurs.
+ *
+ * alt_sysclk_resume() cuts a suspended period short, e.g. because another 
+ * interrupt made a task ready. The ticks that have elapsed are passed to 
+ * alt_tick_n() before it returns, and the periodic tick is restarted in phase 
+ * with the original tick.
+ *
+ * Both functions must be called with interrupts disabled.
+ */
+
+extern alt_u32 alt_sysclk_suspend (alt_u32 nticks);
+extern void    alt_sysclk_resume (void);
+
 #ifdef __cplusplus
 }
 #endif
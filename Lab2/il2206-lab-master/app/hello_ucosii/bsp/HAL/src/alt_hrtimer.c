@@ -0,0 +1,131 @@
+/******************************************************************************
+*                                                                             *
+* alt_hrtimer.c - high resolution timers.                                     *
+*                                                                             *
+* Running timers are kept in a list ordered by expiry time, so that the       *
+* driver only has to be programmed for the first one and the interrupt        *
+* handler stops at the first timer that has not expired. See                  *
+* sys/alt_hrtimer.h.                                                          *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+
+#include "sys/alt_hrtimer.h"
+#include "sys/alt_irq.h"
+
+alt_u32 _alt_hrtimer_freq = 0;
+
+static ALT_LLIST_HEAD(alt_hrtimer_list);
+
+/*
+ * alt_hrtimer_cycles() converts microseconds to timer clock cycles.
+ */
+
+static alt_u64 alt_hrtimer_cycles (alt_u32 usec)
+{
+  return (alt_u64) usec * _alt_hrtimer_freq / 1000000;
+}
+
+/*
+ * alt_hrtimer_insert() links a timer after all timers that expire at the
+ * same time or earlier, and returns non zero if it became the first one.
+ */
+
+static int alt_hrtimer_insert (alt_hrtimer* timer)
+{
+  alt_llist* next = alt_hrtimer_list.next;
+
+  while ((next != &alt_hrtimer_list) &&
+         (((alt_hrtimer*) next)->time <= timer->time))
+  {
+    next = next->next;
+  }
+  alt_llist_insert (next->previous, &timer->llist);
+
+  return alt_hrtimer_list.next == &timer->llist;
+}
+
+int alt_hrtimer_start (alt_hrtimer* timer,
+                       alt_u32      usec,
+                       alt_u32      (*callback) (void* context),
+                       void*        context)
+{
+  alt_irq_context irq_context;
+
+  if (!_alt_hrtimer_freq)
+  {
+    return -ENOTSUP;
+  }
+  if (!timer)
+  {
+    return -EINVAL;
+  }
+
+  timer->callback = callback;
+  timer->context  = context;
+
+  irq_context = alt_irq_disable_all ();
+  timer->time = alt_hrtimer_clock () + alt_hrtimer_cycles (usec);
+  if (alt_hrtimer_insert (timer))
+  {
+    alt_hrtimer_set (timer->time);
+  }
+  alt_irq_enable_all (irq_context);
+
+  return 0;
+}
+
+/*
+ * The driver is not reprogrammed when the first timer is stopped; the
+ * interrupt then finds nothing to do and programs the next expiry.
+ */
+
+void alt_hrtimer_stop (alt_hrtimer* timer)
+{
+  alt_irq_context irq_context;
+
+  irq_context = alt_irq_disable_all ();
+  alt_llist_remove (&timer->llist);
+  alt_irq_enable_all (irq_context);
+}
+
+/*
+ * A periodic timer that falls behind, e.g. because its period is shorter
+ * than the time spent in the callbacks, is run again at once until it has
+ * caught up.
+ */
+
+void alt_hrtimer_expire (void)
+{
+  alt_hrtimer* timer;
+  alt_u64      now;
+  alt_u32      next;
+
+  now = alt_hrtimer_clock ();
+  while (alt_hrtimer_list.next != &alt_hrtimer_list)
+  {
+    timer = (alt_hrtimer*) alt_hrtimer_list.next;
+    if (timer->time > now)
+    {
+      break;
+    }
+    alt_llist_remove (&timer->llist);
+    next = timer->callback (timer->context);
+    if (next)
+    {
+      timer->time += alt_hrtimer_cycles (next);
+      alt_hrtimer_insert (timer);
+    }
+    now = alt_hrtimer_clock ();
+  }
+
+  if (alt_hrtimer_list.next != &alt_hrtimer_list)
+  {
+    alt_hrtimer_set (((alt_hrtimer*) alt_hrtimer_list.next)->time);
+  }
+  else
+  {
+    alt_hrtimer_set (ALT_HRTIMER_NONE);
+  }
+}
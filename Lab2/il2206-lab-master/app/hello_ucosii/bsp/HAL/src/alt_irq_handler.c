@@ -41,6 +41,7 @@
 #ifndef ALT_CPU_EIC_PRESENT
 
 #include "sys/alt_irq.h"
+#include "sys/alt_irq_stats.h"
 #include "os/alt_hooks.h"
 
 #include "alt_types.h"
@@ -74,6 +75,9 @@ struct ALT_IRQ_HANDLER
  * If Nios II interrupt vector custom instruction exists, use it to accelerate
  * the dispatch of interrupt handlers.  The Nios II interrupt vector custom 
  * instruction is present if the macro ALT_CI_INTERRUPT_VECTOR defined.
+ *
+ * When ALT_IRQ_STATS_EN is set (see sys/alt_irq_stats.h), the time each 
+ * handler is called, how long it runs and the nesting depth are recorded.
  */
 
 void alt_irq_handler (void) __attribute__ ((section (".exceptions")));
@@ -87,6 +91,13 @@ void alt_irq_handler (void)
   alt_u32 mask;
   alt_u32 i;
 #endif /* ALT_CI_INTERRUPT_VECTOR */
+#if ALT_IRQ_STATS_EN > 0
+  alt_u32 entry;
+  alt_u32 start;
+
+  entry = (alt_u32) alt_timestamp ();
+  alt_irq_stats_enter ();
+#endif /* ALT_IRQ_STATS_EN */
   
   /*
    * Notify the operating system that we are at interrupt level.
@@ -105,10 +116,16 @@ void alt_irq_handler (void)
   while ((offset = ALT_CI_INTERRUPT_VECTOR) >= 0) {
     struct ALT_IRQ_HANDLER* handler_entry = 
       (struct ALT_IRQ_HANDLER*)(alt_irq_base + offset);
+#if ALT_IRQ_STATS_EN > 0
+    start = (alt_u32) alt_timestamp ();
+#endif
 #ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
     handler_entry->handler(handler_entry->context);
 #else
     handler_entry->handler(handler_entry->context, offset >> 3);
+#endif
+#if ALT_IRQ_STATS_EN > 0
+    alt_irq_stats_call (offset >> 3, entry, start);
 #endif
   }
 #else /* ALT_CI_INTERRUPT_VECTOR */
@@ -142,10 +159,16 @@ void alt_irq_handler (void)
     {
       if (active & mask)
       { 
+#if ALT_IRQ_STATS_EN > 0
+        start = (alt_u32) alt_timestamp ();
+#endif
 #ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
         alt_irq[i].handler(alt_irq[i].context); 
 #else
         alt_irq[i].handler(alt_irq[i].context, i); 
+#endif
+#if ALT_IRQ_STATS_EN > 0
+        alt_irq_stats_call (i, entry, start);
 #endif
         break;
       }
@@ -159,6 +182,10 @@ void alt_irq_handler (void)
   } while (active);
 #endif /* ALT_CI_INTERRUPT_VECTOR */
 
+#if ALT_IRQ_STATS_EN > 0
+  alt_irq_stats_exit ();
+#endif
+
   /*
    * Notify the operating system that interrupt processing is complete.
    */ 
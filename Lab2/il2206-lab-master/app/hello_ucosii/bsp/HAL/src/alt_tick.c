@@ -45,18 +45,60 @@ alt_u32 _alt_tick_rate = 0;
 
 /*
  * "_alt_nticks" is the number of system clock ticks that have elapsed since
- * reset. 
+ * reset. When the operating system counts the ticks itself (ALT_OS_NTICKS in
+ * os/alt_hooks.h), its counter is used instead, so that alarms and OS delays
+ * are based on the same time.
  */
 
-volatile alt_u32 _alt_nticks = 0;
+#ifndef ALT_OS_NTICKS
+volatile alt_u64 _alt_nticks = 0;
+#endif
 
 /*
- * "alt_alarm_list" is the head of a linked list of registered alarms. This is
- * initialised to be an empty list.
+ * alt_nticks64() is the one way to read the tick count. A 64 bit value takes
+ * two loads, so interrupts are disabled around them.
+ */
+
+alt_u64 alt_nticks64 (void)
+{
+#ifdef ALT_OS_NTICKS
+  return ALT_OS_NTICKS ();
+#else
+  alt_irq_context irq_context;
+  alt_u64         nticks;
+
+  irq_context = alt_irq_disable_all ();
+  nticks      = _alt_nticks;
+  alt_irq_enable_all (irq_context);
+
+  return nticks;
+#endif
+}
+
+/*
+ * "alt_alarm_list" is the head of a linked list of registered alarms, ordered
+ * by expiry time. This is initialised to be an empty list.
  */
 
 ALT_LLIST_HEAD(alt_alarm_list);
 
+/*
+ * alt_alarm_insert() walks the list to the first alarm that is due later than
+ * "alarm", so that alarms due on the same tick run in the order they were
+ * registered.
+ */
+
+void alt_alarm_insert (alt_alarm* alarm)
+{
+  alt_llist* next = alt_alarm_list.next;
+
+  while ((next != &alt_alarm_list) && (((alt_alarm*) next)->time <= alarm->time))
+  {
+    next = next->next;
+  }
+  alt_llist_insert (next->previous, &alarm->llist);
+}
+
 /*
  * alt_alarm_stop() is called to remove an alarm from the list of registered 
  * alarms. Alternatively an alarm can unregister itself by returning zero when 
@@ -73,77 +115,134 @@ void alt_alarm_stop (alt_alarm* alarm)
 }
 
 /*
- * alt_tick() is periodically called by the system clock driver in order to
- * process the registered list of alarms. Each alarm is registed with a
- * callback interval, and a callback function, "callback". 
+ * alt_alarm_next() returns the number of ticks until the first registered
+ * alarm is due, or zero if there are no alarms. It is used by the tickless
+ * idle mode to decide for how long the system clock can be suspended. 
+ *
+ * This should be called with interrupts disabled.
+ */
+
+alt_u32 alt_alarm_next (void)
+{
+  alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
+  alt_u64    now;
+  alt_u64    remain;
+
+  if (alarm == (alt_alarm*) &alt_alarm_list)
+  {
+    return 0;
+  }
+
+  /* An alarm whose time has already passed fires on the next tick. */
+
+  now    = alt_nticks64 ();
+  remain = (alarm->time > now) ? alarm->time - now : 1;
+
+  return (remain > 0xFFFFFFFF) ? 0xFFFFFFFF : (alt_u32) remain;
+}
+
+/*
+ * alt_alarm_run() processes the list of registered alarms. Each alarm is
+ * registed with a callback interval, and a callback function, "callback". 
  *
  * The return value of the callback function indicates how many ticks are to
  * elapse until the next callback. A return value of zero indicates that the
  * alarm should be deactivated. 
- * 
- * alt_tick() is expected to run at interrupt level.
+ *
+ * Since the list is ordered, only the alarms that are due are visited; on
+ * most ticks that is a single comparison with the first alarm. An alarm
+ * stays in the list while its callback runs, so that a callback which stops
+ * its own alarm has the same effect as returning zero. An alarm that was due
+ * more than once since the last call runs until it has caught up.
  */
 
-void alt_tick (void)
+static void alt_alarm_run (void)
 {
-  alt_alarm* next;
-  alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
-
+  alt_alarm* alarm;
+  alt_u64    now;
   alt_u32    next_callback;
 
-  /* update the tick counter */
+  now = alt_nticks64 ();
 
-  _alt_nticks++;
+  /* process the registered callbacks that are due */
 
-  /* process the registered callbacks */
-
-  while (alarm != (alt_alarm*) &alt_alarm_list)
+  while (alt_alarm_list.next != &alt_alarm_list)
   {
-    next = (alt_alarm*) alarm->llist.next;
-
-    /* 
-     * Upon the tick-counter rolling over it is safe to clear the 
-     * roll-over flag; once the flag is cleared this (or subsequnt)
-     * tick events are enabled to generate an alarm event. 
-     */
-    if ((alarm->rollover) && (_alt_nticks == 0))
+    alarm = (alt_alarm*) alt_alarm_list.next;
+    if (alarm->time > now)
+    {
+      break;
+    }
+
+    next_callback = alarm->callback (alarm->context);
+
+    /* deactivate the alarm if the return value is zero */
+
+    if (next_callback == 0)
     {
-      alarm->rollover = 0;
+      alt_alarm_stop (alarm);
     }
-    
-    /* if the alarm period has expired, make the callback */    
-    if ((alarm->time <= _alt_nticks) && (alarm->rollover == 0))
+    else if (alarm->llist.next != &alarm->llist)
     {
-      next_callback = alarm->callback (alarm->context);
-
-      /* deactivate the alarm if the return value is zero */
-
-      if (next_callback == 0)
-      {
-        alt_alarm_stop (alarm);
-      }
-      else
-      {
-        alarm->time += next_callback;
-        
-        /* 
-         * If the desired alarm time causes a roll-over, set the rollover
-         * flag. This will prevent the subsequent tick event from causing
-         * an alarm too early.
-         */
-        if(alarm->time < _alt_nticks)
-        {
-          alarm->rollover = 1;
-        }
-      }
+      alt_llist_remove (&alarm->llist);
+      alarm->time += next_callback;
+      alt_alarm_insert (alarm);
     }
-    alarm = next;
   }
+}
 
+/*
+ * alt_tick() is periodically called by the system clock driver in order to
+ * process the registered list of alarms.
+ *
+ * The operating system is notified of the tick before the alarms run, so
+ * that both see the same, updated, tick count.
+ * 
+ * alt_tick() is expected to run at interrupt level.
+ */
+
+void alt_tick (void)
+{
   /* 
-   * Update the operating system specific timer facilities.
+   * Update the tick counter, and the operating system specific timer 
+   * facilities. 
    */
 
+#ifndef ALT_OS_NTICKS
+  _alt_nticks++;
+#endif
   ALT_OS_TIME_TICK();
+
+  alt_alarm_run ();
 }
 
+/*
+ * alt_tick_n() is called by the system clock driver in place of "nticks"
+ * calls to alt_tick(), for the ticks skipped in the tickless idle mode. The
+ * tick count and the operating system are advanced by "nticks" in one step
+ * (ALT_OS_TIME_TICK_N), then the alarms that fell due run once.
+ *
+ * alt_tick_n() is expected to run at interrupt level.
+ */
+
+void alt_tick_n (alt_u32 nticks)
+{
+  if (nticks == 0)
+  {
+    return;
+  }
+
+#ifndef ALT_OS_NTICKS
+  _alt_nticks += nticks;
+#endif
+#ifdef ALT_OS_TIME_TICK_N
+  ALT_OS_TIME_TICK_N (nticks);
+#else
+  while (nticks--)
+  {
+    ALT_OS_TIME_TICK();
+  }
+#endif
+
+  alt_alarm_run ();
+}
@@ -82,6 +82,8 @@ typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity
 typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
 typedef unsigned long  INT32U;                   /* Unsigned 32 bit quantity                           */
 typedef signed   long  INT32S;                   /* Signed   32 bit quantity                           */
+typedef unsigned long long INT64U;               /* Unsigned 64 bit quantity                           */
+typedef signed   long long INT64S;               /* Signed   64 bit quantity                           */
 typedef float          FP32;                     /* Single precision floating point                    */
 typedef double         FP64;                     /* Double precision floating point                    */
 typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits                        */
@@ -91,7 +93,20 @@ typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits
 ****************************************************************************/
 
 #define  OS_STK_GROWTH        1        /* Stack grows from HIGH to LOW memory */
-#define  OS_TASK_SW           OSCtxSw  
+#define  OS_TASK_SW           OSCtxSw
+
+/*
+ * Interrupts and tasks run on the same core, so keeping the compiler from
+ * reordering memory accesses is enough to order them for an ISR.
+ */
+#define  OS_CPU_BARRIER()     __asm__ __volatile__ ("" ::: "memory")
+
+/*
+ * The Nios2 has no count leading/trailing zeros instruction (and gcc's
+ * __builtin_ctz() goes through a 256 byte table in libgcc), so
+ * OS_CPU_CNT_TRAIL_ZEROS() is left undefined and uC/OS-II uses the
+ * branch free OS_CntTrailZeros() when OS_SCHED_FFS_EN is enabled.
+ */
 
 /******************************************************************************************
  *                Disable and Enable Interrupts - 2 methods
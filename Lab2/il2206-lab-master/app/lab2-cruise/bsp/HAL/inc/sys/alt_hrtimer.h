@@ -0,0 +1,122 @@
+#ifndef __ALT_HRTIMER_H__
+#define __ALT_HRTIMER_H__
+
+/******************************************************************************
+*                                                                             *
+* alt_hrtimer.h - high resolution timers.                                     *
+*                                                                             *
+* The alarms of alt_alarm.h run on system clock ticks. High resolution timers *
+* run on a dedicated interval timer instead, selected by defining             *
+* ALT_HRTIMER_CLK to its name in system.h, e.g. with                          *
+*                                                                             *
+*   --set hal.make.bsp_cflags_defined_symbols -DALT_HRTIMER_CLK=TIMER_1       *
+*                                                                             *
+* The timer must have a writable period register and an interrupt, and must   *
+* not also be the system clock or the timestamp timer. Its driver is          *
+* programmed to interrupt at the first expiry of all started timers only, so  *
+* a 5 ms control loop can be released on time without raising the tick rate.  *
+*                                                                             *
+******************************************************************************/
+
+#include "alt_llist.h"
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * "alt_hrtimer" is the structure type used by applications to register a
+ * high resolution timer callback. An instance is passed to
+ * alt_hrtimer_start(), which initialises it; it must stay allocated until
+ * the timer has been stopped or its callback returned zero.
+ */
+
+typedef struct alt_hrtimer_s alt_hrtimer;
+
+struct alt_hrtimer_s
+{
+  alt_llist llist;                      /* Position in the ordered list    */
+  alt_u64   time;                       /* Expiry, in alt_hrtimer_clock()  */
+  alt_u32   (*callback) (void* context);
+  void*     context;
+};
+
+/*
+ * alt_hrtimer_start() registers a callback to run "usec" microseconds from
+ * now. The callback runs in interrupt context; its return value is the time
+ * in microseconds from this expiry to the next one, or zero to stop the
+ * timer. Since the next expiry is computed from the previous one rather than
+ * from the time the callback ran, periodic timers do not drift.
+ *
+ * A timer that is already running must be stopped first. The function
+ * returns -ENOTSUP if no high resolution timer was selected, -EINVAL if
+ * "timer" is NULL, and zero otherwise.
+ */
+
+extern int alt_hrtimer_start (alt_hrtimer* timer,
+                              alt_u32      usec,
+                              alt_u32      (*callback) (void* context),
+                              void*        context);
+
+/*
+ * alt_hrtimer_stop() unregisters a timer. It does nothing if the timer was
+ * already stopped, or its callback returned zero.
+ */
+
+extern void alt_hrtimer_stop (alt_hrtimer* timer);
+
+/*
+ * Frequency of alt_hrtimer_clock() in Hz, zero if no high resolution timer
+ * was selected.
+ */
+
+extern alt_u32 _alt_hrtimer_freq;
+
+static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_hrtimer_freq (void)
+{
+  return _alt_hrtimer_freq;
+}
+
+/*
+ * alt_hrtimer_init() is only used by the high resolution timer driver, to
+ * set the frequency of its clock.
+ */
+
+static ALT_INLINE void ALT_ALWAYS_INLINE alt_hrtimer_init (alt_u32 freq)
+{
+  _alt_hrtimer_freq = freq;
+}
+
+/*
+ * alt_hrtimer_expire() is called by the interrupt handler of the driver,
+ * with interrupts disabled. It runs the callbacks of all expired timers and
+ * programs the next interrupt with alt_hrtimer_set().
+ */
+
+extern void alt_hrtimer_expire (void);
+
+/*
+ * The functions below are provided by the high resolution timer driver. Both
+ * must be called with interrupts disabled.
+ *
+ * alt_hrtimer_clock() returns the number of timer clock cycles since the
+ * timer was initialised.
+ *
+ * alt_hrtimer_set() programs the timer to interrupt at "time", in the same
+ * unit, or as soon as possible if "time" has passed. ALT_HRTIMER_NONE means
+ * that no timer is running; the driver then only interrupts as often as it
+ * needs to keep alt_hrtimer_clock() running.
+ */
+
+#define ALT_HRTIMER_NONE 0xFFFFFFFFFFFFFFFFULL
+
+extern alt_u64 alt_hrtimer_clock (void);
+extern void    alt_hrtimer_set (alt_u64 time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ALT_HRTIMER_H__ */
@@ -0,0 +1,120 @@
+#ifndef __ALT_IRQ_STATS_H__
+#define __ALT_IRQ_STATS_H__
+
+/******************************************************************************
+*                                                                             *
+* alt_irq_stats.h - per interrupt service statistics.                         *
+*                                                                             *
+* When OS_IRQ_STATS_EN is set in os_cfg.h and a timestamp timer is selected   *
+* (hal.timestamp_timer), alt_irq_handler() records for every IRQ number when  *
+* its handler was last entered, how long the handler ran and how deeply       *
+* interrupts were nested at the time. All times are in timestamp timer        *
+* ticks (alt_timestamp_freq() per second).                                    *
+*                                                                             *
+* A low priority task can read the tables with alt_irq_stats_get(), e.g. to   *
+* find out which handlers delay the tasks with tight deadlines.               *
+*                                                                             *
+* The interrupt handler then reads the timestamp timer, so tasks must         *
+* disable interrupts around their own calls of alt_timestamp().               *
+*                                                                             *
+******************************************************************************/
+
+#include "system.h"
+#include "alt_types.h"
+#include "os_cfg.h"
+#include "altera_avalon_timer.h"
+#include "sys/alt_irq.h"
+#include "sys/alt_timestamp.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#if (OS_IRQ_STATS_EN > 0) && (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+#define ALT_IRQ_STATS_EN 1
+#else
+#define ALT_IRQ_STATS_EN 0
+#endif
+
+/*
+ * Statistics of one IRQ number. The service time of a handler includes the
+ * handlers of any interrupts nested inside it. The wait time is the time
+ * from the start of alt_irq_handler() to the call of the handler, spent on
+ * interrupt entry and on serving other IRQs that were pending as well.
+ */
+typedef struct alt_irq_stats
+{
+  alt_u32 count;          /* Number of times the handler was called         */
+  alt_u32 entry_last;     /* Timestamp of the last call of the handler      */
+  alt_u32 wait_max;       /* Longest wait before the handler was called     */
+  alt_u32 time_last;      /* Service time of the last call                  */
+  alt_u32 time_max;       /* Longest service time                           */
+  alt_u64 time_total;     /* Sum of all service times, for the mean         */
+  alt_u32 nesting_max;    /* Deepest nesting, 1 when not nested             */
+} alt_irq_stats;
+
+/*
+ * alt_irq_stats_get() copies the statistics of an IRQ number, consistently.
+ * It returns -EINVAL if the IRQ number is out of range or the statistics
+ * are not compiled in, and zero otherwise. The mean service time is
+ * time_total / count.
+ *
+ * alt_irq_stats_reset() clears the statistics of all IRQ numbers.
+ */
+extern int  alt_irq_stats_get (alt_u32 irq, alt_irq_stats* stats);
+extern void alt_irq_stats_reset (void);
+
+#if ALT_IRQ_STATS_EN > 0
+
+extern alt_irq_stats alt_irq_stats_tbl[ALT_NIRQ];
+extern alt_u32       alt_irq_stats_depth;
+
+/*
+ * The hooks below are called by the interrupt handler, with interrupts
+ * disabled: alt_irq_stats_enter() on entry and alt_irq_stats_exit() on
+ * exit of the interrupt handler, alt_irq_stats_call() after the handler of
+ * an IRQ number has returned. 'entry' and 'start' are the timestamps of the
+ * start of the interrupt handler and of the call of the IRQ handler.
+ */
+static ALT_INLINE void ALT_ALWAYS_INLINE alt_irq_stats_enter (void)
+{
+  alt_irq_stats_depth++;
+}
+
+static ALT_INLINE void ALT_ALWAYS_INLINE alt_irq_stats_exit (void)
+{
+  alt_irq_stats_depth--;
+}
+
+static ALT_INLINE void ALT_ALWAYS_INLINE
+       alt_irq_stats_call (alt_u32 irq, alt_u32 entry, alt_u32 start)
+{
+  alt_irq_stats* stats = &alt_irq_stats_tbl[irq];
+  alt_u32        time  = (alt_u32) alt_timestamp () - start;
+
+  stats->count++;
+  stats->entry_last  = start;
+  stats->time_last   = time;
+  stats->time_total += time;
+  if (time > stats->time_max)
+  {
+    stats->time_max = time;
+  }
+  if (start - entry > stats->wait_max)
+  {
+    stats->wait_max = start - entry;
+  }
+  if (alt_irq_stats_depth > stats->nesting_max)
+  {
+    stats->nesting_max = alt_irq_stats_depth;
+  }
+}
+
+#endif /* ALT_IRQ_STATS_EN */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ALT_IRQ_STATS_H__ */
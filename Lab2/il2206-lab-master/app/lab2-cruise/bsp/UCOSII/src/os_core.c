@@ -32,9 +32,11 @@
 *
 * Note: Index into table is bit pattern to resolve highest priority
 *       Indexed value corresponds to highest priority bit position (i.e. 0..7)
+*       The table is not needed when OS_SCHED_FFS_EN is enabled (see OS_CntTrailZeros()).
 *********************************************************************************************************
 */
 
+#if OS_SCHED_FFS_EN == 0
 INT8U  const  OSUnMapTbl[256] = {
     0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x00 to 0x0F                             */
     4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x10 to 0x1F                             */
@@ -53,6 +55,7 @@ INT8U  const  OSUnMapTbl[256] = {
     5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0xE0 to 0xEF                             */
     4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0        /* 0xF0 to 0xFF                             */
 };
+#endif
 
 /*$PAGE*/
 /*
@@ -77,6 +80,28 @@ static  void  OS_InitTCBList(void);
 
 static  void  OS_SchedNew(void);
 
+static  void  OS_TimeTickAdvance(INT32U nticks);
+
+#if OS_SCHED_RR_EN > 0
+static  void     OS_RRHeadSet(OS_TCB *ptcb);
+
+static  OS_TCB  *OS_RRNextRdy(OS_TCB *ptcb);
+
+#if (OS_EVENT_EN)
+static  BOOLEAN  OS_RRTaskPend(OS_TCB *ptcb, OS_EVENT *pevent);
+
+static  OS_TCB  *OS_RREventNext(OS_TCB *ptcb, OS_EVENT *pevent);
+#endif
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+static  BOOLEAN  OS_EDFEarlier(OS_TCB *pa, OS_TCB *pb);
+
+static  void     OS_EDFHeapUp(INT8U ix);
+
+static  void     OS_EDFHeapDown(INT8U ix);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -137,6 +162,8 @@ INT8U  OSEventNameGet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_STATE:
+        case OS_EVENT_TYPE_POLL:
              break;
 
         default:
@@ -211,6 +238,8 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_STATE:
+        case OS_EVENT_TYPE_POLL:
              break;
 
         default:
@@ -303,7 +332,7 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
 */
 /*$PAGE*/
 #if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
-INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void **pmsgs_rdy, INT16U timeout, INT8U *perr)
+INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void **pmsgs_rdy, INT32U timeout, INT8U *perr)
 {
     OS_EVENT  **pevents;
     OS_EVENT   *pevent;
@@ -312,7 +341,7 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
 #endif
     BOOLEAN     events_rdy;
     INT16U      events_rdy_nbr;
-    INT8U       events_stat;
+    INT16U      events_stat;
 #if (OS_CRITICAL_METHOD == 3)                           /* Allocate storage for CPU status register    */
     OS_CPU_SR   cpu_sr = 0;
 #endif
@@ -458,7 +487,11 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
     OSTCBCur->OSTCBStat     |= events_stat  |           /* Resource not available, ...                 */
                                OS_STAT_MULTI;           /* ... pend on multiple events                 */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_TICK_LIST_EN > 0
+    OS_TickListInsert(OSTCBCur, timeout);               /* Store pend timeout in TCB and tick list     */
+#else
     OSTCBCur->OSTCBDly       = timeout;                 /* Store pend timeout in TCB                   */
+#endif
     OS_EventTaskWaitMulti(pevents_pend);                /* Suspend task until events or timeout occurs */
 
     OS_EXIT_CRITICAL();
@@ -580,6 +613,10 @@ void  OSInit (void)
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
 #endif
 
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OS_IntQInit();                                               /* Create the task performing ISR posts     */
+#endif
+
 #if OS_TMR_EN > 0
     OSTmr_Init();                                                /* Initialize the Timer Manager             */
 #endif
@@ -658,14 +695,24 @@ void  OSIntExit (void)
 
     if (OSRunning == OS_TRUE) {
         OS_ENTER_CRITICAL();
+#if OS_TICKLESS_EN > 0
+        if ((OSIntNesting == 1) && (OSPrioCur == OS_TASK_IDLE_PRIO)) {
+            OSTicklessExitHook();                          /* Catch up on ticks skipped while idle     */
+        }
+#endif
         if (OSIntNesting > 0) {                            /* Prevent OSIntNesting from wrapping       */
             OSIntNesting--;
         }
         if (OSIntNesting == 0) {                           /* Reschedule only if all ISRs complete ... */
             if (OSLockNesting == 0) {                      /* ... and not locked.                      */
                 OS_SchedNew();
+#if OS_SCHED_RR_EN > 0
+                OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+                if (OSTCBHighRdy != OSTCBCur) {            /* Tasks sharing a priority differ by TCB   */
+#else
                 if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy */
                     OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                     OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task  */
 #endif
@@ -845,10 +892,77 @@ void  OSStatInit (void)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) When OS_TICK_LIST_EN is enabled, only the tasks at the head of the tick (delta) list are
+*                 examined.  The cost of a tick is thus proportional to the number of tasks expiring on
+*                 this tick rather than to the number of tasks in the system.
+*              2) When OS_SCHED_RR_EN is enabled, the time quantum of the running task is also consumed
+*                 here (see OS_RRTick()).
 *********************************************************************************************************
 */
 
 void  OSTimeTick (void)
+{
+#if OS_TIME_TICK_HOOK_EN > 0
+    OSTimeTickHook();                                      /* Call user definable hook                     */
+#endif
+    OS_TimeTickAdvance(1L);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       PROCESS SEVERAL SYSTEM TICKS
+*
+* Description: This function is called by the port, when OS_TICKLESS_EN is enabled, to account for
+*              'nticks' clock ticks that elapsed while the tick interrupt was suspended.  It has the
+*              effect of 'nticks' calls to OSTimeTick() but advances the tick counters and the head of
+*              the tick list by 'nticks' in one step, so its cost does not grow with the length of the
+*              idle period.
+*
+* Arguments  : nticks    is the number of ticks that elapsed.
+*
+* Returns    : none
+*
+* Note(s)    : 1) The port's OSTimeTickNHook() is called once, with 'nticks', instead of OSTimeTickHook().
+*              2) When OS_SCHED_RR_EN is enabled, the time quantum is only charged one tick: the idle
+*                 task ran during the skipped ticks.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+void  OSTimeTickN (INT32U nticks)
+{
+    if (nticks == 0) {
+        return;
+    }
+#if OS_TIME_TICK_HOOK_EN > 0
+    OSTimeTickNHook(nticks);                               /* Call port's hook for all the ticks           */
+#endif
+    OS_TimeTickAdvance(nticks);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         ADVANCE THE SYSTEM TIME
+*
+* Description: This function advances the tick counters by 'nticks' and readies every task whose delay or
+*              pend timeout expired in that time.  It is the common part of OSTimeTick() and
+*              OSTimeTickN().
+*
+* Arguments  : nticks    is the number of ticks to advance by (at least 1).
+*
+* Returns    : none
+*
+* Note(s)    : 1) With the tick list, the ticks are taken off the deltas at the head of the list until
+*                 they are used up, so only the tasks that expire and the first one that does not are
+*                 visited.
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeTickAdvance (INT32U nticks)
 {
     OS_TCB    *ptcb;
 #if OS_TICK_STEP_EN > 0
@@ -860,13 +974,14 @@ void  OSTimeTick (void)
 
 
 
-#if OS_TIME_TICK_HOOK_EN > 0
-    OSTimeTickHook();                                      /* Call user definable hook                     */
-#endif
+    OS_ENTER_CRITICAL();                                   /* Update the tick counters                     */
+    OSTickCtr += nticks;
 #if OS_TIME_GET_SET_EN > 0
-    OS_ENTER_CRITICAL();                                   /* Update the 32-bit tick counter               */
-    OSTime++;
+    OSTime    += nticks;
+#endif
     OS_EXIT_CRITICAL();
+#if OS_TIME_TS_EN > 0
+    OSTickTs = OSTimeTsGet();                              /* Also catches every wrap of the cycle counter */
 #endif
     if (OSRunning == OS_TRUE) {
 #if OS_TICK_STEP_EN > 0
@@ -893,28 +1008,76 @@ void  OSTimeTick (void)
             return;
         }
 #endif
+#if OS_TICK_LIST_EN > 0
+        OS_ENTER_CRITICAL();
+        ptcb = OSTickList;                                 /* Point at first TCB in tick list              */
+        while (ptcb != (OS_TCB *)0) {                      /* Ready all tasks whose delay expired          */
+            if (ptcb->OSTCBTickDelta > nticks) {           /* Only the head's delta needs to be updated    */
+                ptcb->OSTCBTickDelta -= nticks;
+                break;
+            }
+            nticks               -= ptcb->OSTCBTickDelta;  /* Ticks left once this task has expired        */
+            ptcb->OSTCBTickDelta  = 0;
+            OS_TickListRemove(ptcb);
+                                                           /* Check for timeout                            */
+            if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
+                ptcb->OSTCBStat  &= ~(INT16U)OS_STAT_PEND_ANY;                 /* Yes, Clear status flag   */
+                ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                         /* Indicate PEND timeout    */
+            } else {
+                ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+            }
+
+            if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {          /* Is task suspended?       */
+#if OS_SCHED_RR_EN > 0
+                OS_RRTaskRdy(ptcb);                                            /* No,  Make ready          */
+#elif OS_SCHED_EDF_EN > 0
+                OS_EDFTaskRdy(ptcb);                                           /* No,  Make ready          */
+#else
+                OSRdyGrp               |= ptcb->OSTCBBitY;                     /* No,  Make ready          */
+                OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
+            }
+            OS_EXIT_CRITICAL();                            /* Give interrupts a chance between expiries    */
+            OS_ENTER_CRITICAL();
+            ptcb = OSTickList;
+        }
+        OS_EXIT_CRITICAL();
+#else
         ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
         while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
             OS_ENTER_CRITICAL();
-            if (ptcb->OSTCBDly != 0) {                     /* No, Delayed or waiting for event with TO     */
-                if (--ptcb->OSTCBDly == 0) {               /* Decrement nbr of ticks to end of delay       */
+            if (ptcb->OSTCBDly > nticks) {                 /* Delayed or waiting for event with TO ...     */
+                ptcb->OSTCBDly -= nticks;                  /* ... beyond these ticks                       */
+            } else if (ptcb->OSTCBDly != 0) {              /* End of delay reached                         */
+                ptcb->OSTCBDly = 0;
                                                            /* Check for timeout                            */
-                    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
-                        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag   */
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout    */
-                    } else {
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
-                    }
-
-                    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?       */
-                        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready          */
-                        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
-                    }
+                if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
+                    ptcb->OSTCBStat  &= ~(INT16U)OS_STAT_PEND_ANY;             /* Yes, Clear status flag   */
+                    ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                     /* Indicate PEND timeout    */
+                } else {
+                    ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+                }
+
+                if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {      /* Is task suspended?       */
+#if OS_SCHED_RR_EN > 0
+                    OS_RRTaskRdy(ptcb);                                        /* No,  Make ready          */
+#elif OS_SCHED_EDF_EN > 0
+                    OS_EDFTaskRdy(ptcb);                                       /* No,  Make ready          */
+#else
+                    OSRdyGrp               |= ptcb->OSTCBBitY;                 /* No,  Make ready          */
+                    OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
                 }
             }
             ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
             OS_EXIT_CRITICAL();
         }
+#endif
+#if OS_SCHED_RR_EN > 0
+        OS_ENTER_CRITICAL();
+        OS_RRTick();                                       /* Time slice tasks sharing a priority          */
+        OS_EXIT_CRITICAL();
+#endif
     }
 }
 
@@ -971,7 +1134,7 @@ void  OS_Dummy (void)
 *                          such as MAILBOXEs and QUEUEs.  The pointer is not used when called by other
 *                          service functions.
 *
-*              msk         is a mask that is used to clear the status byte of the TCB.  For example,
+*              msk         is a mask that is used to clear the status bits of the TCB.  For example,
 *                          OSSemPost() will pass OS_STAT_SEM, OSMboxPost() will pass OS_STAT_MBOX etc.
 *
 *              pend_stat   is used to indicate the readied task's pending status:
@@ -986,18 +1149,22 @@ void  OS_Dummy (void)
 *********************************************************************************************************
 */
 #if (OS_EVENT_EN)
-INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
+INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT16U msk, INT8U pend_stat)
 {
     OS_TCB  *ptcb;
     INT8U    y;
     INT8U    x;
     INT8U    prio;
-#if OS_LOWEST_PRIO > 63
+#if (OS_SCHED_FFS_EN == 0) && (OS_LOWEST_PRIO > 63)
     INT16U  *ptbl;
 #endif
 
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    y    = OS_CPU_CNT_TRAIL_ZEROS(pevent->OSEventGrp);  /* Find HPT waiting for message                */
+    x    = OS_CPU_CNT_TRAIL_ZEROS(pevent->OSEventTbl[y]);
+    prio = (INT8U)((y << 5) + x);                       /* Find priority of task getting the msg       */
+#elif OS_LOWEST_PRIO <= 63
     y    = OSUnMapTbl[pevent->OSEventGrp];              /* Find HPT waiting for message                */
     x    = OSUnMapTbl[pevent->OSEventTbl[y]];
     prio = (INT8U)((y << 3) + x);                       /* Find priority of task getting the msg       */
@@ -1016,8 +1183,20 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     prio = (INT8U)((y << 4) + x);                       /* Find priority of task getting the msg       */
 #endif
 
+#if OS_SCHED_RR_EN > 0
+    ptcb                  =  OSTCBPrioTbl[prio];        /* Find first task at 'prio' waiting for event */
+    if (OS_RRTaskPend(ptcb, pevent) == OS_FALSE) {
+        ptcb              =  OS_RREventNext(ptcb, pevent);
+    }
+    OSTCBEventRdy         =  ptcb;
+#else
     ptcb                  =  OSTCBPrioTbl[prio];        /* Point to this task's OS_TCB                 */
+#endif
+#if OS_TICK_LIST_EN > 0
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
+#else
     ptcb->OSTCBDly        =  0;                         /* Prevent OSTimeTick() from readying task     */
+#endif
 #if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
     ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
 #else
@@ -1027,8 +1206,14 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     ptcb->OSTCBStatPend   =  pend_stat;                 /* Set pend status of post or abort            */
                                                         /* See if task is ready (could be susp'd)      */
     if ((ptcb->OSTCBStat &   OS_STAT_SUSPEND) == OS_STAT_RDY) {
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskRdy(ptcb);                             /* Put task in the ready to run list           */
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskRdy(ptcb);                            /* Put task in the ready to run list           */
+#else
         OSRdyGrp         |=  ptcb->OSTCBBitY;           /* Put task in the ready to run list           */
         OSRdyTbl[y]      |=  ptcb->OSTCBBitX;
+#endif
     }
 
     OS_EventTaskRemove(ptcb, pevent);                   /* Remove this task from event   wait list     */
@@ -1036,6 +1221,9 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {   /* Remove this task from events' wait lists    */
         OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
         ptcb->OSTCBEventPtr       = (OS_EVENT  *)pevent;/* Return event as first multi-pend event ready*/
+#if OS_SCHED_RR_EN > 0
+        ptcb->OSTCBStat          &= ~(INT16U)OS_STAT_PEND_ANY; /* No longer waiting for the other events*/
+#endif
     }
 #endif
 
@@ -1060,7 +1248,9 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
 #if (OS_EVENT_EN)
 void  OS_EventTaskWait (OS_EVENT *pevent)
 {
+#if (OS_SCHED_RR_EN == 0) && (OS_SCHED_EDF_EN == 0)
     INT8U  y;
+#endif
 
 
     OSTCBCur->OSTCBEventPtr               = pevent;                 /* Store ptr to ECB in TCB         */
@@ -1068,11 +1258,17 @@ void  OS_EventTaskWait (OS_EVENT *pevent)
     pevent->OSEventTbl[OSTCBCur->OSTCBY] |= OSTCBCur->OSTCBBitX;    /* Put task in waiting list        */
     pevent->OSEventGrp                   |= OSTCBCur->OSTCBBitY;
 
+#if OS_SCHED_RR_EN > 0
+    OS_RRTaskUnRdy(OSTCBCur);                     /* Task no longer ready                              */
+#elif OS_SCHED_EDF_EN > 0
+    OS_EDFTaskUnRdy(OSTCBCur);                    /* Task no longer ready                              */
+#else
     y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
     OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1096,7 +1292,9 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
 {
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
+#if (OS_SCHED_RR_EN == 0) && (OS_SCHED_EDF_EN == 0)
     INT8U      y;
+#endif
 
 
     OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;
@@ -1111,11 +1309,17 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
         pevent = *pevents;
     }
 
+#if OS_SCHED_RR_EN > 0
+    OS_RRTaskUnRdy(OSTCBCur);                     /* Task no longer ready                              */
+#elif OS_SCHED_EDF_EN > 0
+    OS_EDFTaskUnRdy(OSTCBCur);                    /* Task no longer ready                              */
+#else
     y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
     OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1141,6 +1345,11 @@ void  OS_EventTaskRemove (OS_TCB   *ptcb,
     INT8U  y;
 
 
+#if OS_SCHED_RR_EN > 0
+    if (OS_RREventNext(ptcb, pevent) != (OS_TCB *)0) {  /* Another task at this prio is still waiting  */
+        return;
+    }
+#endif
     y                       =  ptcb->OSTCBY;
     pevent->OSEventTbl[y]  &= ~ptcb->OSTCBBitX;         /* Remove task from wait list                  */
     if (pevent->OSEventTbl[y] == 0) {
@@ -1170,26 +1379,37 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 {
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
+#if OS_SCHED_RR_EN == 0
     INT8U      y;
-#if (OS_LOWEST_PRIO <= 63)
+#if OS_SCHED_FFS_EN > 0
+    INT32U     bity;
+    INT32U     bitx;
+#elif (OS_LOWEST_PRIO <= 63)
     INT8U      bity;
     INT8U      bitx;
 #else
     INT16U     bity;
     INT16U     bitx;
 #endif
+#endif
 
 
+#if OS_SCHED_RR_EN == 0
     y       =  ptcb->OSTCBY;
     bity    =  ptcb->OSTCBBitY;
     bitx    =  ptcb->OSTCBBitX;
+#endif
     pevents =  pevents_multi;
     pevent  = *pevents;
     while (pevent != (OS_EVENT *)0) {                   /* Remove task from all events' wait lists     */
+#if OS_SCHED_RR_EN > 0
+        OS_EventTaskRemove(ptcb, pevent);               /* Tasks sharing the prio may still be waiting */
+#else
         pevent->OSEventTbl[y]  &= ~bitx;
         if (pevent->OSEventTbl[y] == 0) {
             pevent->OSEventGrp &= ~bity;
         }
+#endif
         pevents++;
         pevent = *pevents;
     }
@@ -1212,7 +1432,9 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 #if (OS_EVENT_EN)
 void  OS_EventWaitListInit (OS_EVENT *pevent)
 {
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U *ptbl;
+#elif OS_LOWEST_PRIO <= 63
     INT8U  *ptbl;
 #else
     INT16U *ptbl;
@@ -1301,6 +1523,12 @@ static  void  OS_InitMisc (void)
 #if OS_TIME_GET_SET_EN > 0
     OSTime        = 0L;                                    /* Clear the 32-bit system clock            */
 #endif
+    OSTickCtr     = 0L;                                    /* Clear the 64-bit monotonic tick counter  */
+#if OS_TIME_TS_EN > 0
+    OSTimeTsLast  = 0L;                                    /* Cycle timestamps count from the first read */
+    OSTimeTsHi    = 0L;
+    OSTickTs      = 0L;
+#endif
 
     OSIntNesting  = 0;                                     /* Clear the interrupt nesting counter      */
     OSLockNesting = 0;                                     /* Clear the scheduling lock counter        */
@@ -1312,6 +1540,18 @@ static  void  OS_InitMisc (void)
     OSCtxSwCtr    = 0;                                     /* Clear the context switch counter         */
     OSIdleCtr     = 0L;                                    /* Clear the 32-bit idle counter            */
 
+#if OS_TICK_LIST_EN > 0
+    OSTickList    = (OS_TCB *)0;                           /* No task is delayed                       */
+#endif
+
+#if OS_SCHED_RR_EN > 0
+    OSTCBEventRdy = (OS_TCB *)0;
+#endif
+
+#if OS_SCHED_EDF_EN > 0
+    OSEDFHeapCnt  = 0;                                     /* No periodic task is ready                */
+#endif
+
 #if OS_TASK_STAT_EN > 0
     OSIdleCtrRun  = 0L;
     OSIdleCtrMax  = 0L;
@@ -1335,7 +1575,9 @@ static  void  OS_InitMisc (void)
 static  void  OS_InitRdyList (void)
 {
     INT8U    i;
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+    INT32U  *prdytbl;
+#elif OS_LOWEST_PRIO <= 63
     INT8U   *prdytbl;
 #else
     INT16U  *prdytbl;
@@ -1619,8 +1861,13 @@ void  OS_Sched (void)
     if (OSIntNesting == 0) {                           /* Schedule only if all ISRs done and ...       */
         if (OSLockNesting == 0) {                      /* ... scheduler is not locked                  */
             OS_SchedNew();
+#if OS_SCHED_RR_EN > 0
+            OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+            if (OSTCBHighRdy != OSTCBCur) {            /* Tasks sharing a priority differ by TCB       */
+#else
             if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy     */
                 OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                 OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task      */
 #endif
@@ -1631,6 +1878,40 @@ void  OS_Sched (void)
     }
     OS_EXIT_CRITICAL();
 }
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       COUNT TRAILING ZEROS
+*
+* Description: This function returns the position of the least significant bit set in a 32-bit word, i.e.
+*              the highest priority found in a ready list or event wait list word.  It is used when
+*              OS_SCHED_FFS_EN is enabled and the port does not define OS_CPU_CNT_TRAIL_ZEROS() to use
+*              a count trailing zeros instruction.
+*
+* Arguments  : word     is the word to examine.  It MUST NOT be 0.
+*
+* Returns    : the bit position (0..31) of the least significant bit set in 'word'.
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The result is computed in a fixed number of steps without branches or lookup table.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_FFS_EN > 0
+INT8U  OS_CntTrailZeros (INT32U word)
+{
+    INT8U  n;
+
+
+    word &= (INT32U)0 - word;                    /* Keep only the least significant bit set            */
+    n     = (INT8U)(((word & 0xFFFF0000uL) != 0) << 4);
+    n    |= (INT8U)(((word & 0xFF00FF00uL) != 0) << 3);
+    n    |= (INT8U)(((word & 0xF0F0F0F0uL) != 0) << 2);
+    n    |= (INT8U)(((word & 0xCCCCCCCCuL) != 0) << 1);
+    n    |= (INT8U)( (word & 0xAAAAAAAAuL) != 0);
+    return (n);
+}
+#endif
 
 
 /*
@@ -1646,12 +1927,27 @@ void  OS_Sched (void)
 *
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
 *              2) Interrupts are assumed to be disabled when this function is called.
+*              3) When OS_SCHED_EDF_EN is enabled and the highest priority ready task is in the band of
+*                 priorities OS_SCHED_EDF_PRIO_HI..OS_SCHED_EDF_PRIO_LO, the ready task of the band with
+*                 the earliest deadline is selected instead.  The band thus behaves as one priority
+*                 level, and no task outside it is ever passed over.  Tasks of the band that are not
+*                 periodic have no deadline and run after the periodic ones, by priority.  A task
+*                 running at a priority it inherited from a mutex is always selected by priority.
 *********************************************************************************************************
 */
 
 static  void  OS_SchedNew (void)
 {
-#if OS_LOWEST_PRIO <= 63                         /* See if we support up to 64 tasks                   */
+#if OS_SCHED_EDF_EN > 0
+    OS_TCB *ptcb;
+#endif
+#if OS_SCHED_FFS_EN > 0                          /* Two count trailing zeros for up to 256 tasks       */
+    INT8U   y;
+
+
+    y             = OS_CPU_CNT_TRAIL_ZEROS(OSRdyGrp);
+    OSPrioHighRdy = (INT8U)((y << 5) + OS_CPU_CNT_TRAIL_ZEROS(OSRdyTbl[y]));
+#elif OS_LOWEST_PRIO <= 63                       /* See if we support up to 64 tasks                   */
     INT8U   y;
 
 
@@ -1674,6 +1970,12 @@ static  void  OS_SchedNew (void)
         OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8);
     }
 #endif
+#if OS_SCHED_EDF_EN > 0
+    ptcb = OSTCBPrioTbl[OSPrioHighRdy];
+    if ((ptcb->OSTCBEDFIx != OS_EDF_IX_NONE) && (ptcb->OSTCBPrio == ptcb->OSTCBEDFPrio)) {
+        OSPrioHighRdy = OSEDFHeap[0]->OSTCBPrio;           /* Earliest deadline in the EDF band        */
+    }
+#endif
 }
 
 /*$PAGE*/
@@ -1882,6 +2184,652 @@ void  OS_TaskStatStkChk (void)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                   INSERT A TASK IN THE TICK LIST
+*
+* Description: This function is called by other uC/OS-II services to delay a task or to start its pend
+*              timeout.  The tick list is ordered by expiry time and every TCB only stores the number of
+*              ticks between the expiry of its predecessor and its own (a 'delta list'), so that
+*              OSTimeTick() only needs to decrement the delta of the first task in the list.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task to delay.
+*
+*              ticks         is the number of clock ticks to wait.  A value of 0 does not insert the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*              3) OSTCBDly holds the requested number of ticks while the task is in the list and is 0
+*                 otherwise.
+*              4) Tasks expiring on the same tick are readied in the order they were inserted.
+*********************************************************************************************************
+*/
+#if OS_TICK_LIST_EN > 0
+void  OS_TickListInsert (OS_TCB *ptcb, INT32U ticks)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    OS_TickListRemove(ptcb);                               /* Make sure task is not already in the list */
+    if (ticks == 0) {
+        return;
+    }
+    ptcb->OSTCBDly = ticks;
+    pprev          = (OS_TCB *)0;
+    pnext          = OSTickList;
+    while (pnext != (OS_TCB *)0) {                         /* Find insertion point                      */
+        if (pnext->OSTCBTickDelta > ticks) {
+            break;
+        }
+        ticks -= pnext->OSTCBTickDelta;                    /* Make delay relative to this task's expiry */
+        pprev  = pnext;
+        pnext  = pnext->OSTCBTickNext;
+    }
+    ptcb->OSTCBTickDelta = ticks;
+    ptcb->OSTCBTickPrev  = pprev;
+    ptcb->OSTCBTickNext  = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBTickDelta -= ticks;                    /* Successor now expires relative to us      */
+        pnext->OSTCBTickPrev   = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBTickNext   = ptcb;
+    } else {
+        OSTickList             = ptcb;                     /* Task expires first                        */
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE A TASK FROM THE TICK LIST
+*
+* Description: This function is called by other uC/OS-II services to cancel a task's delay or timeout.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task to remove.  Nothing is done if the task
+*                            is not in the tick list.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+#if OS_TICK_LIST_EN > 0
+void  OS_TickListRemove (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    if (ptcb->OSTCBDly == 0) {                             /* Task is not in the tick list              */
+        return;
+    }
+    pprev = ptcb->OSTCBTickPrev;
+    pnext = ptcb->OSTCBTickNext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBTickDelta += ptcb->OSTCBTickDelta;     /* Give our remaining ticks to successor     */
+        pnext->OSTCBTickPrev   = pprev;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBTickNext   = pnext;
+    } else {
+        OSTickList             = pnext;
+    }
+    ptcb->OSTCBTickNext  = (OS_TCB *)0;
+    ptcb->OSTCBTickPrev  = (OS_TCB *)0;
+    ptcb->OSTCBTickDelta = 0;
+    ptcb->OSTCBDly       = 0;
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               ADD A TASK TO THE TASKS SHARING ITS PRIORITY
+*
+* Description: This function is called by other uC/OS-II services to link a task into the ring of tasks
+*              at its priority.  The task is alone at the priority if the OSTCBPrioTbl[] entry is free or
+*              reserved, otherwise it is added at the end of the ring, i.e. it gets the CPU after all the
+*              tasks already there.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.  OSTCBPrio MUST already be set.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*              3) OSTCBPrioTbl[] points at the head of the ring, the task that runs when the priority is
+*                 the highest one ready.  The head is kept ready whenever any task in the ring is ready.
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+void  OS_RRLink (OS_TCB *ptcb)
+{
+    OS_TCB  *phead;
+
+
+    phead = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if ((phead == (OS_TCB *)0) || (phead == OS_TCB_RESERVED) || (phead == ptcb)) {
+        ptcb->OSTCBRRNext = ptcb;                          /* Task is alone at its priority             */
+        ptcb->OSTCBRRPrev = ptcb;
+        OS_RRHeadSet(ptcb);
+        return;
+    }
+    ptcb->OSTCBRRNext               = phead;               /* Insert at the end of the ring             */
+    ptcb->OSTCBRRPrev               = phead->OSTCBRRPrev;
+    phead->OSTCBRRPrev->OSTCBRRNext = ptcb;
+    phead->OSTCBRRPrev              = ptcb;
+    if ((phead->OSTCBRRRdy == OS_FALSE) || (ptcb == OSTCBCur)) {
+        OS_RRHeadSet(ptcb);                                /* Keep running (mutex owner back at prio)   */
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                             REMOVE A TASK FROM THE TASKS SHARING ITS PRIORITY
+*
+* Description: This function is called by other uC/OS-II services when a task leaves its priority (it is
+*              deleted or its priority is changed).  If other tasks remain at the priority, the head of
+*              the ring and the priority's ready bit are updated for them.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : OS_TRUE       if other tasks remain at the priority.  The caller MUST NOT free the
+*                            OSTCBPrioTbl[] entry nor change the priority's ready bit.
+*              OS_FALSE      if the task was alone at its priority.  Nothing was changed.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+BOOLEAN  OS_RRUnlink (OS_TCB *ptcb)
+{
+    OS_TCB  *pnext;
+    OS_TCB  *prdy;
+    OS_TCB  *phead;
+    INT8U    y;
+
+
+    pnext = ptcb->OSTCBRRNext;
+    if (pnext == ptcb) {                                   /* Task is alone at its priority             */
+        return (OS_FALSE);
+    }
+    prdy                            = OS_RRNextRdy(ptcb);
+    pnext->OSTCBRRPrev              = ptcb->OSTCBRRPrev;   /* Unlink from ring                          */
+    ptcb->OSTCBRRPrev->OSTCBRRNext  = pnext;
+    ptcb->OSTCBRRNext               = ptcb;
+    ptcb->OSTCBRRPrev               = ptcb;
+    phead                           = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if (prdy == (OS_TCB *)0) {                             /* No other task ready at this priority      */
+        if (phead == ptcb) {
+            OS_RRHeadSet(pnext);
+        }
+        y             =  ptcb->OSTCBY;
+        OSRdyTbl[y]  &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~ptcb->OSTCBBitY;
+        }
+    } else if ((phead == ptcb) || (phead->OSTCBRRRdy == OS_FALSE)) {
+        OS_RRHeadSet(prdy);
+    }
+    return (OS_TRUE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 SEE IF A TASK MAY JOIN AN OCCUPIED PRIORITY
+*
+* Description: This function is called by OSTaskCreate() and OSTaskCreateExt() when a task already exists
+*              at the requested priority.
+*
+* Arguments  : prio          is the priority of the task being created.
+*
+* Returns    : OS_TRUE       if the new task can share the priority with the task(s) already there.
+*              OS_FALSE      if the priority belongs to a task of uC/OS-II (idle, statistic, timer, timer
+*                            dispatch or ISR post task), is reserved or used as the priority inheritance
+*                            priority (PIP) of a mutex, or is held by a mutex owner running at its PIP.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+BOOLEAN  OS_RRPrioShare (INT8U prio)
+{
+    OS_TCB    *phead;
+#if (OS_MUTEX_EN > 0) && (OS_MAX_EVENTS > 0)
+    OS_EVENT  *pevent;
+    INT16U     i;
+#endif
+
+
+    if (prio == OS_TASK_IDLE_PRIO) {                       /* Tasks of uC/OS-II must stay alone         */
+        return (OS_FALSE);
+    }
+#if OS_TASK_STAT_EN > 0
+    if (prio == OS_TASK_STAT_PRIO) {
+        return (OS_FALSE);
+    }
+#endif
+#if OS_TMR_EN > 0
+    if (prio == OS_TASK_TMR_PRIO) {
+        return (OS_FALSE);
+    }
+#if OS_TMR_DISP_EN > 0
+    if (prio == OS_TMR_DISP_PRIO_1) {
+        return (OS_FALSE);
+    }
+#if OS_TMR_DISP_LEVELS > 1
+    if (prio == OS_TMR_DISP_PRIO_2) {
+        return (OS_FALSE);
+    }
+#endif
+#if OS_TMR_DISP_LEVELS > 2
+    if (prio == OS_TMR_DISP_PRIO_3) {
+        return (OS_FALSE);
+    }
+#endif
+#if OS_TMR_DISP_LEVELS > 3
+    if (prio == OS_TMR_DISP_PRIO_4) {
+        return (OS_FALSE);
+    }
+#endif
+#endif
+#endif
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (prio == OS_TASK_INT_Q_PRIO) {
+        return (OS_FALSE);
+    }
+#endif
+    phead = OSTCBPrioTbl[prio];
+    if ((phead == (OS_TCB *)0) || (phead == OS_TCB_RESERVED)) {
+        return (OS_FALSE);
+    }
+    if (phead->OSTCBPrio != prio) {                        /* Mutex owner raised to its PIP             */
+        return (OS_FALSE);
+    }
+#if (OS_MUTEX_EN > 0) && (OS_MAX_EVENTS > 0)
+    pevent = &OSEventTbl[0];
+    for (i = 0; i < OS_MAX_EVENTS; i++) {                  /* A mutex owner may be raised to 'prio'     */
+        if (pevent->OSEventType == OS_EVENT_TYPE_MUTEX) {
+            if ((INT8U)(pevent->OSEventCnt >> 8) == prio) {
+                return (OS_FALSE);
+            }
+        }
+        pevent++;
+    }
+#endif
+    return (OS_TRUE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     MAKE A TASK READY (ROUND-ROBIN)
+*
+* Description: This function is called by other uC/OS-II services to place a task in the ready list when
+*              OS_SCHED_RR_EN is enabled.  The task becomes the head of its priority's ring if no other
+*              task there is ready, otherwise it waits for its turn.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+void  OS_RRTaskRdy (OS_TCB *ptcb)
+{
+    ptcb->OSTCBRRRdy        = OS_TRUE;
+    OSRdyGrp               |= ptcb->OSTCBBitY;
+    OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    if (OSTCBPrioTbl[ptcb->OSTCBPrio]->OSTCBRRRdy == OS_FALSE) {
+        OS_RRHeadSet(ptcb);                                /* First ready task at this priority         */
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  MAKE A TASK NOT READY (ROUND-ROBIN)
+*
+* Description: This function is called by other uC/OS-II services to remove a task from the ready list
+*              when OS_SCHED_RR_EN is enabled.  The priority stays ready if another task sharing it is
+*              ready, in which case that task becomes the head of the ring.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+void  OS_RRTaskUnRdy (OS_TCB *ptcb)
+{
+    OS_TCB  *prdy;
+    OS_TCB  *phead;
+    INT8U    y;
+
+
+    ptcb->OSTCBRRRdy = OS_FALSE;
+    prdy             = OS_RRNextRdy(ptcb);
+    if (prdy == (OS_TCB *)0) {                             /* No other task ready at this priority      */
+        y             =  ptcb->OSTCBY;
+        OSRdyTbl[y]  &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~ptcb->OSTCBBitY;
+        }
+        return;
+    }
+    phead = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if ((phead == ptcb) || (phead->OSTCBRRRdy == OS_FALSE)) {
+        OS_RRHeadSet(prdy);                                /* Next ready task at this priority runs     */
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ROUND-ROBIN TIME SLICING
+*
+* Description: This function is called by OSTimeTick() to charge one tick to the running task's time
+*              quantum.  When the quantum expires and another task sharing the priority is ready, that
+*              task becomes the head of the ring; OSIntExit() then switches to it.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*              3) The quantum is not consumed while the scheduler is locked.
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+void  OS_RRTick (void)
+{
+    OS_TCB  *ptcb;
+    OS_TCB  *prdy;
+
+
+    ptcb = OSTCBCur;
+    if (ptcb->OSTCBRRNext == ptcb) {                       /* Task has its priority to itself           */
+        return;
+    }
+    if (OSLockNesting > 0) {                               /* Task may not be switched out              */
+        return;
+    }
+    if (ptcb->OSTCBRRCtr > 1) {
+        ptcb->OSTCBRRCtr--;
+        return;
+    }
+    ptcb->OSTCBRRCtr = OS_SCHED_RR_QUANTUM;                /* Quantum expired, start a new one          */
+    prdy             = OS_RRNextRdy(ptcb);
+    if ((prdy != (OS_TCB *)0) && (OSTCBPrioTbl[ptcb->OSTCBPrio] == ptcb)) {
+        OS_RRHeadSet(prdy);                                /* Give the CPU to the next ready task       */
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ROUND-ROBIN INTERNAL FUNCTIONS
+*
+* Description: OS_RRHeadSet()   makes a task the head of its priority's ring with a full time quantum.
+*              OS_RRNextRdy()   returns the next ready task sharing 'ptcb's priority, or NULL.
+*              OS_RRTaskPend()  determines whether a task is waiting for 'pevent', or timed out waiting
+*                               for it and has not run since.
+*              OS_RREventNext() returns the next task sharing 'ptcb's priority that is waiting for
+*                               'pevent', or NULL.  It is used to keep a priority's bit set in an event
+*                               wait list while any task at that priority is still waiting.
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-II and your application should not call them.
+*              2) Interrupts MUST be disabled when calling these functions.
+*              3) 'ptcb' itself is never returned by OS_RRNextRdy() and OS_RREventNext().
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+static  void  OS_RRHeadSet (OS_TCB *ptcb)
+{
+    OSTCBPrioTbl[ptcb->OSTCBPrio] = ptcb;
+    ptcb->OSTCBRRCtr              = OS_SCHED_RR_QUANTUM;
+}
+
+
+static  OS_TCB  *OS_RRNextRdy (OS_TCB *ptcb)
+{
+    OS_TCB  *pnext;
+
+
+    pnext = ptcb->OSTCBRRNext;
+    while (pnext != ptcb) {
+        if (pnext->OSTCBRRRdy == OS_TRUE) {
+            return (pnext);
+        }
+        pnext = pnext->OSTCBRRNext;
+    }
+    return ((OS_TCB *)0);
+}
+
+
+#if (OS_EVENT_EN)
+static  BOOLEAN  OS_RRTaskPend (OS_TCB *ptcb, OS_EVENT *pevent)
+{
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT  **pevents;
+#endif
+
+
+    if (((ptcb->OSTCBStat & OS_STAT_PEND_ANY) == OS_STAT_RDY) &&
+         (ptcb->OSTCBStatPend != OS_STAT_PEND_TO)) {       /* A task that timed out stays in the wait   */
+        return (OS_FALSE);                                 /* ... list until it runs, and may still be  */
+    }                                                      /* ... given the event as with one task/prio */
+    if (ptcb->OSTCBEventPtr == pevent) {
+        return (OS_TRUE);
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    if ((ptcb->OSTCBEventPtr      == (OS_EVENT  *)0) &&
+        (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0)) {    /* Still waiting for multiple events         */
+        pevents = ptcb->OSTCBEventMultiPtr;
+        while (*pevents != (OS_EVENT *)0) {
+            if (*pevents == pevent) {
+                return (OS_TRUE);
+            }
+            pevents++;
+        }
+    }
+#endif
+    return (OS_FALSE);
+}
+
+
+static  OS_TCB  *OS_RREventNext (OS_TCB *ptcb, OS_EVENT *pevent)
+{
+    OS_TCB  *pnext;
+
+
+    pnext = ptcb->OSTCBRRNext;
+    while (pnext != ptcb) {
+        if (OS_RRTaskPend(pnext, pevent) == OS_TRUE) {
+            return (pnext);
+        }
+        pnext = pnext->OSTCBRRNext;
+    }
+    return ((OS_TCB *)0);
+}
+#endif
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    MAKE A TASK READY (DEADLINE ORDER)
+*
+* Description: This function is called by other uC/OS-II services to make a task ready to run when
+*              OS_SCHED_EDF_EN is enabled.  A task whose priority is in the EDF band (OS_SCHED_EDF_PRIO_HI
+*              to OS_SCHED_EDF_PRIO_LO) is also placed in the deadline heap, ordered by the absolute
+*              deadline of its current job if it is periodic (see OSTaskPeriodSet()).
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+#if OS_SCHED_EDF_EN > 0
+void  OS_EDFTaskRdy (OS_TCB *ptcb)
+{
+    INT8U  ix;
+
+
+    OSRdyGrp               |= ptcb->OSTCBBitY;
+    OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    if ((OS_EDF_PRIO_IN_BAND(ptcb->OSTCBEDFPrio) == 0) || (ptcb->OSTCBEDFIx != OS_EDF_IX_NONE)) {
+        return;                                            /* Not in the EDF band, or already in heap   */
+    }
+    ix                 = OSEDFHeapCnt++;
+    OSEDFHeap[ix]      = ptcb;
+    ptcb->OSTCBEDFIx   = ix;
+    OS_EDFHeapUp(ix);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  MAKE A TASK NOT READY (DEADLINE ORDER)
+*
+* Description: This function is called by other uC/OS-II services to remove a task from the ready list
+*              (and from the deadline heap) when OS_SCHED_EDF_EN is enabled.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts MUST be disabled when calling this function.
+*********************************************************************************************************
+*/
+#if OS_SCHED_EDF_EN > 0
+void  OS_EDFTaskUnRdy (OS_TCB *ptcb)
+{
+    OS_TCB  *plast;
+    INT8U    ix;
+    INT8U    y;
+
+
+    y             =  ptcb->OSTCBY;
+    OSRdyTbl[y]  &= ~ptcb->OSTCBBitX;
+    if (OSRdyTbl[y] == 0) {
+        OSRdyGrp &= ~ptcb->OSTCBBitY;
+    }
+    ix = ptcb->OSTCBEDFIx;
+    if (ix == OS_EDF_IX_NONE) {
+        return;
+    }
+    ptcb->OSTCBEDFIx = OS_EDF_IX_NONE;
+    OSEDFHeapCnt--;
+    if (ix == OSEDFHeapCnt) {                              /* Task was the last entry                   */
+        return;
+    }
+    plast             = OSEDFHeap[OSEDFHeapCnt];           /* Move the last entry into the hole         */
+    OSEDFHeap[ix]     = plast;
+    plast->OSTCBEDFIx = ix;
+    OS_EDFHeapUp(ix);
+    OS_EDFHeapDown(plast->OSTCBEDFIx);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DEADLINE HEAP INTERNAL FUNCTIONS
+*
+* Description: OS_EDFEarlier()  determines whether 'pa's deadline comes before 'pb's.  Deadlines are
+*                               ticks of the 64-bit counter of OSTimeGet64(), which does not wrap.  A
+*                               task that is not periodic has no deadline and comes after all periodic
+*                               tasks.  Equal deadlines are ordered by priority.
+*              OS_EDFHeapUp()   moves the entry at 'ix' towards the root until its parent is earlier.
+*              OS_EDFHeapDown() moves the entry at 'ix' towards the leaves until its children are later.
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-II and your application should not call them.
+*              2) Interrupts MUST be disabled when calling these functions.
+*********************************************************************************************************
+*/
+#if OS_SCHED_EDF_EN > 0
+static  BOOLEAN  OS_EDFEarlier (OS_TCB *pa, OS_TCB *pb)
+{
+    if ((pa->OSTCBPeriod == 0) || (pb->OSTCBPeriod == 0)) {
+        if (pa->OSTCBPeriod != pb->OSTCBPeriod) {          /* Only one has a deadline, it comes first   */
+            return ((pa->OSTCBPeriod != 0) ? OS_TRUE : OS_FALSE);
+        }
+    } else if (pa->OSTCBDeadline != pb->OSTCBDeadline) {
+        return ((pa->OSTCBDeadline < pb->OSTCBDeadline) ? OS_TRUE : OS_FALSE);
+    }
+    return ((pa->OSTCBPrio < pb->OSTCBPrio) ? OS_TRUE : OS_FALSE);
+}
+
+
+static  void  OS_EDFHeapUp (INT8U ix)
+{
+    OS_TCB  *ptcb;
+    OS_TCB  *pparent;
+    INT8U    parent;
+
+
+    ptcb = OSEDFHeap[ix];
+    while (ix > 0) {
+        parent  = (INT8U)((ix - 1) >> 1);
+        pparent = OSEDFHeap[parent];
+        if (OS_EDFEarlier(ptcb, pparent) == OS_FALSE) {
+            break;
+        }
+        OSEDFHeap[ix]       = pparent;                     /* Parent moves down into the hole           */
+        pparent->OSTCBEDFIx = ix;
+        ix                  = parent;
+    }
+    OSEDFHeap[ix]    = ptcb;
+    ptcb->OSTCBEDFIx = ix;
+}
+
+
+static  void  OS_EDFHeapDown (INT8U ix)
+{
+    OS_TCB  *ptcb;
+    OS_TCB  *pchild;
+    INT8U    child;
+
+
+    ptcb = OSEDFHeap[ix];
+    while ((child = (INT8U)((ix << 1) + 1)) < OSEDFHeapCnt) {
+        pchild = OSEDFHeap[child];
+        if ((child + 1) < OSEDFHeapCnt) {                  /* Pick the earlier of both children         */
+            if (OS_EDFEarlier(OSEDFHeap[child + 1], pchild) == OS_TRUE) {
+                child++;
+                pchild = OSEDFHeap[child];
+            }
+        }
+        if (OS_EDFEarlier(pchild, ptcb) == OS_FALSE) {
+            break;
+        }
+        OSEDFHeap[ix]      = pchild;                       /* Child moves up into the hole              */
+        pchild->OSTCBEDFIx = ix;
+        ix                 = child;
+    }
+    OSEDFHeap[ix]    = ptcb;
+    ptcb->OSTCBEDFIx = ix;
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            INITIALIZE TCB
 *
 * Description: This function is internal to uC/OS-II and is used to initialize a Task Control Block when
@@ -1942,6 +2890,33 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBStat          = OS_STAT_RDY;            /* Task is ready to run                     */
         ptcb->OSTCBStatPend      = OS_STAT_PEND_OK;        /* Clear pend status                        */
         ptcb->OSTCBDly           = 0;                      /* Task is not delayed                      */
+#if OS_TICK_LIST_EN > 0
+        ptcb->OSTCBTickNext      = (OS_TCB *)0;            /* Task is not in the tick list             */
+        ptcb->OSTCBTickPrev      = (OS_TCB *)0;
+        ptcb->OSTCBTickDelta     = 0;
+#endif
+#if OS_SCHED_RR_EN > 0
+        ptcb->OSTCBRRCtr         = OS_SCHED_RR_QUANTUM;    /* Full time quantum                        */
+        ptcb->OSTCBRRRdy         = OS_FALSE;               /* Not in ready list until linked below     */
+#endif
+#if (OS_SCHED_EDF_EN > 0) || (OS_TASK_PERIODIC_EN > 0)
+        ptcb->OSTCBRelTime       = 0L;
+        ptcb->OSTCBDeadline      = 0L;
+        ptcb->OSTCBPeriod        = 0;                      /* Not periodic, scheduled by priority      */
+        ptcb->OSTCBDlMiss        = 0L;
+#endif
+#if OS_SCHED_EDF_EN > 0
+        ptcb->OSTCBEDFIx         = OS_EDF_IX_NONE;
+        ptcb->OSTCBEDFPrio       = prio;
+#endif
+#if OS_TASK_PERIODIC_EN > 0
+        ptcb->OSTCBRelTs         = 0L;
+        ptcb->OSTCBRelCtr        = 0L;
+        ptcb->OSTCBJitterLast    = 0L;
+        ptcb->OSTCBJitterMax     = 0L;
+        ptcb->OSTCBRespLast      = 0L;
+        ptcb->OSTCBRespMax       = 0L;
+#endif
 
 #if OS_TASK_CREATE_EXT_EN > 0
         ptcb->OSTCBExtPtr        = pext;                   /* Store pointer to TCB extension           */
@@ -1961,7 +2936,12 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_FFS_EN > 0
+        ptcb->OSTCBY             = (INT8U)(prio >> 5);          /* Pre-compute X, Y, BitX and BitY     */
+        ptcb->OSTCBX             = (INT8U)(prio & 0x1F);
+        ptcb->OSTCBBitY          = (INT32U)1 << ptcb->OSTCBY;
+        ptcb->OSTCBBitX          = (INT32U)1 << ptcb->OSTCBX;
+#elif OS_LOWEST_PRIO <= 63
         ptcb->OSTCBY             = (INT8U)(prio >> 3);          /* Pre-compute X, Y, BitX and BitY     */
         ptcb->OSTCBX             = (INT8U)(prio & 0x07);
         ptcb->OSTCBBitY          = (INT8U)(1 << ptcb->OSTCBY);
@@ -1989,11 +2969,15 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
 #endif
 
 #if OS_TASK_PROFILE_EN > 0
-        ptcb->OSTCBCtxSwCtr    = 0L;                       /* Initialize profiling variables           */
-        ptcb->OSTCBCyclesStart = 0L;
-        ptcb->OSTCBCyclesTot   = 0L;
-        ptcb->OSTCBStkBase     = (OS_STK *)0;
-        ptcb->OSTCBStkUsed     = 0L;
+        ptcb->OSTCBCtxSwCtr     = 0L;                      /* Initialize profiling variables           */
+        ptcb->OSTCBCyclesStart  = 0L;
+        ptcb->OSTCBCyclesTot    = 0L;
+        ptcb->OSTCBCyclesBurst  = 0L;
+        ptcb->OSTCBCyclesMax    = 0L;
+        ptcb->OSTCBCyclesPeriod = 0L;
+        ptcb->OSTCBCyclesLast   = 0L;
+        ptcb->OSTCBStkBase      = (OS_STK *)0;
+        ptcb->OSTCBStkUsed      = 0L;
 #endif
 
 #if OS_TASK_NAME_SIZE > 1
@@ -2006,15 +2990,25 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OSTaskCreateHook(ptcb);                            /* Call user defined hook                   */
 
         OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+        OS_RRLink(ptcb);                                   /* Join tasks already at this prio (if any) */
+#else
         OSTCBPrioTbl[prio] = ptcb;
+#endif
         ptcb->OSTCBNext    = OSTCBList;                    /* Link into TCB chain                      */
         ptcb->OSTCBPrev    = (OS_TCB *)0;
         if (OSTCBList != (OS_TCB *)0) {
             OSTCBList->OSTCBPrev = ptcb;
         }
         OSTCBList               = ptcb;
+#if OS_SCHED_RR_EN > 0
+        OS_RRTaskRdy(ptcb);                                /* Make task ready to run                   */
+#elif OS_SCHED_EDF_EN > 0
+        OS_EDFTaskRdy(ptcb);                               /* Make task ready to run                   */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Make task ready to run                   */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         OSTaskCtr++;                                       /* Increment the #tasks counter             */
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
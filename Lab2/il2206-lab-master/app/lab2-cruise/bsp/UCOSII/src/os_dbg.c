@@ -87,7 +87,7 @@ INT16U  const  OSQSize             = sizeof(OS_Q);              /* Size in bytes
 INT16U  const  OSQSize             = 0;
 #endif
 
-INT16U  const  OSRdyTblSize        = OS_RDY_TBL_SIZE;           /* Number of bytes in the ready table  */
+INT16U  const  OSRdyTblSize        = sizeof(OSRdyTbl);          /* Number of bytes in the ready table  */
 
 INT16U  const  OSSemEn             = OS_SEM_EN;
 
@@ -169,6 +169,12 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
 #endif
 #if OS_TIME_GET_SET_EN > 0   
                           + sizeof(OSTime)
+#endif
+                          + sizeof(OSTickCtr)
+#if OS_TIME_TS_EN > 0
+                          + sizeof(OSTimeTsLast)
+                          + sizeof(OSTimeTsHi)
+                          + sizeof(OSTickTs)
 #endif
 #if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
                           + sizeof(OSTmrFree)
@@ -180,6 +186,13 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
                           + sizeof(OSTmrFreeList)
                           + sizeof(OSTmrTaskStk)
                           + sizeof(OSTmrWheelTbl)
+#if OS_TMR_STATS_EN > 0
+                          + sizeof(OSTmrSignalTs)
+#endif
+#if OS_TMR_DISP_EN > 0
+                          + sizeof(OSTmrDispTbl)
+                          + sizeof(OSTmrDispTaskStk)
+#endif
 #endif
                           + sizeof(OSIntNesting)
                           + sizeof(OSLockNesting)
@@ -54,20 +54,19 @@ extern "C"
 
 /*
  * "alt_alarm_s" is a structure type used to maintain lists of alarm callback
- * functions.
+ * functions. The list is ordered by "time"; being 64 bits wide, the tick
+ * count never rolls over during the lifetime of an alarm.
  */
 
 struct alt_alarm_s
 {
   alt_llist llist;       /* linked list */
-  alt_u32 time;          /* time in system ticks of the callback */
+  alt_u64 time;          /* time in system ticks of the callback */
   alt_u32 (*callback) (void* context); /* callback function. The return 
                           * value is the period for the next callback; where 
                           * zero indicates that the alarm should be removed 
                           * from the list. 
                           */
-  alt_u8 rollover;       /* set when desired alarm time + current time causes
-                            overflow, to prevent premature alarm */
   void* context;         /* Argument for the callback */
 };
 
@@ -84,16 +83,24 @@ extern alt_u32 _alt_tick_rate;
 
 /*
  * "_alt_nticks" is a global variable which records the elapsed number of 
- * system clock ticks since the last call to settimeofday() or since reset if
- * settimeofday() has not been called.
+ * system clock ticks since reset. It is 64 bits wide, so it never rolls over.
+ * It only exists if the operating system does not count the ticks itself 
+ * (ALT_OS_NTICKS); use alt_nticks64() to read it.
  */
 
-extern volatile alt_u32 _alt_nticks;
+extern volatile alt_u64 _alt_nticks;
 
-/* The list of registered alarms. */
+/* The list of registered alarms, ordered by expiry time. */
 
 extern alt_llist alt_alarm_list;
 
+/*
+ * alt_alarm_insert() links an alarm into alt_alarm_list after all alarms due
+ * at the same time or earlier. It must be called with interrupts disabled.
+ */
+
+extern void alt_alarm_insert (struct alt_alarm_s* alarm);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,12 +20,44 @@
 
 #include "system.h"
 
+#include "sys/alt_irq_stats.h"
+
+#if (OS_TASK_PROFILE_EN > 0) || (OS_IRQ_STATS_EN > 0) || (OS_TMR_STATS_EN > 0) || (OS_TIME_TS_EN > 0)
+#include "sys/alt_timestamp.h"
+#include "altera_avalon_timer_regs.h"
+#endif
+
 extern void OSStartTsk;                 /* The entry point for all tasks. */
 
 #if OS_TMR_EN > 0
 static  INT16U  OSTmrCtr;
 #endif
 
+/*
+ * Per-task execution time is measured with the HAL timestamp timer, so it
+ * is only available when one is selected (hal.timestamp_timer).
+ */
+#if (OS_TASK_PROFILE_EN > 0) && (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+#define OS_CPU_PROFILE_EN  1
+static  INT16U  OSProfileCtr;           /* Ticks into the current accounting period */
+static  INT32U  OSProfileStart;         /* Timestamp at the start of the period     */
+
+static  void    OSProfilePeriodEnd(void);
+#else
+#define OS_CPU_PROFILE_EN  0
+#endif
+
+/*
+ * The timer callback statistics (OS_TMR_STATS_EN) and the kernel timestamps
+ * (OS_TIME_TS_EN) read the same timer, through OSCPUCyclesGet().
+ */
+#if ((OS_TIME_TS_EN > 0) || ((OS_TMR_EN > 0) && (OS_TMR_STATS_EN > 0))) && \
+    (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+#define OS_CPU_CYCLES_EN  1
+#else
+#define OS_CPU_CYCLES_EN  0
+#endif
+
 /***********************************************************************************************
  *                                        INITIALIZE A TASK'S STACK
  *
@@ -151,10 +183,30 @@ void OSTaskDelHook (OS_TCB *ptcb)
 *              2) It is assumed that the global pointer 'OSTCBHighRdy' points to the TCB of the task that
 *                 will be 'switched in' (i.e. the highest priority task) and, 'OSTCBCur' points to the
 *                 task being switched out (i.e. the preempted task).
+*              3) When task profiling is available, the time the task being switched out ran since it
+*                 was switched in is added to its execution time (see OSTaskCyclesGet()).
 *********************************************************************************************************
 */
 void OSTaskSwHook (void)
 {
+#if OS_CPU_PROFILE_EN > 0
+    INT32U  now;
+    INT32U  cycles;
+
+
+    now = (INT32U)alt_timestamp();
+    if (OSRunning == OS_TRUE) {                   /* Nothing was running before OSStartHighRdy()       */
+        cycles                       = now - OSTCBCur->OSTCBCyclesStart;
+        OSTCBCur->OSTCBCyclesTot    += cycles;
+        OSTCBCur->OSTCBCyclesPeriod += cycles;
+        cycles                      += OSTCBCur->OSTCBCyclesBurst;
+        if (cycles > OSTCBCur->OSTCBCyclesMax) {
+            OSTCBCur->OSTCBCyclesMax = cycles;    /* Longest burst so far                              */
+        }
+        OSTCBCur->OSTCBCyclesBurst   = 0L;
+    }
+    OSTCBHighRdy->OSTCBCyclesStart = now;
+#endif
 }
 
 /*
@@ -200,6 +252,16 @@ void OSTimeTickHook (void)
         OSTmrSignal();
     }
 #endif  
+
+#if OS_CPU_PROFILE_EN > 0
+    if (OSRunning == OS_TRUE) {
+        OSProfileCtr++;
+        if (OSProfileCtr >= OS_TASK_PROFILE_PERIOD) {
+            OSProfileCtr = 0;
+            OSProfilePeriodEnd();
+        }
+    }
+#endif
     
 #ifdef ALT_INICHE
     /* Service the Interniche timer */
@@ -207,6 +269,55 @@ void OSTimeTickHook (void)
 #endif
 }
 
+/*
+*********************************************************************************************************
+*                                           SEVERAL TICKS HOOK
+*
+* Description: This function is called by OSTimeTickN(), instead of OSTimeTickHook(), for the ticks that
+*              elapsed while the system clock was suspended.  The tick counters are advanced by 'nticks'
+*              at once.  The timer task is signalled once if a timer tick is due, since it catches up on
+*              all of them (see OSTmr_Task()), and an accounting period that ended is closed once.
+*
+* Arguments  : nticks   is the number of ticks that elapsed.
+*
+* Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+void OSTimeTickNHook (INT32U nticks)
+{
+#if (OS_TMR_EN > 0) || (OS_CPU_PROFILE_EN > 0)
+    INT32U  ctr;
+#endif
+
+
+#if OS_TMR_EN > 0
+    ctr      = OSTmrCtr + nticks;
+    OSTmrCtr = (INT16U)(ctr % OS_TMR_TICK_DIV);
+    if (ctr >= OS_TMR_TICK_DIV) {
+        OSTmrSignal();
+    }
+#endif
+
+#if OS_CPU_PROFILE_EN > 0
+    if (OSRunning == OS_TRUE) {
+        ctr          = OSProfileCtr + nticks;
+        OSProfileCtr = (INT16U)(ctr % OS_TASK_PROFILE_PERIOD);
+        if (ctr >= OS_TASK_PROFILE_PERIOD) {
+            OSProfilePeriodEnd();
+        }
+    }
+#endif
+
+#ifdef ALT_INICHE
+    /* The Interniche timer counts every tick */
+    while (nticks-- > 0) {
+        cticks_hook();
+    }
+#endif
+}
+#endif
+
 void OSInitHookBegin(void)
 {
 #if OS_TMR_EN > 0
@@ -216,14 +327,184 @@ void OSInitHookBegin(void)
 
 void OSInitHookEnd(void)
 {
+#if (OS_CPU_PROFILE_EN > 0) || (ALT_IRQ_STATS_EN > 0) || (OS_CPU_CYCLES_EN > 0)
+    /*
+     * Run the timestamp timer over its full range, continuously, so that
+     * cycle counts keep wrapping around instead of stopping after 2^32
+     * cycles. The registers are written directly because the timestamp
+     * driver is only initialised by alt_sys_init(), after OSInit(). The
+     * application must not call alt_timestamp_start() while tasks are
+     * being profiled.
+     */
+    IOWR_ALTERA_AVALON_TIMER_CONTROL (ALT_TIMESTAMP_CLK_BASE,
+                                      ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+    IOWR_ALTERA_AVALON_TIMER_PERIODL (ALT_TIMESTAMP_CLK_BASE, 0xFFFF);
+    IOWR_ALTERA_AVALON_TIMER_PERIODH (ALT_TIMESTAMP_CLK_BASE, 0xFFFF);
+    IOWR_ALTERA_AVALON_TIMER_CONTROL (ALT_TIMESTAMP_CLK_BASE,
+                                      ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+                                      ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+#endif
+#if OS_CPU_PROFILE_EN > 0
+    OSProfileCtr   = 0;
+    OSProfileStart = (INT32U)alt_timestamp();
+    OSCyclesPeriod = 0L;
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                     END OF A CPU ACCOUNTING PERIOD
+*
+* Description: This function is called by OSTimeTickHook() every OS_TASK_PROFILE_PERIOD ticks.  The task
+*              that was interrupted is charged up to now, then every task's cycles for the period are
+*              saved in .OSTCBCyclesLast and a new period is started.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if OS_CPU_PROFILE_EN > 0
+static void OSProfilePeriodEnd (void)
+{
+    OS_TCB    *ptcb;
+    INT32U     now;
+    INT32U     cycles;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    now                          = (INT32U)alt_timestamp();
+    cycles                       = now - OSTCBCur->OSTCBCyclesStart;
+    OSTCBCur->OSTCBCyclesTot    += cycles;
+    OSTCBCur->OSTCBCyclesPeriod += cycles;
+    OSTCBCur->OSTCBCyclesBurst  += cycles;        /* Burst goes on, only its start moves               */
+    OSTCBCur->OSTCBCyclesStart   = now;
+    ptcb = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {
+        ptcb->OSTCBCyclesLast   = ptcb->OSTCBCyclesPeriod;
+        ptcb->OSTCBCyclesPeriod = 0L;
+        ptcb                    = ptcb->OSTCBNext;
+    }
+    OSCyclesPeriod = now - OSProfileStart;
+    OSProfileStart = now;
+    OS_EXIT_CRITICAL();
 }
+#endif
 
+/*
+*********************************************************************************************************
+*                                               IDLE HOOK
+*
+* Description: This function is called by the idle task.  When OS_TICKLESS_EN is enabled it finds the
+*              number of ticks until the first task delay, OS_TMR timer or HAL alarm expires and asks the
+*              system clock driver to skip the ticks in between.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) The skipped ticks are replayed by the system clock interrupt, or by OSTicklessExitHook()
+*                 if another interrupt ends the idle period first.
+*********************************************************************************************************
+*/
 void OSTaskIdleHook(void)
 {
+#if OS_TICKLESS_EN > 0
+    INT32U     nticks;
+    INT32U     next;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    nticks = OSTimeTickNext();                            /* Next task delay or pend timeout           */
+#if OS_TMR_EN > 0
+    next   = OSTmrNextGet();                              /* Next OS_TMR expiry, in OSTmrSignal() units */
+    if (next != 0) {
+        next = next * OS_TMR_TICK_DIV - OSTmrCtr;
+        if ((nticks == 0) || (next < nticks)) {
+            nticks = next;
+        }
+    }
+#endif
+    next   = alt_alarm_next();                            /* Next HAL alarm                            */
+    if ((next != 0) && ((nticks == 0) || (next < nticks))) {
+        nticks = next;
+    }
+    if (nticks != 1) {                                    /* 0 means nothing is pending at all         */
+        alt_sysclk_suspend(nticks == 0 ? 0xFFFFFFFF : nticks);
+    }
+    OS_EXIT_CRITICAL();
+#endif
 }
 
+/*
+*********************************************************************************************************
+*                                          TICKLESS EXIT HOOK
+*
+* Description: This function is called by OSIntExit() when an interrupt occurred while the idle task was
+*              running, before the scheduler runs.  The ticks that elapsed while the system clock was
+*              suspended are passed to alt_tick_n() so that OSTime and all delays are up to date.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+void OSTicklessExitHook (void)
+{
+    alt_sysclk_resume();
+}
+#endif
+
 void OSTCBInitHook(OS_TCB *ptcb)
 {
 }
 
 #endif
+
+/*
+*********************************************************************************************************
+*                                           READ THE CYCLE COUNTER
+*
+* Description: This function returns the free running timestamp timer, in CPU cycles, for the timer
+*              callback statistics of OSTmrQuery() and the timestamps of OSTimeTsGet().  It reads zero when
+*              no timestamp timer is selected (hal.timestamp_timer).
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if (OS_TIME_TS_EN > 0) || ((OS_TMR_EN > 0) && (OS_TMR_STATS_EN > 0))
+INT32U OSCPUCyclesGet (void)
+{
+#if OS_CPU_CYCLES_EN > 0
+    return ((INT32U)alt_timestamp());
+#else
+    return (0);
+#endif
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                      GET THE CYCLE COUNTER FREQUENCY
+*
+* Description: This function returns the frequency of OSCPUCyclesGet() in Hz, alt_timestamp_freq(), or zero
+*              when no timestamp timer is selected; OSTimeTsGet() then counts ticks instead.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if OS_TIME_TS_EN > 0
+INT32U OSCPUCyclesFreq (void)
+{
+#if OS_CPU_CYCLES_EN > 0
+    return (alt_timestamp_freq());
+#else
+    return (0);
+#endif
+}
+#endif
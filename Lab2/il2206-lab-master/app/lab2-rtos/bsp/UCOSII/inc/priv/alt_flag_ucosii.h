@@ -71,7 +71,7 @@ static ALT_INLINE int ALT_ALWAYS_INLINE alt_flag_create (OS_FLAG_GRP** pgroup,
 static ALT_INLINE int ALT_ALWAYS_INLINE alt_flag_pend (OS_FLAG_GRP* group, 
                    OS_FLAGS flags, 
                    INT8U wait_type, 
-                   INT16U timeout)
+                   INT32U timeout)
 {
   INT8U err;
   if (OSRunning)
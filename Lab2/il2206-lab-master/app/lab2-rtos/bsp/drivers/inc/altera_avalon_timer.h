@@ -80,6 +80,24 @@ extern void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
 extern void*   altera_avalon_timer_ts_base;
 extern alt_u32 altera_avalon_timer_ts_freq;
 
+/*
+ * The function alt_avalon_timer_ts_init() is the initialisation function for
+ * the timestamp timer. It sets the parameters above, starts the timer free
+ * running unless it is already running, and calibrates alt_busy_sleep()
+ * against it.
+ */
+
+extern void alt_avalon_timer_ts_init (void* base, alt_u32 freq);
+
+/*
+ * The function alt_avalon_timer_hr_init() is the initialisation function for
+ * the high resolution timer, see sys/alt_hrtimer.h. It registers the timers
+ * interrupt handler and starts the timer.
+ */
+
+extern void alt_avalon_timer_hr_init (void* base, alt_u32 irq_controller_id,
+                                      alt_u32 irq, alt_u32 freq);
+
 /*
  * ALTERA_AVALON_TIMER_INSTANCE is the macro used by alt_sys_init() to 
  * allocate any per device memory that may be required. In this case no 
@@ -115,6 +133,17 @@ extern alt_u32 altera_avalon_timer_ts_freq;
 #define ALT_SYS_CLK_BASE _ALT_CLK_BASE(ALT_SYS_CLK)
 #define ALT_TIMESTAMP_CLK_BASE _ALT_CLK_BASE(ALT_TIMESTAMP_CLK)
 
+/*
+ * The high resolution timer is not a BSP setting; it is selected by defining
+ * ALT_HRTIMER_CLK, e.g. to TIMER_1, in the BSP compiler flags.
+ */
+
+#ifndef ALT_HRTIMER_CLK
+#define ALT_HRTIMER_CLK none
+#endif
+
+#define ALT_HRTIMER_CLK_BASE _ALT_CLK_BASE(ALT_HRTIMER_CLK)
+
 /*
  * If there is no system clock, then the above macro will result in 
  * ALT_SYS_CLK_BASE being set to none_BASE. We therefore need to provide an
@@ -124,6 +153,12 @@ extern alt_u32 altera_avalon_timer_ts_freq;
 
 #define none_BASE 0xffffffff
 
+#if (ALT_HRTIMER_CLK_BASE != none_BASE) &&       \
+    ((ALT_HRTIMER_CLK_BASE == ALT_SYS_CLK_BASE) || \
+     (ALT_HRTIMER_CLK_BASE == ALT_TIMESTAMP_CLK_BASE))
+#error "ALT_HRTIMER_CLK must not be the system clock or the timestamp timer"
+#endif
+
 /*
  * ALTERA_AVALON_TIMER_INIT is the macro used by alt_sys_init() to provide
  * the run time initialisation of the device. In this case this translates to
@@ -131,7 +166,8 @@ extern alt_u32 altera_avalon_timer_ts_freq;
  * if it has the name "sysclk".
  *
  * If the device is not the system clock, then it is used to provide the
- * timestamp facility. 
+ * timestamp facility, or the high resolution timers if it is the device
+ * selected by ALT_HRTIMER_CLK. 
  *
  * To ensure as much as possible is evaluated at compile time, rather than 
  * compare the name of the device to "/dev/sysclk" using strcmp(), the base
@@ -169,8 +205,7 @@ extern alt_u32 altera_avalon_timer_ts_freq;
   {                                                                           \
     if (name##_SNAPSHOT)                                                      \
     {                                                                         \
-      altera_avalon_timer_ts_base = (void*) name##_BASE;                      \
-      altera_avalon_timer_ts_freq = name##_FREQ;                              \
+      alt_avalon_timer_ts_init((void*) name##_BASE, name##_FREQ);             \
     }                                                                         \
     else                                                                      \
     {                                                                         \
@@ -180,6 +215,24 @@ extern alt_u32 altera_avalon_timer_ts_freq;
                       "to be readable. Please enable this register for this " \
                       "device in SOPC builder.");                             \
     }                                                                         \
+  }                                                                           \
+  else if (name##_BASE == ALT_HRTIMER_CLK_BASE)                               \
+  {                                                                           \
+    if ((name##_IRQ == ALT_IRQ_NOT_CONNECTED) || name##_FIXED_PERIOD)         \
+    {                                                                         \
+      ALT_LINK_ERROR ("Error: Interrupt not connected or fixed period for "   \
+                      #dev ". "                                               \
+                      "The high resolution timer driver requires an "         \
+                      "interrupt and a writable period register. Please "     \
+                      "change this device in SOPC builder.");                 \
+    }                                                                         \
+    else                                                                      \
+    {                                                                         \
+      alt_avalon_timer_hr_init((void*) name##_BASE,                           \
+                               name##_IRQ_INTERRUPT_CONTROLLER_ID,            \
+                               name##_IRQ,                                    \
+                               name##_FREQ);                                  \
+    }                                                                         \
   }
 
 /*
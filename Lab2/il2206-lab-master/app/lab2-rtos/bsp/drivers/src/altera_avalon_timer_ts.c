@@ -34,6 +34,7 @@
 
 #include "system.h"
 #include "sys/alt_timestamp.h"
+#include "priv/alt_busy_sleep.h"
 
 #include "altera_avalon_timer.h"
 #include "altera_avalon_timer_regs.h"
@@ -140,4 +141,48 @@ alt_u32 alt_timestamp_freq(void)
   return altera_avalon_timer_ts_freq;
 }
 
+/*
+ * alt_avalon_timer_ts_init() is called from the auto-generated alt_sys_init()
+ * function. Unlike alt_timestamp_start(), it runs the timer in continuous
+ * mode, so that it keeps counting for alt_busy_sleep(). If the timer is
+ * already running, e.g. because OSInitHookEnd() started it for profiling, it
+ * is left alone.
+ */
+
+void alt_avalon_timer_ts_init(void* base, alt_u32 freq)
+{
+  altera_avalon_timer_ts_base = base;
+  altera_avalon_timer_ts_freq = freq;
+
+  if (!(IORD_ALTERA_AVALON_TIMER_STATUS (base) & 
+        ALTERA_AVALON_TIMER_STATUS_RUN_MSK))
+  {
+    if(ALT_TIMESTAMP_COUNTER_SIZE == 64) {
+        IOWR_ALTERA_AVALON_TIMER_PERIOD_0 (base, 0xFFFF);
+        IOWR_ALTERA_AVALON_TIMER_PERIOD_1 (base, 0xFFFF);
+        IOWR_ALTERA_AVALON_TIMER_PERIOD_2 (base, 0xFFFF);
+        IOWR_ALTERA_AVALON_TIMER_PERIOD_3 (base, 0xFFFF);
+    } else {
+        IOWR_ALTERA_AVALON_TIMER_PERIODL (base, 0xFFFF);
+        IOWR_ALTERA_AVALON_TIMER_PERIODH (base, 0xFFFF);
+    }
+    IOWR_ALTERA_AVALON_TIMER_CONTROL (base,
+              ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+              ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+  }
+
+  alt_busy_sleep_calibrate ();
+}
+
+#else /* timestamp available */
+
+/*
+ * alt_sys_init() still refers to alt_avalon_timer_ts_init(), in a branch
+ * that is never taken.
+ */
+
+void alt_avalon_timer_ts_init(void* base, alt_u32 freq)
+{
+}
+
 #endif /* timestamp available */
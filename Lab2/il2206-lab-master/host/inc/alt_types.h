@@ -0,0 +1,31 @@
+#ifndef __ALT_TYPES_H__
+#define __ALT_TYPES_H__
+
+/******************************************************************************
+*                                                                             *
+* alt_types.h for the POSIX host port.                                        *
+*                                                                             *
+* Same types as the Nios II HAL, except that the 32 bit types are based on    *
+* int so that they keep their width on 64 bit hosts.                          *
+*                                                                             *
+******************************************************************************/
+
+/* 
+ * Don't declare these typedefs if this file is included by assembly source.
+ */
+#ifndef ALT_ASM_SRC
+typedef signed char  alt_8;
+typedef unsigned char  alt_u8;
+typedef signed short alt_16;
+typedef unsigned short alt_u16;
+typedef signed int alt_32;
+typedef unsigned int alt_u32;
+typedef long long alt_64;
+typedef unsigned long long alt_u64;
+#endif
+
+#define ALT_INLINE        __inline__
+#define ALT_ALWAYS_INLINE __attribute__ ((always_inline))
+#define ALT_WEAK          __attribute__((weak))
+
+#endif /* __ALT_TYPES_H__ */
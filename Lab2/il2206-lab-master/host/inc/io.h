@@ -0,0 +1,54 @@
+#ifndef __IO_H__
+#define __IO_H__
+
+/******************************************************************************
+*                                                                             *
+* io.h for the POSIX host port.                                               *
+*                                                                             *
+* There is no Avalon bus on the host. Register accesses are routed to the     *
+* device models in host/src/alt_host_dev.c, which recognise the base          *
+* addresses from system.h. Accesses to any other address read as zero and     *
+* writes are dropped.                                                         *
+*                                                                             *
+******************************************************************************/
+
+#include <stdint.h>
+
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+extern alt_u32 alt_host_iord (alt_u32 base, alt_u32 regnum);
+extern void    alt_host_iowr (alt_u32 base, alt_u32 regnum, alt_u32 data);
+
+/* Dynamic bus access functions, whole registers only */
+
+#define IORD_32DIRECT(BASE, OFFSET) \
+  alt_host_iord ((alt_u32)(uintptr_t)(BASE), (OFFSET) >> 2)
+#define IORD_16DIRECT(BASE, OFFSET) \
+  ((alt_u16)(IORD_32DIRECT ((BASE), (OFFSET)) >> (((OFFSET) & 2) * 8)))
+#define IORD_8DIRECT(BASE, OFFSET) \
+  ((alt_u8)(IORD_32DIRECT ((BASE), (OFFSET)) >> (((OFFSET) & 3) * 8)))
+
+#define IOWR_32DIRECT(BASE, OFFSET, DATA) \
+  alt_host_iowr ((alt_u32)(uintptr_t)(BASE), (OFFSET) >> 2, (DATA))
+#define IOWR_16DIRECT(BASE, OFFSET, DATA) \
+  IOWR_32DIRECT ((BASE), (OFFSET), (alt_u16)(DATA))
+#define IOWR_8DIRECT(BASE, OFFSET, DATA) \
+  IOWR_32DIRECT ((BASE), (OFFSET), (alt_u8)(DATA))
+
+/* Native bus access functions */
+
+#define IORD(BASE, REGNUM) \
+  alt_host_iord ((alt_u32)(uintptr_t)(BASE), (REGNUM))
+#define IOWR(BASE, REGNUM, DATA) \
+  alt_host_iowr ((alt_u32)(uintptr_t)(BASE), (REGNUM), (DATA))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IO_H__ */
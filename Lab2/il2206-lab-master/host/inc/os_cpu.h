@@ -0,0 +1,101 @@
+#ifndef __OS_CPU_H__
+#define __OS_CPU_H__
+
+/*
+*********************************************************************************************************
+*                                               uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                                       POSIX host specific code
+*
+* File         : OS_CPU.H
+* By           : Based on the Nios II port
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#include "sys/alt_irq.h"
+
+#ifdef  OS_CPU_GLOBALS
+#define OS_CPU_EXT
+#else
+#define OS_CPU_EXT  extern
+#endif
+
+/*****************************************************************************************
+/                                              DATA TYPES
+/                                         (Compiler Specific)
+/
+/ The 32 bit types are based on int so that they keep their width on 64 bit hosts.
+*****************************************************************************************/
+
+typedef unsigned char  BOOLEAN;
+typedef unsigned char  INT8U;                    /* Unsigned  8 bit quantity                           */
+typedef signed   char  INT8S;                    /* Signed    8 bit quantity                           */
+typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity                           */
+typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
+typedef unsigned int   INT32U;                   /* Unsigned 32 bit quantity                           */
+typedef signed   int   INT32S;                   /* Signed   32 bit quantity                           */
+typedef unsigned long long INT64U;               /* Unsigned 64 bit quantity                           */
+typedef signed   long long INT64S;               /* Signed   64 bit quantity                           */
+typedef float          FP32;                     /* Single precision floating point                    */
+typedef double         FP64;                     /* Double precision floating point                    */
+typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits                        */
+
+/*****************************************************************************************
+*                           POSIX host Miscellaneous defines
+*****************************************************************************************/
+
+#define  OS_STK_GROWTH        1        /* Stack grows from HIGH to LOW memory */
+#define  OS_TASK_SW           OSCtxSw
+
+/*
+ * Interrupts and tasks run on the same core, so keeping the compiler from
+ * reordering memory accesses is enough to order them for an ISR.
+ */
+#define  OS_CPU_BARRIER()     __asm__ __volatile__ ("" ::: "memory")
+
+/*
+ * Hosts have a count trailing zeros instruction that __builtin_ctz() maps to.
+ */
+#define  OS_CPU_CNT_TRAIL_ZEROS(word)  ((INT8U)__builtin_ctz((unsigned int)(word)))
+
+/*
+ * Tasks run on host stacks of OS_HOST_STK_SIZE bytes allocated by OSTaskStkInit(). The task stack
+ * given to OSTaskCreate() only holds the pointer to the task's host context, so OSTaskStkChk()
+ * reports the use of the host stack as zero.
+ */
+#define  OS_HOST_STK_SIZE     (64 * 1024)
+
+/******************************************************************************************
+ *                Disable and Enable Interrupts
+ *
+ * Method #3:  Disable/Enable interrupts by preserving the state of interrupts. The state
+ *             of the emulated interrupt enable bit is saved in the local variable 'cpu_sr'.
+ *
+ *****************************************************************************************/
+
+#define  OS_CRITICAL_METHOD    3    
+
+#if      OS_CRITICAL_METHOD == 3
+#define  OS_CPU_SR alt_irq_context  
+#define  OS_ENTER_CRITICAL() \
+         cpu_sr = alt_irq_disable_all ()
+#define  OS_EXIT_CRITICAL() \
+         alt_irq_enable_all (cpu_sr);
+#endif
+
+/* Prototypes */
+void OSStartHighRdy(void); 
+void OSCtxSw(void); 
+void OSIntCtxSw(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __OS_CPU_H__ */
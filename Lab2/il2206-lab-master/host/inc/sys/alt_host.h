@@ -0,0 +1,93 @@
+#ifndef __ALT_HOST_H__
+#define __ALT_HOST_H__
+
+/******************************************************************************
+*                                                                             *
+* alt_host.h - services of the POSIX host port used by the port itself.       *
+*                                                                             *
+* Applications don't need this file; they use the normal HAL headers.         *
+*                                                                             *
+******************************************************************************/
+
+#include "alt_types.h"
+#include "system.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * Time bases. In real time mode the system clock follows the host's wall
+ * clock. In virtual time mode (HOST_TIME=virtual) it follows the CPU time
+ * used by the process, and ticks are skipped over while the idle task runs,
+ * so that delays cost no host time and results don't depend on host load.
+ */
+#define ALT_HOST_TIME_REAL     0
+#define ALT_HOST_TIME_VIRTUAL  1
+
+extern int alt_host_time_mode;
+
+/*
+ * The ALT_SYS_CLK macros of system.h name the system clock timer, e.g.
+ * TIMER_0; build the names of its base address, IRQ and rate from it.
+ */
+#define ALT_HOST_CAT(a, b)       a ## b
+#define ALT_HOST_SYM(dev, sym)   ALT_HOST_CAT(dev, sym)
+
+#define ALT_HOST_SYS_CLK_BASE    ALT_HOST_SYM(ALT_SYS_CLK, _BASE)
+#define ALT_HOST_SYS_CLK_IRQ     ALT_HOST_SYM(ALT_SYS_CLK, _IRQ)
+#define ALT_HOST_SYS_CLK_RATE    ALT_HOST_SYM(ALT_SYS_CLK, _TICKS_PER_SEC)
+
+#define ALT_HOST_CYCLES_PER_TICK ((alt_u64) (ALT_CPU_FREQ / ALT_HOST_SYS_CLK_RATE))
+
+/*
+ * alt_host_cycles() returns the number of ALT_CPU_FREQ clock cycles since
+ * the program started. It drives the system clock, the performance counter,
+ * the timestamp driver and the task profiling hooks.
+ */
+extern alt_u64 alt_host_cycles (void);
+
+/*
+ * alt_host_clock_advance() moves the clock forward, in virtual time mode
+ * only. It must be called with interrupts disabled.
+ */
+extern void alt_host_clock_advance (alt_u64 cycles);
+
+/*
+ * alt_host_sys_init() is the host counterpart of alt_sys_init(): it resets
+ * the device models and starts the system clock.
+ */
+extern void alt_host_sys_init (void);
+
+/*
+ * alt_host_sysclk_init() registers the system clock interrupt and starts
+ * the host interval timer that raises it.
+ */
+extern void alt_host_sysclk_init (void);
+
+/*
+ * alt_host_hrtimer_init() registers the interrupt of the high resolution
+ * timer selected by ALT_HRTIMER_CLK, if any, and creates the host timer
+ * that raises it.
+ */
+extern void alt_host_hrtimer_init (void);
+
+/*
+ * alt_host_dev_poll() reads pending commands from stdin and applies them to
+ * the input devices. It is called by the system clock interrupt.
+ */
+extern void alt_host_dev_poll (void);
+
+/*
+ * alt_host_idle() is called by the idle task. It waits for the next
+ * interrupt, or raises the next system clock tick at once in virtual time
+ * mode.
+ */
+extern void alt_host_idle (void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ALT_HOST_H__ */
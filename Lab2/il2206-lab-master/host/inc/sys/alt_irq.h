@@ -0,0 +1,202 @@
+#ifndef __ALT_IRQ_H__
+#define __ALT_IRQ_H__
+
+/******************************************************************************
+*                                                                             *
+* alt_irq.h for the POSIX host port.                                          *
+*                                                                             *
+* The processor's interrupt enable bit and the ipending/ienable registers are *
+* plain variables. Devices raise an interrupt by setting its bit in           *
+* alt_host_irq_pending; if interrupts are enabled the handler runs straight   *
+* away (normally from a signal handler, see alt_host_irq.c), otherwise it     *
+* runs when alt_irq_enable_all() enables interrupts again. Handlers are       *
+* wrapped in OSIntEnter()/OSIntExit() just like alt_irq_handler() does on    *
+* the target.                                                                 *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+
+#include "alt_types.h"
+#include "system.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * Macros used by alt_irq_enabled
+ */
+#define ALT_IRQ_ENABLED  1
+#define ALT_IRQ_DISABLED 0  
+
+/* 
+ * Number of available interrupts in the emulated interrupt controller.
+ */
+#define ALT_NIRQ 32
+
+/*
+ * Used by alt_irq_disable_all() and alt_irq_enable_all().
+ */
+typedef int alt_irq_context;
+
+/* ISR Prototype */
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+typedef void (*alt_isr_func)(void* isr_context);
+#else
+typedef void (*alt_isr_func)(void* isr_context, alt_u32 id);
+#endif
+
+/*
+ * Emulated processor state. Only the functions below and alt_host_irq.c
+ * should touch these.
+ */
+extern volatile alt_irq_context alt_host_irq_status;
+extern volatile alt_u32         alt_host_irq_pending;
+
+extern void alt_host_irq_raise (alt_u32 irq);
+extern void alt_host_irq_dispatch (void);
+
+/*
+ * The compiler must not move memory accesses across a change of the
+ * interrupt enable bit, since the "interrupt" is a signal handler running
+ * on the same thread.
+ */
+#define ALT_HOST_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+
+/*
+ * With ALT_HOST_IRQ_OFF_STATS defined (HOST_CFLAGS) the port measures how
+ * long interrupts stay disabled, by alt_irq_disable_all() or while handlers
+ * run, in cycles of alt_host_cycles(). alt_host_irq_off_max() returns the
+ * longest time since alt_host_irq_off_reset() was called.
+ */
+#ifdef ALT_HOST_IRQ_OFF_STATS
+extern void    alt_host_irq_off_begin (void);
+extern void    alt_host_irq_off_end (void);
+extern alt_u64 alt_host_irq_off_max (void);
+extern void    alt_host_irq_off_reset (void);
+
+#define ALT_HOST_IRQ_OFF_BEGIN() alt_host_irq_off_begin ()
+#define ALT_HOST_IRQ_OFF_END()   alt_host_irq_off_end ()
+#else
+#define ALT_HOST_IRQ_OFF_BEGIN()
+#define ALT_HOST_IRQ_OFF_END()
+#endif
+
+/*
+ * alt_irq_enabled can be called to determine if the processor's global
+ * interrupt enable is asserted. The return value is zero if interrupts 
+ * are disabled, and non-zero otherwise.
+ */
+static ALT_INLINE int ALT_ALWAYS_INLINE alt_irq_enabled (void)
+{
+  return alt_host_irq_status;
+}
+
+/*
+ * alt_irq_disable_all() 
+ *
+ * This routine inhibits all interrupts by negating the status register PIE 
+ * bit. It returns the previous contents of the CPU status register (IRQ 
+ * context) which can be used to restore the status register PIE bit to its 
+ * state before this routine was called.
+ */
+static ALT_INLINE alt_irq_context ALT_ALWAYS_INLINE 
+       alt_irq_disable_all (void)
+{
+  alt_irq_context context;
+
+  ALT_HOST_BARRIER ();
+  context             = alt_host_irq_status;
+  alt_host_irq_status = ALT_IRQ_DISABLED;
+  ALT_HOST_BARRIER ();
+  if (context)
+  {
+    ALT_HOST_IRQ_OFF_BEGIN ();
+  }
+
+  return context;
+}
+
+/*
+ * alt_irq_enable_all() 
+ *
+ * Enable all interrupts that were previously disabled by alt_irq_disable_all()
+ *
+ * Interrupts that were raised while they were disabled are taken here.
+ */
+static ALT_INLINE void ALT_ALWAYS_INLINE 
+       alt_irq_enable_all (alt_irq_context context)
+{
+  if (context && !alt_host_irq_status)
+  {
+    ALT_HOST_IRQ_OFF_END ();
+  }
+  ALT_HOST_BARRIER ();
+  alt_host_irq_status = context;
+  ALT_HOST_BARRIER ();
+  if (context && alt_host_irq_pending)
+  {
+    alt_host_irq_dispatch ();
+  }
+}
+
+/*
+ * alt_irq_cpu_enable_interrupts() enables the CPU to start taking interrupts.
+ */
+static ALT_INLINE void ALT_ALWAYS_INLINE 
+       alt_irq_cpu_enable_interrupts (void)
+{
+  alt_irq_enable_all (ALT_IRQ_ENABLED);
+}
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+/*
+ * alt_ic_isr_register() can be used to register an interrupt handler. If the
+ * function is succesful, then the requested interrupt will be enabled upon 
+ * return.
+ */
+extern int alt_ic_isr_register(alt_u32 ic_id,
+                        alt_u32 irq,
+                        alt_isr_func isr,
+                        void *isr_context,
+                        void *flags);
+
+/* 
+ * alt_ic_irq_enable() and alt_ic_irq_disable() enable/disable a specific 
+ * interrupt by using IRQ port and interrupt controller instance.
+ */
+int alt_ic_irq_enable (alt_u32 ic_id, alt_u32 irq);
+int alt_ic_irq_disable(alt_u32 ic_id, alt_u32 irq);        
+
+ /* 
+ * alt_ic_irq_enabled() indicates whether a specific interrupt, as
+ * specified by IRQ port and interrupt controller instance is enabled.
+ */        
+alt_u32 alt_ic_irq_enabled(alt_u32 ic_id, alt_u32 irq);
+
+#else 
+/*
+ * Prototypes for the legacy interrupt API.
+ */
+extern int alt_irq_register (alt_u32 id, 
+                             void*   context, 
+                             alt_isr_func handler);
+extern int alt_irq_enable (alt_u32 id);
+extern int alt_irq_disable (alt_u32 id);
+#endif 
+
+/*
+ * alt_irq_pending() returns a bit list of the current pending interrupts.
+ */
+static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_irq_pending (void)
+{
+  return alt_host_irq_pending;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ALT_IRQ_H__ */
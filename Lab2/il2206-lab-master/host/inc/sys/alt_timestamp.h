@@ -0,0 +1,32 @@
+#ifndef __ALT_TIMESTAMP_H__
+#define __ALT_TIMESTAMP_H__
+
+/******************************************************************************
+*                                                                             *
+* alt_timestamp.h for the POSIX host port.                                    *
+*                                                                             *
+* The timestamp counter counts at ALT_CPU_FREQ from the host's monotonic      *
+* clock, whether or not a timestamp timer was selected in the BSP.            *
+*                                                                             *
+******************************************************************************/
+
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#define alt_timestamp_type alt_u32
+
+extern int alt_timestamp_start (void);
+
+extern alt_timestamp_type alt_timestamp (void);
+
+extern alt_u32 alt_timestamp_freq (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ALT_TIMESTAMP_H__ */
@@ -0,0 +1,68 @@
+#!/bin/bash
+# @file: run.sh
+# @date: 17-10-2026
+# @version: 0.1
+#
+# This is a bash script for compiling and running an application of the
+# 'app' folder on the workstation instead of the DE2 board. The
+# uC/OS-II kernel and the HAL sources are taken unmodified from a BSP
+# folder, only the processor specific parts are replaced by the POSIX
+# host port in this folder (see README.md).
+#
+# Usage: ./run.sh <application folder> [BSP folder]
+#
+#        ./run.sh ../app/7_CONTROLLAW
+#        HOST_TIME=virtual ./run.sh ../app/12_EDF
+#        HOST_CFLAGS=-DALT_HRTIMER_CLK=TIMER_1 ./run.sh ../app/16_HrTimer
+#
+# The BSP defaults to the one of 7_CONTROLLAW, which is generated for
+# the same hardware as the other applications. Its os_cfg.h and
+# system.h are used as they are. HOST_CFLAGS takes the symbols that
+# the BSP of the board gets from hal.make.bsp_cflags_defined_symbols.
+
+APP_PATH=${1:?"usage: $0 <application folder> [BSP folder]"}
+BSP_PATH=${2:-../app/7_CONTROLLAW/bsp}
+HOST_PATH=$(dirname $0)
+APP_NAME=$(basename $APP_PATH)
+
+if [ -d $APP_PATH/src ]; then
+    SRC_PATH=$APP_PATH/src
+else
+    SRC_PATH=$APP_PATH
+fi
+
+mkdir -p $HOST_PATH/bin
+
+echo -e "\n******************************************"
+echo -e   "Compiling the program for the workstation"
+echo -e   "******************************************\n"
+
+# The host port headers come first so that they replace the Nios II
+# ones (os_cpu.h, alt_types.h, io.h, sys/alt_irq.h, sys/alt_timestamp.h)
+gcc -g -O0 -Wall -D__hal__ -D__ucosii__ $HOST_CFLAGS \
+    -I$HOST_PATH/inc \
+    -I$BSP_PATH/UCOSII/inc \
+    -I$BSP_PATH/HAL/inc \
+    -I$BSP_PATH \
+    -I$BSP_PATH/drivers/inc \
+    -o $HOST_PATH/bin/$APP_NAME \
+    $SRC_PATH/*.c \
+    $BSP_PATH/UCOSII/src/os_*.c \
+    $BSP_PATH/HAL/src/alt_alarm_start.c \
+    $BSP_PATH/HAL/src/alt_hrtimer.c \
+    $BSP_PATH/HAL/src/alt_irq_stats.c \
+    $BSP_PATH/HAL/src/alt_tick.c \
+    $BSP_PATH/drivers/src/altera_avalon_performance_counter.c \
+    $HOST_PATH/src/*.c \
+    2>&1 | tee $HOST_PATH/bin/$APP_NAME.log
+
+if [ ${PIPESTATUS[0]} -ne 0 ]; then
+    echo "Code compilation errors are logged in '$HOST_PATH/bin/$APP_NAME.log'"
+    exit 1
+fi
+
+echo -e "\n**************************"
+echo -e   "Running the program"
+echo -e   "**************************\n"
+
+exec $HOST_PATH/bin/$APP_NAME
@@ -0,0 +1,558 @@
+/******************************************************************************
+*                                                                             *
+* alt_host_dev.c - device models of the POSIX host port.                      *
+*                                                                             *
+* IORD()/IOWR() accesses are decoded by base address (from system.h) and      *
+* handled by models of the DE2 PIOs, the performance counter, the JTAG UART   *
+* and the registers of the system clock timer that applications read. The     *
+* timestamp driver is implemented on the host clock as well.                  *
+*                                                                             *
+* Inputs are driven from stdin, one command per line, read on every system    *
+* clock tick:                                                                 *
+*                                                                             *
+*   keys <mask>      push buttons held down, bit n is KEY n                   *
+*   switches <mask>  positions of the toggle switches                         *
+*   quit             end the program                                          *
+*                                                                             *
+* Masks are C style numbers (0x.. for hexadecimal). Writes that change an     *
+* output PIO are logged on stderr when HOST_TRACE_PIO is set.                 *
+*                                                                             *
+******************************************************************************/
+
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "system.h"
+#include "io.h"
+#include "sys/alt_irq.h"
+#include "sys/alt_alarm.h"
+#include "sys/alt_timestamp.h"
+#include "sys/alt_host.h"
+
+/*
+ * Clock
+ */
+
+static struct timespec alt_host_clock_start;
+static alt_u64         alt_host_clock_skipped;
+
+static void alt_host_clock_read (struct timespec* now)
+{
+  clock_gettime ((alt_host_time_mode == ALT_HOST_TIME_VIRTUAL) ?
+                 CLOCK_PROCESS_CPUTIME_ID : CLOCK_MONOTONIC, now);
+}
+
+/*
+ * Cycles at ALT_CPU_FREQ since alt_host_sys_init(). In virtual time mode
+ * this is the CPU time of the process plus the time skipped while idle.
+ */
+alt_u64 alt_host_cycles (void)
+{
+  struct timespec now;
+  alt_u64         sec;
+  alt_u64         nsec;
+
+  alt_host_clock_read (&now);
+  sec  = (alt_u64) (now.tv_sec - alt_host_clock_start.tv_sec);
+  nsec = (alt_u64) now.tv_nsec;
+  if (now.tv_nsec < alt_host_clock_start.tv_nsec)
+  {
+    sec--;
+    nsec += 1000000000ULL;
+  }
+  nsec -= (alt_u64) alt_host_clock_start.tv_nsec;
+
+  return sec * ALT_CPU_FREQ + nsec * ALT_CPU_FREQ / 1000000000ULL +
+         alt_host_clock_skipped;
+}
+
+void alt_host_clock_advance (alt_u64 cycles)
+{
+  alt_host_clock_skipped += cycles;
+}
+
+/*
+ * Timestamp driver
+ */
+
+static alt_u64 alt_host_timestamp_start;
+
+int alt_timestamp_start (void)
+{
+  alt_host_timestamp_start = alt_host_cycles ();
+  return 0;
+}
+
+alt_timestamp_type alt_timestamp (void)
+{
+  return (alt_timestamp_type) (alt_host_cycles () - alt_host_timestamp_start);
+}
+
+alt_u32 alt_timestamp_freq (void)
+{
+  return ALT_CPU_FREQ;
+}
+
+/*
+ * PIO
+ *
+ * Registers: 0 data, 1 direction, 2 interrupt mask, 3 edge capture. Writing
+ * the edge capture register clears all its bits.
+ */
+
+#define ALT_HOST_EDGE_RISING   1
+#define ALT_HOST_EDGE_FALLING  2
+
+typedef struct {
+  const char* name;                     /* Name used by commands and trace  */
+  alt_u32     base;
+  int         irq;                      /* -1 if the PIO has no interrupt   */
+  int         input;                    /* Driven from stdin                */
+  int         active_low;               /* Input reads 0 while pressed      */
+  const char* edge_type;
+  alt_u32     width_mask;
+  alt_u32     edges;                    /* ALT_HOST_EDGE_... captured        */
+  alt_u32     in;
+  alt_u32     out;
+  alt_u32     direction;
+  alt_u32     irqmask;
+  alt_u32     edgecapture;
+} alt_host_pio;
+
+#define ALT_HOST_PIO(dev, nm, is_input, is_active_low)                 \
+  { nm, dev##_BASE, dev##_IRQ, is_input, is_active_low,                \
+    dev##_EDGE_TYPE, (alt_u32) ((1ULL << dev##_DATA_WIDTH) - 1) }
+
+static alt_host_pio alt_host_pio_tbl[] = {
+#ifdef D2_PIO_KEYS4_BASE
+  ALT_HOST_PIO (D2_PIO_KEYS4,       "keys",     1, 1),
+#endif
+#ifdef DE2_PIO_KEYS4_BASE
+  ALT_HOST_PIO (DE2_PIO_KEYS4,      "keys",     1, 1),
+#endif
+#ifdef DE2_PIO_TOGGLES18_BASE
+  ALT_HOST_PIO (DE2_PIO_TOGGLES18,  "switches", 1, 0),
+#endif
+#ifdef DE2_PIO_REDLED18_BASE
+  ALT_HOST_PIO (DE2_PIO_REDLED18,   "ledr",     0, 0),
+#endif
+#ifdef DE2_PIO_GREENLED9_BASE
+  ALT_HOST_PIO (DE2_PIO_GREENLED9,  "ledg",     0, 0),
+#endif
+#ifdef DE2_PIO_HEX_LOW28_BASE
+  ALT_HOST_PIO (DE2_PIO_HEX_LOW28,  "hex_low",  0, 0),
+#endif
+#ifdef DE2_PIO_HEX_HIGH28_BASE
+  ALT_HOST_PIO (DE2_PIO_HEX_HIGH28, "hex_high", 0, 0),
+#endif
+};
+
+#define ALT_HOST_NPIO (sizeof (alt_host_pio_tbl) / sizeof (alt_host_pio_tbl[0]))
+
+static int alt_host_trace_pio;
+
+static void alt_host_pio_irq_update (alt_host_pio* pio)
+{
+  if ((pio->irq >= 0) && (pio->edgecapture & pio->irqmask))
+  {
+    alt_host_irq_raise ((alt_u32) pio->irq);
+  }
+}
+
+/*
+ * Sets the level of the input pins and captures the edges.
+ */
+static void alt_host_pio_set (alt_host_pio* pio, alt_u32 value)
+{
+  alt_u32 old = pio->in;
+
+  pio->in = value & pio->width_mask;
+  if (pio->edges & ALT_HOST_EDGE_RISING)
+  {
+    pio->edgecapture |= ~old & pio->in;
+  }
+  if (pio->edges & ALT_HOST_EDGE_FALLING)
+  {
+    pio->edgecapture |= old & ~pio->in;
+  }
+  alt_host_pio_irq_update (pio);
+}
+
+static alt_u32 alt_host_pio_rd (alt_host_pio* pio, alt_u32 regnum)
+{
+  switch (regnum)
+  {
+  case 0: return pio->input ? pio->in : pio->out;
+  case 1: return pio->direction;
+  case 2: return pio->irqmask;
+  case 3: return pio->edgecapture;
+  }
+  return 0;
+}
+
+static void alt_host_pio_wr (alt_host_pio* pio, alt_u32 regnum, alt_u32 data)
+{
+  char buf[64];
+  int  len;
+
+  switch (regnum)
+  {
+  case 0:
+    data &= pio->width_mask;
+    if (alt_host_trace_pio && !pio->input && (data != pio->out))
+    {
+      len = snprintf (buf, sizeof (buf), "[%u] %s = 0x%x\n",
+                      (unsigned) alt_nticks (), pio->name, (unsigned) data);
+      (void) write (STDERR_FILENO, buf, len);
+    }
+    pio->out = data;
+    break;
+  case 1:
+    pio->direction = data;
+    break;
+  case 2:
+    pio->irqmask = data;
+    alt_host_pio_irq_update (pio);
+    break;
+  case 3:
+    pio->edgecapture = 0;
+    break;
+  }
+}
+
+/*
+ * Performance counter
+ *
+ * Section n uses registers 4n (time, low word; a write ends the section),
+ * 4n + 1 (time, high word; a write begins the section) and 4n + 2 (number of
+ * times the section was begun). Section 0 is the global counter: the other
+ * sections only count while it runs. Writing 1 to register 0 resets all.
+ */
+
+#ifdef PERFORMANCE_COUNTER_BASE
+#define ALT_HOST_PERF_SECTIONS (PERFORMANCE_COUNTER_HOW_MANY_SECTIONS + 1)
+
+static struct {
+  int     running;
+  alt_u64 start;
+  alt_u64 time;
+  alt_u32 starts;
+} alt_host_perf[ALT_HOST_PERF_SECTIONS];
+
+static void alt_host_perf_end (int n, alt_u64 now)
+{
+  if (alt_host_perf[n].running)
+  {
+    alt_host_perf[n].time   += now - alt_host_perf[n].start;
+    alt_host_perf[n].running = 0;
+  }
+}
+
+static alt_u32 alt_host_perf_rd (alt_u32 regnum)
+{
+  alt_u32 n = regnum / 4;
+  alt_u64 time;
+
+  if (n >= ALT_HOST_PERF_SECTIONS)
+  {
+    return 0;
+  }
+  time = alt_host_perf[n].time;
+  if (alt_host_perf[n].running)
+  {
+    time += alt_host_cycles () - alt_host_perf[n].start;
+  }
+  switch (regnum % 4)
+  {
+  case 0: return (alt_u32) time;
+  case 1: return (alt_u32) (time >> 32);
+  case 2: return alt_host_perf[n].starts;
+  }
+  return 0;
+}
+
+static void alt_host_perf_wr (alt_u32 regnum, alt_u32 data)
+{
+  alt_u32 n   = regnum / 4;
+  alt_u64 now = alt_host_cycles ();
+  alt_u32 i;
+
+  if (n >= ALT_HOST_PERF_SECTIONS)
+  {
+    return;
+  }
+  if ((regnum == 0) && (data & 1))
+  {
+    memset (alt_host_perf, 0, sizeof (alt_host_perf));
+    return;
+  }
+  switch (regnum % 4)
+  {
+  case 0:
+    alt_host_perf_end (n, now);
+    if (n == 0)
+    {
+      for (i = 1; i < ALT_HOST_PERF_SECTIONS; i++)
+      {
+        alt_host_perf_end (i, now);
+      }
+    }
+    break;
+  case 1:
+    if (!alt_host_perf[n].running && ((n == 0) || alt_host_perf[0].running))
+    {
+      alt_host_perf[n].running = 1;
+      alt_host_perf[n].start   = now;
+      alt_host_perf[n].starts++;
+    }
+    break;
+  }
+}
+#endif /* PERFORMANCE_COUNTER_BASE */
+
+/*
+ * System clock timer
+ *
+ * Only the period (registers 2 and 3) and the snapshot of the counter
+ * (registers 4 and 5, latched by a write to either) are modelled. The counter
+ * counts down from period - 1 to 0 once per tick of alt_host_cycles().
+ */
+
+static alt_u32 alt_host_sysclk_snap;
+
+static alt_u32 alt_host_sysclk_rd (alt_u32 regnum)
+{
+  alt_u32 period = (alt_u32) ALT_HOST_CYCLES_PER_TICK - 1;
+
+  switch (regnum)
+  {
+  case 2: return period & 0xffff;
+  case 3: return period >> 16;
+  case 4: return alt_host_sysclk_snap & 0xffff;
+  case 5: return alt_host_sysclk_snap >> 16;
+  }
+  return 0;
+}
+
+static void alt_host_sysclk_wr (alt_u32 regnum, alt_u32 data)
+{
+  if ((regnum == 4) || (regnum == 5))
+  {
+    alt_host_sysclk_snap = (alt_u32) (ALT_HOST_CYCLES_PER_TICK - 1 -
+                           alt_host_cycles () % ALT_HOST_CYCLES_PER_TICK);
+  }
+}
+
+/*
+ * JTAG UART
+ *
+ * Register 0 is the data register, register 1 the control register, which
+ * always reports free space for writing and no interrupt. Nothing is read.
+ */
+
+#ifdef JTAG_UART_0_BASE
+static alt_u32 alt_host_jtag_uart_rd (alt_u32 regnum)
+{
+  return (regnum == 1) ? 0xffff0000 : 0;
+}
+
+static void alt_host_jtag_uart_wr (alt_u32 regnum, alt_u32 data)
+{
+  char c = (char) data;
+
+  if (regnum == 0)
+  {
+    (void) write (STDOUT_FILENO, &c, 1);
+  }
+}
+#endif /* JTAG_UART_0_BASE */
+
+/*
+ * Register access
+ */
+
+static alt_host_pio* alt_host_pio_find (alt_u32 base)
+{
+  unsigned int i;
+
+  for (i = 0; i < ALT_HOST_NPIO; i++)
+  {
+    if (alt_host_pio_tbl[i].base == base)
+    {
+      return &alt_host_pio_tbl[i];
+    }
+  }
+  return NULL;
+}
+
+alt_u32 alt_host_iord (alt_u32 base, alt_u32 regnum)
+{
+  alt_host_pio*   pio;
+  alt_irq_context context;
+  alt_u32         data = 0;
+
+  context = alt_irq_disable_all ();
+  if ((pio = alt_host_pio_find (base)) != NULL)
+  {
+    data = alt_host_pio_rd (pio, regnum);
+  }
+#ifdef PERFORMANCE_COUNTER_BASE
+  else if (base == PERFORMANCE_COUNTER_BASE)
+  {
+    data = alt_host_perf_rd (regnum);
+  }
+#endif
+  else if (base == ALT_HOST_SYS_CLK_BASE)
+  {
+    data = alt_host_sysclk_rd (regnum);
+  }
+#ifdef JTAG_UART_0_BASE
+  else if (base == JTAG_UART_0_BASE)
+  {
+    data = alt_host_jtag_uart_rd (regnum);
+  }
+#endif
+  alt_irq_enable_all (context);
+
+  return data;
+}
+
+void alt_host_iowr (alt_u32 base, alt_u32 regnum, alt_u32 data)
+{
+  alt_host_pio*   pio;
+  alt_irq_context context;
+
+  context = alt_irq_disable_all ();
+  if ((pio = alt_host_pio_find (base)) != NULL)
+  {
+    alt_host_pio_wr (pio, regnum, data);
+  }
+#ifdef PERFORMANCE_COUNTER_BASE
+  else if (base == PERFORMANCE_COUNTER_BASE)
+  {
+    alt_host_perf_wr (regnum, data);
+  }
+#endif
+  else if (base == ALT_HOST_SYS_CLK_BASE)
+  {
+    alt_host_sysclk_wr (regnum, data);
+  }
+#ifdef JTAG_UART_0_BASE
+  else if (base == JTAG_UART_0_BASE)
+  {
+    alt_host_jtag_uart_wr (regnum, data);
+  }
+#endif
+  alt_irq_enable_all (context);
+}
+
+/*
+ * Input commands
+ */
+
+static char         alt_host_line[128];
+static unsigned int alt_host_line_len;
+static int          alt_host_stdin_eof;
+
+static void alt_host_command (char* line)
+{
+  char*         arg;
+  alt_host_pio* pio;
+  unsigned int  i;
+  alt_u32       value;
+
+  arg = strchr (line, ' ');
+  if (arg != NULL)
+  {
+    *arg++ = '\0';
+  }
+  if (!strcmp (line, "quit"))
+  {
+    _exit (0);
+  }
+  for (i = 0; i < ALT_HOST_NPIO; i++)
+  {
+    pio = &alt_host_pio_tbl[i];
+    if (pio->input && !strcmp (line, pio->name) && (arg != NULL))
+    {
+      value = (alt_u32) strtoul (arg, NULL, 0);
+      alt_host_pio_set (pio, pio->active_low ? ~value : value);
+      return;
+    }
+  }
+  if (line[0] != '\0')
+  {
+    (void) write (STDERR_FILENO, "host: unknown command\n", 22);
+  }
+}
+
+/*
+ * Called from the system clock interrupt, so it only takes what is already
+ * available on stdin.
+ */
+void alt_host_dev_poll (void)
+{
+  struct pollfd fd;
+  char          c;
+
+  fd.fd     = STDIN_FILENO;
+  fd.events = POLLIN;
+  while (!alt_host_stdin_eof && (poll (&fd, 1, 0) > 0))
+  {
+    if (read (STDIN_FILENO, &c, 1) != 1)
+    {
+      alt_host_stdin_eof = 1;
+      break;
+    }
+    if (c == '\n')
+    {
+      alt_host_line[alt_host_line_len] = '\0';
+      alt_host_line_len = 0;
+      alt_host_command (alt_host_line);
+    }
+    else if (alt_host_line_len < sizeof (alt_host_line) - 1)
+    {
+      alt_host_line[alt_host_line_len++] = c;
+    }
+  }
+}
+
+/*
+ * alt_host_sys_init() resets the devices and starts the system clock and
+ * the high resolution timer.
+ */
+void alt_host_sys_init (void)
+{
+  alt_host_pio* pio;
+  const char*   mode;
+  unsigned int  i;
+
+  mode = getenv ("HOST_TIME");
+  if (mode && !strcmp (mode, "virtual"))
+  {
+    alt_host_time_mode = ALT_HOST_TIME_VIRTUAL;
+  }
+  alt_host_trace_pio = getenv ("HOST_TRACE_PIO") != NULL;
+
+  for (i = 0; i < ALT_HOST_NPIO; i++)
+  {
+    pio = &alt_host_pio_tbl[i];
+    if (!strcmp (pio->edge_type, "RISING") || !strcmp (pio->edge_type, "ANY"))
+    {
+      pio->edges |= ALT_HOST_EDGE_RISING;
+    }
+    if (!strcmp (pio->edge_type, "FALLING") || !strcmp (pio->edge_type, "ANY"))
+    {
+      pio->edges |= ALT_HOST_EDGE_FALLING;
+    }
+    pio->in = pio->active_low ? pio->width_mask : 0;
+  }
+
+  alt_host_clock_read (&alt_host_clock_start);
+  alt_host_sysclk_init ();
+  alt_host_hrtimer_init ();
+}
@@ -0,0 +1,529 @@
+/******************************************************************************
+*                                                                             *
+* alt_host_irq.c - interrupt controller and system clock of the POSIX host    *
+* port.                                                                       *
+*                                                                             *
+* The system clock is a POSIX interval timer. Its signal raises the timer     *
+* interrupt; when interrupts are enabled the interrupt is handled inside the  *
+* signal handler, which may switch to another task through OSIntExit(), the   *
+* same way the interrupt handler preempts a task on the target. Otherwise the *
+* interrupt stays pending until alt_irq_enable_all() is called.               *
+*                                                                             *
+* The high resolution timer of sys/alt_hrtimer.h, when ALT_HRTIMER_CLK names  *
+* a timer, is a POSIX one-shot timer on the same clock, which raises the      *
+* interrupt of the selected timer.                                            *
+*                                                                             *
+* For the tickless idle mode, alt_sysclk_suspend() turns the system clock     *
+* into a simulated one-shot timer: the interrupt is not raised again until    *
+* the requested tick, and in virtual time mode the idle task jumps straight   *
+* to it.                                                                      *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "sys/alt_irq_stats.h"
+#include "sys/alt_alarm.h"
+#include "sys/alt_hrtimer.h"
+#include "sys/alt_host.h"
+#include "os/alt_hooks.h"
+#include "altera_avalon_timer.h"
+
+#ifndef ALT_SYS_CLK
+#error "The host port needs a system clock timer (hal.sys_clk_timer)"
+#endif
+
+volatile alt_irq_context alt_host_irq_status = ALT_IRQ_DISABLED;
+volatile alt_u32         alt_host_irq_pending;
+
+int alt_host_time_mode = ALT_HOST_TIME_REAL;
+
+static volatile alt_u32 alt_host_irq_ienable;
+
+static struct {
+  alt_isr_func isr;
+  void*        context;
+} alt_host_irq_table[ALT_NIRQ];
+
+/*
+ * alt_host_irq_raise() marks an interrupt as pending. It may be called from
+ * a signal handler.
+ */
+void alt_host_irq_raise (alt_u32 irq)
+{
+  __sync_fetch_and_or (&alt_host_irq_pending, 1u << irq);
+}
+
+/*
+ * alt_host_irq_dispatch() runs the handlers of all pending and enabled
+ * interrupts, lowest IRQ number first, with interrupts disabled. It is
+ * called when interrupts are enabled, so they are enabled again on return,
+ * possibly after other tasks have run.
+ */
+void alt_host_irq_dispatch (void)
+{
+  alt_u32 active;
+  alt_u32 irq;
+#if ALT_IRQ_STATS_EN > 0
+  alt_u32 entry;
+  alt_u32 start;
+#endif
+
+  alt_host_irq_status = ALT_IRQ_DISABLED;
+  ALT_HOST_BARRIER ();
+  ALT_HOST_IRQ_OFF_BEGIN ();
+#if ALT_IRQ_STATS_EN > 0
+  entry = (alt_u32) alt_timestamp ();
+  alt_irq_stats_enter ();
+#endif
+
+  while ((active = alt_host_irq_pending & alt_host_irq_ienable) != 0)
+  {
+    irq = __builtin_ctz (active);
+    __sync_fetch_and_and (&alt_host_irq_pending, ~(1u << irq));
+
+    ALT_OS_INT_ENTER ();
+#if ALT_IRQ_STATS_EN > 0
+    start = (alt_u32) alt_timestamp ();
+#endif
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+    alt_host_irq_table[irq].isr (alt_host_irq_table[irq].context);
+#else
+    alt_host_irq_table[irq].isr (alt_host_irq_table[irq].context, irq);
+#endif
+#if ALT_IRQ_STATS_EN > 0
+    alt_irq_stats_call (irq, entry, start);
+#endif
+    ALT_OS_INT_EXIT ();
+  }
+#if ALT_IRQ_STATS_EN > 0
+  alt_irq_stats_exit ();
+#endif
+
+  ALT_HOST_IRQ_OFF_END ();
+  ALT_HOST_BARRIER ();
+  alt_host_irq_status = ALT_IRQ_ENABLED;
+}
+
+#ifdef ALT_HOST_IRQ_OFF_STATS
+
+static alt_u64 alt_host_irq_off_start;
+static alt_u64 alt_host_irq_off_longest;
+
+void alt_host_irq_off_begin (void)
+{
+  alt_host_irq_off_start = alt_host_cycles ();
+}
+
+void alt_host_irq_off_end (void)
+{
+  alt_u64 time = alt_host_cycles () - alt_host_irq_off_start;
+
+  if (time > alt_host_irq_off_longest)
+  {
+    alt_host_irq_off_longest = time;
+  }
+}
+
+alt_u64 alt_host_irq_off_max (void)
+{
+  return alt_host_irq_off_longest;
+}
+
+void alt_host_irq_off_reset (void)
+{
+  alt_host_irq_off_longest = 0;
+}
+
+#endif /* ALT_HOST_IRQ_OFF_STATS */
+
+static int alt_host_irq_register (alt_u32 irq, alt_isr_func isr, void* context)
+{
+  alt_irq_context status;
+
+  if (irq >= ALT_NIRQ)
+  {
+    return -EINVAL;
+  }
+
+  status = alt_irq_disable_all ();
+  alt_host_irq_table[irq].isr     = isr;
+  alt_host_irq_table[irq].context = context;
+  if (isr)
+  {
+    alt_host_irq_ienable |= 1u << irq;
+  }
+  else
+  {
+    alt_host_irq_ienable &= ~(1u << irq);
+  }
+  alt_irq_enable_all (status);
+
+  return 0;
+}
+
+static int alt_host_irq_mask (alt_u32 irq, int enable)
+{
+  alt_irq_context status;
+
+  if (irq >= ALT_NIRQ)
+  {
+    return -EINVAL;
+  }
+
+  status = alt_irq_disable_all ();
+  if (enable)
+  {
+    alt_host_irq_ienable |= 1u << irq;
+  }
+  else
+  {
+    alt_host_irq_ienable &= ~(1u << irq);
+  }
+  alt_irq_enable_all (status);
+
+  return 0;
+}
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+int alt_ic_isr_register (alt_u32 ic_id, alt_u32 irq, alt_isr_func isr,
+                         void *isr_context, void *flags)
+{
+  return alt_host_irq_register (irq, isr, isr_context);
+}
+
+int alt_ic_irq_enable (alt_u32 ic_id, alt_u32 irq)
+{
+  return alt_host_irq_mask (irq, 1);
+}
+
+int alt_ic_irq_disable (alt_u32 ic_id, alt_u32 irq)
+{
+  return alt_host_irq_mask (irq, 0);
+}
+
+alt_u32 alt_ic_irq_enabled (alt_u32 ic_id, alt_u32 irq)
+{
+  return (irq < ALT_NIRQ) ? ((alt_host_irq_ienable >> irq) & 1) : 0;
+}
+#else
+int alt_irq_register (alt_u32 id, void* context, alt_isr_func handler)
+{
+  return alt_host_irq_register (id, handler, context);
+}
+
+int alt_irq_enable (alt_u32 id)
+{
+  return alt_host_irq_mask (id, 1);
+}
+
+int alt_irq_disable (alt_u32 id)
+{
+  return alt_host_irq_mask (id, 0);
+}
+#endif
+
+/*
+ * The host does not deliver every expiry of an interval timer: expiries that
+ * happen while the signal is still pending are merged, and CPU time timers
+ * only expire at the host's own tick rate. So the system clock interrupt
+ * counts the ticks due from alt_host_cycles() and passes all of them to
+ * alt_tick(), or to alt_tick_n() when there are several.
+ *
+ * "alt_host_sysclk_wake" is the tick at which a suspended system clock
+ * raises its next interrupt, or zero while it ticks normally.
+ */
+static alt_u64          alt_host_ticks_done;
+static volatile alt_u64 alt_host_sysclk_wake;
+
+static void alt_host_sysclk_catch_up (void)
+{
+  alt_u64 due;
+  alt_u32 nticks;
+
+  due    = alt_host_cycles () / ALT_HOST_CYCLES_PER_TICK;
+  nticks = (alt_u32) (due - alt_host_ticks_done);
+  alt_host_ticks_done = due;
+
+  if (nticks == 1)
+  {
+    alt_tick ();
+  }
+  else
+  {
+    alt_tick_n (nticks);
+  }
+}
+
+/*
+ * System clock interrupt: poll the input devices, then announce the ticks
+ * to the HAL alarms and the kernel.
+ */
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+static void alt_host_sysclk_irq (void* context)
+#else
+static void alt_host_sysclk_irq (void* context, alt_u32 id)
+#endif
+{
+  alt_host_dev_poll ();
+
+  alt_host_sysclk_wake = 0;
+  alt_host_sysclk_catch_up ();
+}
+
+/*
+ * The interval timer keeps running while the system clock is suspended; its
+ * signals are ignored until the tick the clock was suspended until.
+ */
+static void alt_host_sysclk_signal (int sig)
+{
+  int saved_errno = errno;
+
+  if (alt_host_sysclk_wake > alt_host_cycles () / ALT_HOST_CYCLES_PER_TICK)
+  {
+    return;
+  }
+
+  alt_host_irq_raise (ALT_HOST_SYS_CLK_IRQ);
+  if (alt_host_irq_status)
+  {
+    alt_host_irq_dispatch ();
+  }
+
+  errno = saved_errno;
+}
+
+/*
+ * alt_host_sysclk_init() registers the system clock interrupt and starts the
+ * interval timer: ITIMER_REAL in real time mode, ITIMER_VIRTUAL (process CPU
+ * time) in virtual time mode.
+ */
+void alt_host_sysclk_init (void)
+{
+  struct sigaction action;
+  struct itimerval period;
+  long             usec;
+
+  alt_sysclk_init ((alt_u32) ALT_HOST_SYS_CLK_RATE);
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+  alt_ic_isr_register (0, ALT_HOST_SYS_CLK_IRQ, alt_host_sysclk_irq, NULL, NULL);
+#else
+  alt_irq_register (ALT_HOST_SYS_CLK_IRQ, NULL, alt_host_sysclk_irq);
+#endif
+
+  memset (&action, 0, sizeof (action));
+  action.sa_handler = alt_host_sysclk_signal;
+  action.sa_flags   = SA_RESTART;
+  sigemptyset (&action.sa_mask);
+  sigaction ((alt_host_time_mode == ALT_HOST_TIME_VIRTUAL) ? SIGVTALRM : SIGALRM,
+             &action, NULL);
+
+  usec = (long) (1000000 / ALT_HOST_SYS_CLK_RATE);
+  if (usec < 1)
+  {
+    usec = 1;
+  }
+  period.it_interval.tv_sec  = usec / 1000000;
+  period.it_interval.tv_usec = usec % 1000000;
+  period.it_value            = period.it_interval;
+  setitimer ((alt_host_time_mode == ALT_HOST_TIME_VIRTUAL) ? ITIMER_VIRTUAL : ITIMER_REAL,
+             &period, NULL);
+}
+
+/*
+ * alt_sysclk_suspend() and alt_sysclk_resume(), see sys/alt_alarm.h. As on
+ * the board, a suspended period is limited to what the 32 bit period
+ * register of the timer can hold, and nothing is done if a tick is already
+ * due.
+ */
+alt_u32 alt_sysclk_suspend (alt_u32 nticks)
+{
+  alt_u64 max = 0xFFFFFFFFULL / ALT_HOST_CYCLES_PER_TICK;
+
+  if ((nticks < 2) || (alt_host_sysclk_wake != 0) ||
+      (alt_host_irq_pending & (1u << ALT_HOST_SYS_CLK_IRQ)) ||
+      (alt_host_cycles () / ALT_HOST_CYCLES_PER_TICK != alt_host_ticks_done))
+  {
+    return 0;
+  }
+
+  if (nticks > max)
+  {
+    nticks = (alt_u32) max;
+  }
+  alt_host_sysclk_wake = alt_host_ticks_done + nticks;
+
+  return nticks;
+}
+
+void alt_sysclk_resume (void)
+{
+  if (alt_host_sysclk_wake == 0)
+  {
+    return;
+  }
+
+  alt_host_sysclk_wake = 0;
+  alt_host_sysclk_catch_up ();
+}
+
+/*
+ * High resolution timer
+ *
+ * alt_hrtimer_clock() is alt_host_cycles(). alt_hrtimer_set() arms a POSIX
+ * timer on the clock of the time mode, whose signal raises the interrupt.
+ */
+
+#if (ALT_HRTIMER_CLK_BASE != none_BASE)
+
+#define ALT_HOST_HRTIMER_IRQ ALT_HOST_SYM(ALT_HRTIMER_CLK, _IRQ)
+
+static timer_t alt_host_hrtimer_id;
+static alt_u64 alt_host_hrtimer_time = ALT_HRTIMER_NONE;
+
+alt_u64 alt_hrtimer_clock (void)
+{
+  return alt_host_cycles ();
+}
+
+void alt_hrtimer_set (alt_u64 time)
+{
+  struct itimerspec value;
+  alt_u64           now;
+  alt_u64           nsec = 0;
+
+  alt_host_hrtimer_time = time;
+  if (time != ALT_HRTIMER_NONE)
+  {
+    now  = alt_host_cycles ();
+    nsec = (time > now) ? (time - now) * 1000000000ULL / ALT_CPU_FREQ : 0;
+    if (nsec < 1)
+    {
+      nsec = 1;
+    }
+  }
+
+  memset (&value, 0, sizeof (value));
+  value.it_value.tv_sec  = nsec / 1000000000ULL;
+  value.it_value.tv_nsec = nsec % 1000000000ULL;
+  timer_settime (alt_host_hrtimer_id, 0, &value, NULL);
+}
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+static void alt_host_hrtimer_irq (void* context)
+#else
+static void alt_host_hrtimer_irq (void* context, alt_u32 id)
+#endif
+{
+  alt_hrtimer_expire ();
+}
+
+static void alt_host_hrtimer_signal (int sig)
+{
+  int saved_errno = errno;
+
+  alt_host_irq_raise (ALT_HOST_HRTIMER_IRQ);
+  if (alt_host_irq_status)
+  {
+    alt_host_irq_dispatch ();
+  }
+
+  errno = saved_errno;
+}
+
+void alt_host_hrtimer_init (void)
+{
+  struct sigaction action;
+  struct sigevent  event;
+
+  alt_hrtimer_init (ALT_CPU_FREQ);
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+  alt_ic_isr_register (0, ALT_HOST_HRTIMER_IRQ, alt_host_hrtimer_irq, NULL, NULL);
+#else
+  alt_irq_register (ALT_HOST_HRTIMER_IRQ, NULL, alt_host_hrtimer_irq);
+#endif
+
+  memset (&action, 0, sizeof (action));
+  action.sa_handler = alt_host_hrtimer_signal;
+  action.sa_flags   = SA_RESTART;
+  sigemptyset (&action.sa_mask);
+  sigaction (SIGRTMIN, &action, NULL);
+
+  memset (&event, 0, sizeof (event));
+  event.sigev_notify = SIGEV_SIGNAL;
+  event.sigev_signo  = SIGRTMIN;
+  timer_create ((alt_host_time_mode == ALT_HOST_TIME_VIRTUAL) ?
+                CLOCK_PROCESS_CPUTIME_ID : CLOCK_MONOTONIC,
+                &event, &alt_host_hrtimer_id);
+}
+
+#else /* ALT_HRTIMER_CLK */
+
+alt_u64 alt_hrtimer_clock (void)
+{
+  return 0;
+}
+
+void alt_hrtimer_set (alt_u64 time)
+{
+}
+
+void alt_host_hrtimer_init (void)
+{
+}
+
+#endif /* ALT_HRTIMER_CLK */
+
+/*
+ * alt_host_idle() is called by the idle task with interrupts enabled. In
+ * virtual time mode the clock jumps to the next tick, or to the tick the
+ * system clock is suspended until, or to the expiry of the high resolution
+ * timer if that comes first, and the interrupt is taken at once.
+ */
+void alt_host_idle (void)
+{
+  alt_irq_context context;
+  alt_u64         now;
+  alt_u64         tick;
+
+  if (alt_host_time_mode == ALT_HOST_TIME_VIRTUAL)
+  {
+    context = alt_irq_disable_all ();
+    now  = alt_host_cycles ();
+    tick = now + ALT_HOST_CYCLES_PER_TICK - now % ALT_HOST_CYCLES_PER_TICK;
+    if (alt_host_sysclk_wake * ALT_HOST_CYCLES_PER_TICK > tick)
+    {
+      tick = alt_host_sysclk_wake * ALT_HOST_CYCLES_PER_TICK;
+    }
+#if (ALT_HRTIMER_CLK_BASE != none_BASE)
+    if (alt_host_hrtimer_time < tick)
+    {
+      if (alt_host_hrtimer_time > now)
+      {
+        alt_host_clock_advance (alt_host_hrtimer_time - now);
+      }
+      ALT_HOST_IRQ_OFF_BEGIN ();
+      alt_host_irq_raise (ALT_HOST_HRTIMER_IRQ);
+      alt_irq_enable_all (context);
+      return;
+    }
+#endif
+    alt_host_clock_advance (tick - now);
+    ALT_HOST_IRQ_OFF_BEGIN ();       /* The jump is no time spent disabled */
+    alt_host_irq_raise (ALT_HOST_SYS_CLK_IRQ);
+    alt_irq_enable_all (context);
+  }
+  else
+  {
+    pause ();
+  }
+}
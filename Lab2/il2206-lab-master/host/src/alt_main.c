@@ -0,0 +1,36 @@
+/******************************************************************************
+*                                                                             *
+* alt_main.c for the POSIX host port.                                         *
+*                                                                             *
+* On the target alt_main() initialises the OS, the devices and the interrupt  *
+* controller before it calls the application's main(). On the host main()    *
+* is called by the C library, so the same steps run in a constructor.         *
+*                                                                             *
+******************************************************************************/
+
+#include <stdio.h>
+
+#include "sys/alt_irq.h"
+#include "sys/alt_host.h"
+#include "os/alt_hooks.h"
+
+/*
+ * Semaphores created by ALT_OS_INIT() to protect the environment and the
+ * heap in the newlib build. The host C library has its own locking, they
+ * are only kept so that ALT_OS_INIT() is the same as on the target.
+ */
+OS_EVENT *alt_envsem;
+OS_EVENT *alt_heapsem;
+
+static void __attribute__ ((constructor)) alt_host_main (void)
+{
+  /*
+   * Unbuffered like the JTAG UART, so that the output of tasks isn't held
+   * back and stdio does not allocate a buffer from a preempted task.
+   */
+  setvbuf (stdout, NULL, _IONBF, 0);
+
+  ALT_OS_INIT ();
+  alt_host_sys_init ();
+  alt_irq_cpu_enable_interrupts ();
+}
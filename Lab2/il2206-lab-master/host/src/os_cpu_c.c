@@ -0,0 +1,518 @@
+/***********************************************************************************************
+ *                                               uC/OS-II
+ *                                         The Real-Time Kernel
+ * File         : os_cpu_c.c
+ * For          : uC/OS Real-time multitasking kernel on a POSIX host (Linux)
+ * Based on     : Nios II port done by IS
+ *
+ * Every task runs on its own host stack and is switched with swapcontext(). The emulated
+ * interrupt enable bit (see sys/alt_irq.h) is clear whenever a switch happens, exactly as on
+ * the target, and the task that is switched in restores its own state when it leaves the
+ * critical section or returns from the interrupt it was preempted by.
+ *
+ ***********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <ucontext.h>
+
+#define  OS_CPU_GLOBALS
+#include "includes.h"                   /* Standard includes for uC/OS-II */
+
+#include "system.h"
+#include "sys/alt_alarm.h"
+#include "sys/alt_host.h"
+
+#if OS_TMR_EN > 0
+static  INT16U  OSTmrCtr;
+#endif
+
+/*
+ * Per-task execution time is measured with alt_host_cycles(), which is always available on the
+ * host, so profiling only depends on OS_TASK_PROFILE_EN.
+ */
+#if OS_TASK_PROFILE_EN > 0
+#define OS_CPU_PROFILE_EN  1
+static  INT16U  OSProfileCtr;           /* Ticks into the current accounting period */
+static  INT32U  OSProfileStart;         /* Timestamp at the start of the period     */
+
+static  void    OSProfilePeriodEnd(void);
+#else
+#define OS_CPU_PROFILE_EN  0
+#endif
+
+/*
+ * Host context of a task. OSTaskStkInit() stores a pointer to it at the top of the task stack
+ * and returns the address of that pointer, which the kernel keeps in .OSTCBStkPtr.
+ */
+typedef struct os_host_task {
+    ucontext_t            Ctx;
+    void                (*Task)(void *pd);
+    void                 *Arg;
+    struct os_host_task  *Next;         /* Link in the free list once the task is deleted */
+    char                 *Stk;
+} OS_HOST_TASK;
+
+static  OS_HOST_TASK  *OSHostFreeList;
+
+#define OS_HOST_TASK_OF(ptcb)  (*(OS_HOST_TASK **)(ptcb)->OSTCBStkPtr)
+
+/***********************************************************************************************
+ *                                            TASK ENTRY
+ *
+ * Description: First function run by every task. Tasks are started by a switch with interrupts
+ *              disabled, so interrupts are enabled before the task code is called.
+ ***********************************************************************************************/
+
+static void OSHostTaskStart (void)
+{
+    OS_HOST_TASK  *ptask;
+
+
+    ptask = OS_HOST_TASK_OF(OSTCBCur);
+    alt_irq_enable_all(ALT_IRQ_ENABLED);
+    ptask->Task(ptask->Arg);
+    fprintf(stderr, "host: task %d returned\n", OSTCBCur->OSTCBPrio);
+#if OS_TASK_DEL_EN > 0
+    OSTaskDel(OS_PRIO_SELF);
+#endif
+    abort();
+}
+
+/***********************************************************************************************
+ *                                        INITIALIZE A TASK'S STACK
+ *
+ * Description: This function is called by either OSTaskCreate() or OSTaskCreateExt() to
+ *              initialize the stack frame of the task being created.
+ *
+ * What it does: It sets up a host context for the task that starts in OSHostTaskStart(),
+ *               and stores a pointer to it at the top of the task stack.
+ *
+ * Arguments  : task          is a pointer to the task code
+ *
+ *              pdata         is a pointer to a user supplied data area that will be passed to the task
+ *                            when the task first executes.
+ *
+ *              ptos          is a pointer to the top of stack.
+ *
+ *              opt           specifies options that can be used to alter the behavior of OSTaskStkInit().
+ *                            (see uCOS_II.H for OS_TASK_OPT_???).
+ *
+ * Returns    : Always returns the location of the new top-of-stack.
+ *
+ * Note(s)    : 1) Contexts of deleted tasks are reused, except the one of the running task, which
+ *                 may be creating a task after deleting itself with the scheduler locked.
+ ***********************************************************************************************/
+
+OS_STK *OSTaskStkInit(void (*task)(void *pd), void *pdata, OS_STK *pstk, INT16U opt)
+{
+    OS_HOST_TASK   *ptask;
+    OS_HOST_TASK  **pprev;
+    OS_HOST_TASK  **stk;
+
+
+    (void)opt;
+    pprev = &OSHostFreeList;
+    ptask = OSHostFreeList;
+    while ((ptask != (OS_HOST_TASK *)0) &&
+           (OSTCBCur != (OS_TCB *)0) && (OSRunning == OS_TRUE) && (ptask == OS_HOST_TASK_OF(OSTCBCur))) {
+        pprev = &ptask->Next;
+        ptask = ptask->Next;
+    }
+    if (ptask != (OS_HOST_TASK *)0) {
+        *pprev = ptask->Next;
+    } else {
+        ptask = (OS_HOST_TASK *)malloc(sizeof(OS_HOST_TASK));
+        if (ptask != (OS_HOST_TASK *)0) {
+            ptask->Stk = (char *)malloc(OS_HOST_STK_SIZE);
+        }
+        if ((ptask == (OS_HOST_TASK *)0) || (ptask->Stk == (char *)0)) {
+            fprintf(stderr, "host: out of memory for a task stack\n");
+            abort();
+        }
+    }
+    ptask->Task = task;
+    ptask->Arg  = pdata;
+    ptask->Next = (OS_HOST_TASK *)0;
+
+    getcontext(&ptask->Ctx);
+    ptask->Ctx.uc_stack.ss_sp   = ptask->Stk;
+    ptask->Ctx.uc_stack.ss_size = OS_HOST_STK_SIZE;
+    ptask->Ctx.uc_link          = (ucontext_t *)0;
+    sigemptyset(&ptask->Ctx.uc_sigmask);
+    makecontext(&ptask->Ctx, OSHostTaskStart, 0);
+
+    stk  = (OS_HOST_TASK **)((unsigned long)(pstk + 1) & ~(sizeof(void *) - 1));
+    stk -= 1;
+    *stk = ptask;
+    return ((OS_STK *)stk);
+}
+
+/***********************************************************************************************
+ *                                   START THE HIGHEST PRIORITY TASK
+ *
+ * Description: Called by OSStart() with interrupts disabled. The context of main() is abandoned.
+ ***********************************************************************************************/
+
+void OSStartHighRdy (void)
+{
+#if OS_CPU_HOOKS_EN > 0
+    OSTaskSwHook();
+#endif
+    OSRunning = OS_TRUE;
+    setcontext(&OS_HOST_TASK_OF(OSTCBHighRdy)->Ctx);
+}
+
+/***********************************************************************************************
+ *                                         PERFORM A CONTEXT SWITCH
+ *
+ * Description: OSCtxSw() is called by OS_Sched() and OSIntCtxSw() by OSIntExit(), both with
+ *              interrupts disabled. On the host both save the running task's context and resume
+ *              OSTCBHighRdy; a task preempted by an interrupt is later resumed inside the signal
+ *              handler that ran the interrupt.
+ ***********************************************************************************************/
+
+void OSCtxSw (void)
+{
+    OS_HOST_TASK  *pfrom;
+
+
+#if OS_CPU_HOOKS_EN > 0
+    OSTaskSwHook();
+#endif
+    pfrom     = OS_HOST_TASK_OF(OSTCBCur);
+    OSTCBCur  = OSTCBHighRdy;
+    OSPrioCur = OSPrioHighRdy;
+    swapcontext(&pfrom->Ctx, &OS_HOST_TASK_OF(OSTCBHighRdy)->Ctx);
+}
+
+void OSIntCtxSw (void)
+{
+    OSCtxSw();
+}
+
+#if OS_CPU_HOOKS_EN
+/*
+*********************************************************************************************************
+*                                          TASK CREATION HOOK
+*
+* Description: This function is called when a task is created.
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being created.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+void OSTaskCreateHook (OS_TCB *ptcb)
+{
+    ptcb = ptcb;                       /* Prevent compiler warning */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TASK DELETION HOOK
+*
+* Description: This function is called when a task is deleted.  The host context of the task is put
+*              on the free list, to be reused by OSTaskStkInit().
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being deleted.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+void OSTaskDelHook (OS_TCB *ptcb)
+{
+    OS_HOST_TASK  *ptask;
+
+
+    ptask          = OS_HOST_TASK_OF(ptcb);
+    ptask->Next    = OSHostFreeList;
+    OSHostFreeList = ptask;
+}
+
+/*
+*********************************************************************************************************
+*                                           TASK SWITCH HOOK
+*
+* Description: This function is called when a task switch is performed.  This allows you to perform other
+*              operations during a context switch.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) It is assumed that the global pointer 'OSTCBHighRdy' points to the TCB of the task that
+*                 will be 'switched in' (i.e. the highest priority task) and, 'OSTCBCur' points to the
+*                 task being switched out (i.e. the preempted task).
+*              3) When task profiling is enabled, the time the task being switched out ran since it
+*                 was switched in is added to its execution time (see OSTaskCyclesGet()).
+*********************************************************************************************************
+*/
+void OSTaskSwHook (void)
+{
+#if OS_CPU_PROFILE_EN > 0
+    INT32U  now;
+    INT32U  cycles;
+
+
+    now = (INT32U)alt_host_cycles();
+    if (OSRunning == OS_TRUE) {                   /* Nothing was running before OSStartHighRdy()       */
+        cycles                       = now - OSTCBCur->OSTCBCyclesStart;
+        OSTCBCur->OSTCBCyclesTot    += cycles;
+        OSTCBCur->OSTCBCyclesPeriod += cycles;
+        cycles                      += OSTCBCur->OSTCBCyclesBurst;
+        if (cycles > OSTCBCur->OSTCBCyclesMax) {
+            OSTCBCur->OSTCBCyclesMax = cycles;    /* Longest burst so far                              */
+        }
+        OSTCBCur->OSTCBCyclesBurst   = 0L;
+    }
+    OSTCBHighRdy->OSTCBCyclesStart = now;
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                           STATISTIC TASK HOOK
+*
+* Description: This function is called every second by uC/OS-II's statistics task.  This allows your
+*              application to add functionality to the statistics task.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+void OSTaskStatHook (void)
+{
+}
+
+/*
+*********************************************************************************************************
+*                                               TICK HOOK
+*
+* Description: This function is called every tick.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*********************************************************************************************************
+*/
+void OSTimeTickHook (void)
+{
+#if OS_TMR_EN > 0
+    OSTmrCtr++;
+    if (OSTmrCtr >= (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)) {
+        OSTmrCtr = 0;
+        OSTmrSignal();
+    }
+#endif
+
+#if OS_CPU_PROFILE_EN > 0
+    if (OSRunning == OS_TRUE) {
+        OSProfileCtr++;
+        if (OSProfileCtr >= OS_TASK_PROFILE_PERIOD) {
+            OSProfileCtr = 0;
+            OSProfilePeriodEnd();
+        }
+    }
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                           SEVERAL TICKS HOOK
+*
+* Description: This function is called by OSTimeTickN(), instead of OSTimeTickHook(), for the ticks that
+*              elapsed while the system clock was suspended.  See the Nios II port.
+*
+* Arguments  : nticks   is the number of ticks that elapsed.
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+void OSTimeTickNHook (INT32U nticks)
+{
+#if (OS_TMR_EN > 0) || (OS_CPU_PROFILE_EN > 0)
+    INT32U  ctr;
+#endif
+
+
+#if OS_TMR_EN > 0
+    ctr      = OSTmrCtr + nticks;
+    OSTmrCtr = (INT16U)(ctr % OS_TMR_TICK_DIV);
+    if (ctr >= OS_TMR_TICK_DIV) {
+        OSTmrSignal();
+    }
+#endif
+
+#if OS_CPU_PROFILE_EN > 0
+    if (OSRunning == OS_TRUE) {
+        ctr          = OSProfileCtr + nticks;
+        OSProfileCtr = (INT16U)(ctr % OS_TASK_PROFILE_PERIOD);
+        if (ctr >= OS_TASK_PROFILE_PERIOD) {
+            OSProfilePeriodEnd();
+        }
+    }
+#endif
+}
+#endif
+
+void OSInitHookBegin(void)
+{
+#if OS_TMR_EN > 0
+    OSTmrCtr = 0;
+#endif
+}
+
+void OSInitHookEnd(void)
+{
+#if OS_CPU_PROFILE_EN > 0
+    OSProfileCtr   = 0;
+    OSProfileStart = (INT32U)alt_host_cycles();
+    OSCyclesPeriod = 0L;
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                     END OF A CPU ACCOUNTING PERIOD
+*
+* Description: This function is called by OSTimeTickHook() every OS_TASK_PROFILE_PERIOD ticks.  The task
+*              that was interrupted is charged up to now, then every task's cycles for the period are
+*              saved in .OSTCBCyclesLast and a new period is started.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if OS_CPU_PROFILE_EN > 0
+static void OSProfilePeriodEnd (void)
+{
+    OS_TCB    *ptcb;
+    INT32U     now;
+    INT32U     cycles;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    now                          = (INT32U)alt_host_cycles();
+    cycles                       = now - OSTCBCur->OSTCBCyclesStart;
+    OSTCBCur->OSTCBCyclesTot    += cycles;
+    OSTCBCur->OSTCBCyclesPeriod += cycles;
+    OSTCBCur->OSTCBCyclesBurst  += cycles;        /* Burst goes on, only its start moves               */
+    OSTCBCur->OSTCBCyclesStart   = now;
+    ptcb = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {
+        ptcb->OSTCBCyclesLast   = ptcb->OSTCBCyclesPeriod;
+        ptcb->OSTCBCyclesPeriod = 0L;
+        ptcb                    = ptcb->OSTCBNext;
+    }
+    OSCyclesPeriod = now - OSProfileStart;
+    OSProfileStart = now;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                               IDLE HOOK
+*
+* Description: This function is called by the idle task.  It gives the host CPU back until the next
+*              interrupt, or in virtual time mode raises the next system clock tick right away.  When
+*              OS_TICKLESS_EN is enabled, the system clock is first suspended until the first task delay,
+*              OS_TMR timer or HAL alarm expires, as in the Nios II port; in virtual time mode the clock
+*              then jumps to that tick at once.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+void OSTaskIdleHook(void)
+{
+#if OS_TICKLESS_EN > 0
+    INT32U     nticks;
+    INT32U     next;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    nticks = OSTimeTickNext();                            /* Next task delay or pend timeout           */
+#if OS_TMR_EN > 0
+    next   = OSTmrNextGet();                              /* Next OS_TMR expiry, in OSTmrSignal() units */
+    if (next != 0) {
+        next = next * OS_TMR_TICK_DIV - OSTmrCtr;
+        if ((nticks == 0) || (next < nticks)) {
+            nticks = next;
+        }
+    }
+#endif
+    next   = alt_alarm_next();                            /* Next HAL alarm                            */
+    if ((next != 0) && ((nticks == 0) || (next < nticks))) {
+        nticks = next;
+    }
+    if (nticks != 1) {                                    /* 0 means nothing is pending at all         */
+        alt_sysclk_suspend(nticks == 0 ? 0xFFFFFFFF : nticks);
+    }
+    OS_EXIT_CRITICAL();
+#endif
+    alt_host_idle();
+}
+
+/*
+*********************************************************************************************************
+*                                          TICKLESS EXIT HOOK
+*
+* Description: This function is called by OSIntExit() when an interrupt occurred while the idle task was
+*              running.  The ticks that elapsed while the system clock was suspended are passed to
+*              alt_tick_n().
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+void OSTicklessExitHook (void)
+{
+    alt_sysclk_resume();
+}
+#endif
+
+void OSTCBInitHook(OS_TCB *ptcb)
+{
+}
+
+#endif
+
+/*
+*********************************************************************************************************
+*                                           READ THE CYCLE COUNTER
+*
+* Description: This function returns alt_host_cycles(), in ALT_CPU_FREQ cycles, for the timer callback
+*              statistics of OSTmrQuery() and the timestamps of OSTimeTsGet().
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if (OS_TIME_TS_EN > 0) || ((OS_TMR_EN > 0) && (OS_TMR_STATS_EN > 0))
+INT32U OSCPUCyclesGet (void)
+{
+    return ((INT32U)alt_host_cycles());
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                      GET THE CYCLE COUNTER FREQUENCY
+*
+* Description: This function returns the frequency of OSCPUCyclesGet() in Hz.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if OS_TIME_TS_EN > 0
+INT32U OSCPUCyclesFreq (void)
+{
+    return (ALT_CPU_FREQ);
+}
+#endif